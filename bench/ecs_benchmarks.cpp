@@ -0,0 +1,386 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tinyECS/registry.hpp"
+#include "systems/motion_system.hpp"
+
+// Micro-benchmarks of the ECS storage and the hot loops built on it. Nothing here needs a window or
+// a GL context. Results are written as JSON by default so runs can be diffed, e.g.
+//   ecs_benchmarks --benchmark_out=before.json --benchmark_repetitions=5
+// Pass --benchmark_format=console for a readable table.
+
+// A component the size of a typical game component, in both storage backends
+struct Body
+{
+	float position[2];
+	float velocity[2];
+	float scale[2];
+	float angle;
+	float pad[5];
+};
+struct PagedBody : Body {};
+template <> struct ComponentStorage<PagedBody> { using type = PagedStorage<PagedBody>; };
+
+// Creates n entities for containers outside of a registry
+struct Entities
+{
+	EntityPool pool;
+	std::vector<Entity> list;
+
+	explicit Entities(size_t n)
+	{
+		list.reserve(n);
+		for (size_t i = 0; i < n; i++)
+			list.push_back(pool.create());
+	}
+
+	// The entities in a fixed random order, lookups in this order miss the cache like game code does
+	std::vector<Entity> shuffled() const
+	{
+		std::vector<Entity> order = list;
+		std::shuffle(order.begin(), order.end(), std::mt19937(1));
+		return order;
+	}
+};
+
+static void entity_counts(benchmark::internal::Benchmark* b)
+{
+	for (int n : { 1000, 10000, 100000 })
+		b->Arg(n);
+}
+
+///////////// ComponentContainer operations ///////////
+
+template <typename C>
+static void BM_Insert(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	for (auto _ : state)
+	{
+		ComponentContainer<C> container;
+		for (Entity e : entities.list)
+			container.insert(e, C{});
+		benchmark::DoNotOptimize(container.components.back());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Insert, Body)->Apply(entity_counts);
+BENCHMARK_TEMPLATE(BM_Insert, PagedBody)->Apply(entity_counts);
+
+static void BM_Emplace(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	for (auto _ : state)
+	{
+		ComponentContainer<Motion> motions;
+		for (Entity e : entities.list)
+			motions.emplace(e).velocity = { 1.f, 0.f };
+		benchmark::DoNotOptimize(motions.components.back());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Emplace)->Apply(entity_counts);
+
+template <typename C>
+static void BM_Get(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	ComponentContainer<C> container;
+	for (Entity e : entities.list)
+		container.insert(e, C{});
+	std::vector<Entity> order = entities.shuffled();
+
+	for (auto _ : state)
+	{
+		float sum = 0.f;
+		for (Entity e : order)
+			sum += container.get(e).velocity[0];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Get, Body)->Apply(entity_counts);
+BENCHMARK_TEMPLATE(BM_Get, PagedBody)->Apply(entity_counts);
+
+// Half of the looked up entities have the component
+static void BM_Has(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	ComponentContainer<Body> container;
+	for (size_t i = 0; i < entities.list.size(); i += 2)
+		container.insert(entities.list[i], Body{});
+	std::vector<Entity> order = entities.shuffled();
+
+	for (auto _ : state)
+	{
+		size_t found = 0;
+		for (Entity e : order)
+			found += container.has(e);
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Has)->Apply(entity_counts);
+
+// Removes every component one at a time in random order
+static void BM_Remove(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	std::vector<Entity> order = entities.shuffled();
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ComponentContainer<Body> container;
+		for (Entity e : entities.list)
+			container.insert(e, Body{});
+		state.ResumeTiming();
+
+		for (Entity e : order)
+			container.remove(e);
+		benchmark::DoNotOptimize(container.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Remove)->Apply(entity_counts);
+
+// Removes a random tenth of the components in one compacting pass
+static void BM_RemoveBatch(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	std::vector<Entity> order = entities.shuffled();
+	std::vector<Entity> batch(order.begin(), order.begin() + order.size() / 10);
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ComponentContainer<Body> container;
+		for (Entity e : entities.list)
+			container.insert(e, Body{});
+		state.ResumeTiming();
+
+		container.remove_batch(batch);
+		benchmark::DoNotOptimize(container.size());
+	}
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_RemoveBatch)->Apply(entity_counts);
+
+// Sorts shuffled components by a precomputed key, like depth sorting the sprites
+template <typename C>
+static void BM_SortByKey(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	std::mt19937 random(1);
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ComponentContainer<C> container;
+		for (Entity e : entities.list)
+			container.insert(e, C{});
+		std::vector<float> keys(container.size());
+		for (float& key : keys)
+			key = (float)(random() % 10000);
+		state.ResumeTiming();
+
+		container.sort_by_key(keys);
+		benchmark::DoNotOptimize(container.entities.front());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SortByKey, Body)->Apply(entity_counts);
+BENCHMARK_TEMPLATE(BM_SortByKey, PagedBody)->Apply(entity_counts);
+
+// Sorts with a comparison that looks the entities up, like the renderer's layer sort
+static void BM_SortCompare(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	std::mt19937 random(1);
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ComponentContainer<Body> container;
+		for (Entity e : entities.list)
+			container.insert(e, Body{}).position[1] = (float)(random() % 10000);
+		state.ResumeTiming();
+
+		container.sort([&](Entity a, Entity b) { return container.get(a).position[1] < container.get(b).position[1]; });
+		benchmark::DoNotOptimize(container.entities.front());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SortCompare)->Apply(entity_counts);
+
+// Iterates the whole container after half of it was removed and re-added in random order
+template <typename C>
+static void BM_IterateAfterChurn(benchmark::State& state)
+{
+	Entities entities(state.range(0));
+	ComponentContainer<C> container;
+	for (Entity e : entities.list)
+		container.insert(e, C{});
+	std::vector<Entity> order = entities.shuffled();
+	order.resize(order.size() / 2);
+	for (Entity e : order)
+		container.remove(e);
+	for (Entity e : order)
+		container.insert(e, C{});
+
+	for (auto _ : state)
+	{
+		for (C& body : container.components)
+			body.position[0] += body.velocity[0] * 0.01f;
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_IterateAfterChurn, Body)->Apply(entity_counts);
+BENCHMARK_TEMPLATE(BM_IterateAfterChurn, PagedBody)->Apply(entity_counts);
+
+///////////// Registry ///////////
+
+// Creates n entities with the components of a drawn terrain entity, a third of them also an enemy
+static std::vector<Entity> populate(ECSRegistry& registry, size_t n)
+{
+	std::vector<Entity> entities;
+	for (size_t i = 0; i < n; i++)
+	{
+		Entity e = registry.create();
+		registry.motions.emplace(e).velocity = { 1.f, 0.f };
+		registry.renderRequests.insert(e, { TEXTURE_ASSET_ID::TREE, EFFECT_ASSET_ID::TEXTURED, GEOMETRY_BUFFER_ID::SPRITE });
+		registry.terrains.emplace(e);
+		if (i % 3 == 0)
+			registry.enemies.emplace(e);
+		entities.push_back(e);
+	}
+	return entities;
+}
+
+// Destroys every entity, each visits only the containers in its signature
+static void BM_RemoveAllComponentsOf(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ECSRegistry registry;
+		std::vector<Entity> entities = populate(registry, state.range(0));
+		std::shuffle(entities.begin(), entities.end(), std::mt19937(1));
+		state.ResumeTiming();
+
+		for (Entity e : entities)
+			registry.remove_all_components_of(e);
+		benchmark::DoNotOptimize(registry.motions.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RemoveAllComponentsOf)->Apply(entity_counts);
+
+// Iterates Motion and RenderRequest through a view, one lookup per entity and component
+static void BM_ViewIterate(benchmark::State& state)
+{
+	ECSRegistry registry;
+	populate(registry, state.range(0));
+	for (auto _ : state)
+	{
+		float sum = 0.f;
+		for (auto [entity, motion, render_request] : registry.view<Motion, RenderRequest>())
+			if (render_request.is_visible)
+				sum += motion.position.x + motion.velocity.x;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ViewIterate)->Apply(entity_counts);
+
+// The same loop over the owning group, the arrays are walked in lockstep
+static void BM_GroupIterate(benchmark::State& state)
+{
+	ECSRegistry registry;
+	populate(registry, state.range(0));
+	for (auto _ : state)
+	{
+		float sum = 0.f;
+		for (auto [entity, motion, render_request] : registry.group<Motion, RenderRequest>())
+			if (render_request.is_visible)
+				sum += motion.position.x + motion.velocity.x;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GroupIterate)->Apply(entity_counts);
+
+// Three components, driven by the smallest container and skipping one excluded type
+static void BM_ViewIterateExclude(benchmark::State& state)
+{
+	ECSRegistry registry;
+	populate(registry, state.range(0));
+	for (auto _ : state)
+	{
+		float sum = 0.f;
+		registry.view<Motion, Terrain, RenderRequest>(exclude<Enemy>).each([&](Entity, Motion& motion, Terrain& terrain, RenderRequest&) {
+			sum += motion.position.x * terrain.width_ratio;
+		});
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ViewIterateExclude)->Apply(entity_counts);
+
+///////////// Motion ///////////
+
+// Gathers motions into SoA form, integrates them with the vector kernel and scatters them back
+static void BM_MotionIntegrate(benchmark::State& state)
+{
+	std::vector<Motion> motions(state.range(0));
+	for (size_t i = 0; i < motions.size(); i++)
+		motions[i].velocity = { (float)i, 1.f };
+	MotionSoA soa;
+	for (auto _ : state)
+	{
+		soa.reset(motions.size());
+		for (Motion& motion : motions)
+			soa.add(motion, 0.016f);
+		soa.pad();
+		MotionSystem::integrate(soa);
+		soa.scatter();
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MotionIntegrate)->Apply(entity_counts);
+
+// The same update as a plain loop over the Motion components, for comparison
+static void BM_MotionScalar(benchmark::State& state)
+{
+	std::vector<Motion> motions(state.range(0));
+	for (size_t i = 0; i < motions.size(); i++)
+		motions[i].velocity = { (float)i, 1.f };
+	for (auto _ : state)
+	{
+		for (Motion& motion : motions)
+		{
+			motion.previous_position = motion.position;
+			motion.position += motion.velocity * 0.016f;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MotionScalar)->Apply(entity_counts);
+
+// JSON unless another format is asked for on the command line
+int main(int argc, char** argv)
+{
+	std::vector<char*> args(argv, argv + argc);
+	std::string json = "--benchmark_format=json";
+	args.insert(args.begin() + 1, json.data());
+	int count = (int)args.size();
+
+	benchmark::Initialize(&count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,4 @@
+// common.cpp checks for GL errors through the gl3w function pointers, so the loader has to be linked.
+// It is never initialised: nothing the benchmarks run makes a GL call.
+#define GL3W_IMPLEMENTATION
+#include <gl3w.h>
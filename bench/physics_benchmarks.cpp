@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "tinyECS/registry.hpp"
+#include "systems/physics_system.hpp"
+
+// A scene for PhysicsSystem::step: a player, trees and n dynamic bodies, half fired ammo and half
+// enemies. The scene grows with n at constant density, so a broadphase that keeps the cost per body
+// flat shows up as items_per_second staying flat.
+struct PhysicsScene
+{
+	ECSRegistry registry;
+	CollisionWorld collision;
+	ContactManager contacts;
+	ProjectileSystem projectiles{ registry, contacts };
+	std::vector<Entity> entities;
+
+	explicit PhysicsScene(size_t dynamic_bodies)
+	{
+		std::mt19937 random(1);
+		float side = 100.f * std::sqrt((float)dynamic_bodies) + 200.f;
+		std::uniform_real_distribution<float> coordinate(0.f, side);
+
+		registry.screenStates.emplace(create());
+
+		Entity player = create();
+		registry.players.emplace(player);
+		registry.collisionFilters.insert(player, { COLLISION_PLAYER, COLLISION_SOLID | COLLISION_ENEMY_REACH });
+		registry.motions.emplace(player).position = { side / 2, side / 2 };
+
+		for (size_t i = 0; i < dynamic_bodies / 4 + 20; i++)
+		{
+			Entity tree = create();
+			Motion& motion = registry.motions.emplace(tree);
+			motion.position = { coordinate(random), coordinate(random) };
+			motion.scale = { 60.f, 90.f };
+			Terrain& terrain = registry.terrains.emplace(tree);
+			terrain.collision_setting = 0.f;
+			terrain.width_ratio = 0.3f;
+			terrain.height_ratio = 0.2f;
+			registry.renderRequests.insert(tree, { TEXTURE_ASSET_ID::TREE, EFFECT_ASSET_ID::TEXTURED, GEOMETRY_BUFFER_ID::SPRITE });
+			registry.collisionFilters.insert(tree, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
+		}
+
+		for (size_t i = 0; i < dynamic_bodies; i++)
+		{
+			vec2 position = { coordinate(random), coordinate(random) };
+			if (i % 2 == 0)
+			{
+				// thrown so that the step below moves it to position, that move is swept
+				Entity body = projectiles.acquire();
+				entities.push_back(body);
+				registry.motions.get(body).scale = { 20.f, 20.f };
+				registry.collisionFilters.get(body) = { COLLISION_AMMO, COLLISION_AMMO_STOPPING | COLLISION_ENEMY };
+				vec2 start = position - vec2(16.f * THROW_UPDATE_FACTOR, 0.f);
+				projectiles.launch(body, start, start + vec2((float)THROW_DISTANCE, 0.f), THROW_UPDATE_FACTOR, 0);
+			}
+			else
+			{
+				Entity body = create();
+				Motion& motion = registry.motions.emplace(body);
+				motion.position = position;
+				motion.scale = { 50.f, 50.f };
+				registry.enemies.emplace(body);
+				registry.collisionFilters.insert(body, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
+			}
+		}
+		projectiles.step(16.f);
+		collision.build_terrain(registry);
+	}
+
+	~PhysicsScene()
+	{
+		for (Entity e : entities)
+			registry.remove_all_components_of(e);
+	}
+
+	Entity create()
+	{
+		entities.push_back(registry.create());
+		return entities.back();
+	}
+};
+
+static void BM_PhysicsStep(benchmark::State& state)
+{
+	PhysicsScene scene(state.range(0));
+	PhysicsSystem physics(scene.registry, scene.collision, scene.contacts, scene.projectiles);
+	size_t contacts = 0;
+	for (auto _ : state)
+	{
+		physics.step(16.f);
+		contacts = scene.contacts.contacts().size();
+	}
+	state.counters["contacts"] = (double)contacts;
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PhysicsStep)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
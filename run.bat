@@ -13,6 +13,7 @@ cd ..
 cd ..
 
 if "%~1" == "test" goto test
+if "%~1" == "bench" goto bench
 goto game
 
 :test
@@ -21,6 +22,12 @@ cmake --build build
 cd build && ctest --output-on-failure
 goto eof
 
+:bench
+cmake -S . -B build-bench -DBUILD_GAME=OFF -DBUILD_BENCHMARKS=ON
+cmake --build build-bench --target ecs_benchmarks --config Release
+.\build-bench\bench\Release\ecs_benchmarks.exe --benchmark_out=bench_output.json
+goto eof
+
 :game
 cmake -S . -B build -DBUILD_GAME=ON -DBUILD_TESTING=OFF
 cmake --build build
@@ -19,6 +19,10 @@ if [ $1 = "test" ]; then
     cmake -S . -B build -DBUILD_GAME=OFF -DBUILD_TESTING=ON
     cmake --build build
     cd build && ctest --output-on-failure
+elif [ $1 = "bench" ]; then
+    cmake -S . -B build-bench -DBUILD_GAME=OFF -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release
+    cmake --build build-bench --target ecs_benchmarks
+    ./build-bench/bench/ecs_benchmarks --benchmark_out=bench_output.json
 else
     cmake -S . -B build -DBUILD_GAME=ON -DBUILD_TESTING=OFF
     cmake --build build
@@ -53,6 +53,8 @@ const float WINDOW_RATIO = (float)WINDOW_WIDTH_PX / WINDOW_HEIGHT_PX;
 const int GRID_CELL_WIDTH_PX = 50;
 const int GRID_CELL_HEIGHT_PX = 50;
 const int GRID_LINE_WIDTH_PX = 2;
+// the cells terrain is baked into for collision checks, see OccupancyGrid
+const float COLLISION_CELL_SIZE_PX = 5.f;
 
 const float PLAYER_BB_WIDTH = (float)75;
 const float PLAYER_BB_HEIGHT = (float)110;
@@ -721,7 +723,7 @@ const std::vector<PotionEffect> consumable_potions = {
 	PotionEffect::SATURATION,
 };
 
-const float MOLOTOV_RADIUS_SQUARED = 10000.f; // within 2 grid cells
+const float MOLOTOV_RADIUS = 100.f; // within 2 grid cells
 const float DOT_POISON_TIMER = 3000.f;
 const float MOLOTOV_MULTIPLIER = 0.4f;
 const float DOT_MOLOTOV_TIMER = 1000.f;
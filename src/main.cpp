@@ -9,27 +9,34 @@
 // internal
 #include "systems/ai_system.hpp"
 #include "systems/physics_system.hpp"
+#include "systems/motion_system.hpp"
 #include "systems/render_system.hpp"
 #include "systems/world_system.hpp"
 #include "systems/item_system.hpp"
 #include "systems/potion_system.hpp"
 #include "systems/ui_system.hpp"
 #include "systems/sound_system.hpp"
+#include "tinyECS/job_system.hpp"
+#include "tinyECS/scheduler.hpp"
+#include "tinyECS/frame_arena.hpp"
+#include "world.hpp"
 
 using Clock = std::chrono::high_resolution_clock;
 
 // Entry point
 int main()
 {
-	// global systems
-	AISystem	  ai_system;
-	WorldSystem   world_system;
-	RenderSystem  renderer_system;
-	PhysicsSystem physics_system;
-	ItemSystem    item_system;
-	PotionSystem  potion_system;
-	BiomeSystem   biome_system;
-	UISystem      ui_system;
+	// the simulated world and the systems working on it
+	World world;
+	AISystem	  ai_system(world.registry, world.collision);
+	WorldSystem   world_system(world);
+	RenderSystem  renderer_system(world.registry);
+	PhysicsSystem physics_system(world.registry, world.collision, world.contacts, world.projectiles);
+	MotionSystem  motion_system(world.registry);
+	ItemSystem    item_system(world);
+	PotionSystem  potion_system(world.registry);
+	BiomeSystem   biome_system(world);
+	UISystem      ui_system(world);
 	SoundSystem	  sound_system;
 
 	// initialize window
@@ -53,17 +60,66 @@ int main()
 	// Initialize UI system last (after all other systems) and set reference in world system 
 	bool ui_initialized = ui_system.init(window, &renderer_system);
 	if (ui_initialized) {
+		world.ui = &ui_system;
 		world_system.setUISystem(&ui_system);
-		item_system.setUISystem(&ui_system);
 		biome_system.setUISystem(&ui_system);
-		ai_system.setUISystem(&ui_system);
-		glfwSetCharCallback(window, UISystem::charCallback);
 		std::cout << "UI system initialized successfully" << std::endl;
 	}
 	else {
 		std::cerr << "Failed to initialize UI system, continuing without UI" << std::endl;
 	}
 
+	// worker threads for the scheduler and for systems splitting up large loops
+	JobSystem jobs;
+	world.projectiles.init(&jobs);
+
+	// CK: be mindful of the order of your systems and rearrange this list only if necessary
+	// Systems declare the containers they read and write, systems that do not conflict may run concurrently.
+	// Exclusive systems touch the UI, rendering, sound or the console and run alone on this thread.
+	// The AI, the cauldrons and the respawn timers record what would need any of those, the sync point
+	// after them applies it. The other sync points apply the entity removals the systems deferred while iterating.
+	// The collision world is only queried by the AI and by exclusive systems.
+	ECSRegistry& registry = world.registry;
+	float elapsed_ms = 0.f;
+	SystemAccess exclusive;
+	exclusive.exclusive = true;
+	SystemAccess ai_access;
+	ai_access.reads = ECSRegistry::mask<ScreenState, Player, CollisionFilter, Terrain, Guardian, Mesh*>();
+	ai_access.writes = ECSRegistry::mask<Motion, Enemy>();
+	SystemAccess cauldron_access;
+	cauldron_access.reads = ECSRegistry::mask<ScreenState, Inventory, Item, Ingredient>();
+	cauldron_access.writes = ECSRegistry::mask<Cauldron, Potion>();
+	SystemAccess respawn_access; // the timers live in the RespawnSystem
+	SystemAccess motion_access;
+	motion_access.reads = ECSRegistry::mask<ScreenState, Player, Guardian>();
+	motion_access.writes = ECSRegistry::mask<Motion>();
+	SystemAccess projectile_access;
+	projectile_access.reads = ECSRegistry::mask<ScreenState>();
+	projectile_access.writes = ECSRegistry::mask<Motion, Ammo, RenderRequest>();
+	SystemAccess item_access; // the item step has nothing to update yet
+
+	SystemScheduler scheduler(jobs);
+	scheduler.add("world", exclusive, [&]() { world_system.step(elapsed_ms); });
+	scheduler.sync("flush", [&]() { registry.flush_commands(); });
+	scheduler.add("ai", ai_access, [&]() { ai_system.step(elapsed_ms); });
+	scheduler.add("cauldrons", cauldron_access, [&]() { potion_system.updateCauldrons(elapsed_ms); });
+	scheduler.add("respawn timers", respawn_access, [&]() { world.respawns.step(elapsed_ms); });
+	scheduler.sync("recorded", [&]() {
+		potion_system.applyRecordedWaits();
+		world.respawns.spawnFinished();
+	});
+	scheduler.add("motion", motion_access, [&]() { motion_system.step(elapsed_ms); });
+	scheduler.add("projectiles", projectile_access, [&]() { world.projectiles.step(elapsed_ms); });
+	scheduler.add("physics", exclusive, [&]() { physics_system.step(elapsed_ms); });
+	scheduler.sync("flush", [&]() { registry.flush_commands(); });
+	scheduler.add("item", item_access, [&]() { item_system.step(elapsed_ms); });
+	scheduler.add("collisions", exclusive, [&]() { world_system.handle_collisions(elapsed_ms); });
+	scheduler.sync("flush", [&]() { registry.flush_commands(); });
+	scheduler.add("biome", exclusive, [&]() { biome_system.step(elapsed_ms); });
+	scheduler.add("ui", exclusive, [&]() { ui_system.step(elapsed_ms); });
+	scheduler.add("draw", exclusive, [&]() { renderer_system.draw(&ui_system, elapsed_ms); });
+	scheduler.add("swap", exclusive, [&]() { renderer_system.swap_buffers(); });
+
 	// variable timestep loop
 	auto t = Clock::now();
 	while (!world_system.is_over()) {
@@ -73,26 +129,21 @@ int main()
 
 		// calculate elapsed times in milliseconds from the previous iteration
 		auto now = Clock::now();
-		float elapsed_ms =
+		elapsed_ms =
 			(float)(std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count() / 1000;
 		t = now;
 
-		// CK: be mindful of the order of your systems and rearrange this list only if necessary
-		world_system.step(elapsed_ms);
-		ai_system.step(elapsed_ms);
-		physics_system.step(elapsed_ms);
-		item_system.step(elapsed_ms);
-		potion_system.updateCauldrons(elapsed_ms);
-		world_system.handle_collisions(elapsed_ms);
-		biome_system.step(elapsed_ms);
-		ui_system.step(elapsed_ms);
-
-		renderer_system.draw(&ui_system, elapsed_ms);
-		renderer_system.swap_buffers();
+		// changes to tracked components are stamped with the frame they happened in
+		registry.next_frame();
+		// last frame's transient data is no longer referenced, here or on the worker threads
+		frame_arena().reset();
+		jobs.reset_frame_arenas();
+
+		scheduler.run_frame();
 	}
 
 	// Save game state before exit
-	item_system.saveGameState();
+	item_system.saveGameState(world);
 
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,63 @@
+// internal
+#include "aabb_tree.hpp"
+
+void AABBTree::clear()
+{
+	items.clear();
+	nodes.clear();
+}
+
+void AABBTree::add(unsigned int id, vec4 box)
+{
+	items.push_back({ box, id });
+}
+
+void AABBTree::build()
+{
+	nodes.clear();
+	if (items.empty())
+		return;
+	// a tree over n items has at most 2n - 1 nodes
+	nodes.reserve(2 * items.size());
+	build_node(0, (unsigned int)items.size());
+}
+
+void AABBTree::build_node(unsigned int first, unsigned int count)
+{
+	unsigned int index = (unsigned int)nodes.size();
+	nodes.push_back({});
+
+	vec2 low = { items[first].box.x, items[first].box.y };
+	vec2 high = low;
+	vec2 centre_low = low + vec2(items[first].box.z, items[first].box.w) / 2.f;
+	vec2 centre_high = centre_low;
+	for (unsigned int i = first; i < first + count; i++)
+	{
+		const vec4& box = items[i].box;
+		vec2 centre = vec2(box.x, box.y) + vec2(box.z, box.w) / 2.f;
+		low = glm::min(low, vec2(box.x, box.y));
+		high = glm::max(high, vec2(box.x + box.z, box.y + box.w));
+		centre_low = glm::min(centre_low, centre);
+		centre_high = glm::max(centre_high, centre);
+	}
+	nodes[index].low = low;
+	nodes[index].high = high;
+
+	if (count <= LEAF_SIZE)
+	{
+		nodes[index].first = first;
+		nodes[index].count = count;
+		return;
+	}
+
+	// split at the median centre along the axis the centres are spread furthest on
+	int axis = (centre_high.x - centre_low.x >= centre_high.y - centre_low.y) ? 0 : 1;
+	unsigned int half = count / 2;
+	std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count, [axis](const Item& a, const Item& b) {
+		return a.box[axis] + a.box[axis + 2] / 2.f < b.box[axis] + b.box[axis + 2] / 2.f;
+	});
+
+	build_node(first, half);
+	nodes[index].right = (unsigned int)nodes.size();
+	build_node(first + half, count - half);
+}
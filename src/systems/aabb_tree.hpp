@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "common.hpp"
+
+// Bounding volume hierarchy over boxes given as (x, y, width, height), for things that do not move.
+// build() splits the boxes at the median of their centres along the longer axis until a node holds at
+// most LEAF_SIZE of them, so the tree is balanced and a query descends O(log n) nodes plus the ones its
+// box actually overlaps. The nodes and the boxes live in two flat arrays, a node's left child directly
+// follows it. Adding or removing a box means building the tree again.
+class AABBTree
+{
+public:
+	static constexpr unsigned int LEAF_SIZE = 2;
+
+	void clear();
+	void add(unsigned int id, vec4 box);
+	void build();
+
+	size_t size() const { return items.size(); }
+
+	// Calls func(id) for every box that overlaps box, touching edges count as overlapping
+	template <typename Func>
+	void query(vec4 box, Func func) const
+	{
+		vec2 low = { box.x, box.y };
+		vec2 high = { box.x + box.z, box.y + box.w };
+		visit([&](vec2 node_low, vec2 node_high) {
+			return node_low.x <= high.x && node_high.x >= low.x && node_low.y <= high.y && node_high.y >= low.y;
+		}, func);
+	}
+
+	// Calls func(id) for every box containing point, edges included
+	template <typename Func>
+	void query_point(vec2 point, Func func) const
+	{
+		query({ point.x, point.y, 0.f, 0.f }, func);
+	}
+
+	// Calls func(id, t) for every box the segment origin + t * direction, 0 <= t <= max_t, passes through,
+	// t being where it enters the box (0 if origin is inside). The boxes are not visited in order of t.
+	template <typename Func>
+	void query_ray(vec2 origin, vec2 direction, float max_t, Func func) const
+	{
+		vec2 inverse = 1.f / direction;
+		float t = 0.f;
+		auto entry = [&](vec2 low, vec2 high) { return ray_entry(origin, inverse, max_t, low, high, t); };
+		visit(entry, [&](unsigned int id) { func(id, t); });
+	}
+
+	// True if the ray origin + t * direction, 0 <= t <= max_t, enters the box from low to high, t is
+	// set to where it does. Takes 1 / direction, computed once per ray.
+	static bool ray_entry(vec2 origin, vec2 inverse_direction, float max_t, vec2 low, vec2 high, float& t)
+	{
+		float enter = 0.f, exit = max_t;
+		if (!clip_slab(origin.x, inverse_direction.x, low.x, high.x, enter, exit) || !clip_slab(origin.y, inverse_direction.y, low.y, high.y, enter, exit))
+			return false;
+		t = enter;
+		return enter <= exit;
+	}
+
+private:
+	struct Item
+	{
+		vec4 box;
+		unsigned int id;
+	};
+
+	// A leaf holds items[first] to items[first + count - 1], an inner node has count 0, its children
+	// are nodes[index + 1] and nodes[right]
+	struct Node
+	{
+		vec2 low;
+		vec2 high;
+		unsigned int first;
+		unsigned int count;
+		unsigned int right;
+	};
+
+	// deep enough for any tree built by median splits of an unsigned int count of boxes
+	static constexpr unsigned int MAX_DEPTH = 64;
+
+	std::vector<Item> items;
+	std::vector<Node> nodes;
+
+	void build_node(unsigned int first, unsigned int count);
+
+	// Narrows [enter, exit] to the part of the ray between low and high along one axis
+	static bool clip_slab(float origin, float inverse, float low, float high, float& enter, float& exit)
+	{
+		// the ray runs parallel to this axis
+		if (std::isinf(inverse))
+			return origin >= low && origin <= high;
+		float t1 = (low - origin) * inverse;
+		float t2 = (high - origin) * inverse;
+		enter = std::max(enter, std::min(t1, t2));
+		exit = std::min(exit, std::max(t1, t2));
+		return true;
+	}
+
+	// Walks every node overlaps(low, high) accepts and calls func(id) for the items of accepted leaves
+	// whose own box it accepts too
+	template <typename Overlaps, typename Func>
+	void visit(Overlaps overlaps, Func func) const
+	{
+		if (nodes.empty())
+			return;
+		unsigned int stack[MAX_DEPTH];
+		unsigned int depth = 0;
+		stack[depth++] = 0;
+		while (depth > 0)
+		{
+			unsigned int index = stack[--depth];
+			const Node& node = nodes[index];
+			if (!overlaps(node.low, node.high))
+				continue;
+			if (node.count == 0)
+			{
+				stack[depth++] = node.right;
+				stack[depth++] = index + 1;
+				continue;
+			}
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				const vec4& box = items[i].box;
+				if (overlaps(vec2(box.x, box.y), vec2(box.x + box.z, box.y + box.w)))
+					func(items[i].id);
+			}
+		}
+	}
+};
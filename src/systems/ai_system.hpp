@@ -1,25 +1,38 @@
 #pragma once
 
+#include <random>
+
 #include "common.hpp"
-#include "render_system.hpp"
 #include "tinyECS/registry.hpp"
+#include "collision_world.hpp"
 
 class AISystem
 {
 public:
+	// seed starts the random walk, a fixed one makes the enemies wander the same way every run
+	AISystem(ECSRegistry& registry, const CollisionWorld& collision, unsigned int seed = std::random_device()())
+		: registry(registry), collision(collision), rng(seed) {}
+
+	// Moves the enemies. Writes their Motion and Enemy and only reads the rest of the registry and the
+	// collision world, so it can run alongside systems that do not touch those.
 	void step(float elapsed_ms);
-	void setUISystem(UISystem* ui_system) { m_ui_system = ui_system; }
 
 private:
-	void updateEnemyAI(float elapsed_ms, Entity enemy_entity, Entity player_entity);
-	void moveEnemyTowardsPlayer(Motion& enemy_motion, Motion& player_motion, float elapsed_ms);
-	void moveEnemyRandomly(Motion& enemy_motion, float elapsed_ms);
-	void moveEnemyTowardsSpawn(Motion& enemy_motion, glm::vec2 spawn_position, float elapsed_ms);
+	ECSRegistry& registry;
+	const CollisionWorld& collision;
 
-	glm::vec2 handleCollision(const Motion& entity_motion, glm::vec2 next_position, glm::vec2 direction, float elapsed_ms);
-	bool isCollision(const Motion& entity_motion);
-	vec4 get_bounding_box(const Motion& motion, float width_ratio, float height_ratio);
-	bool collides(const Motion& player_motion, const Motion& terrain_motion, const Terrain* terrain);
+	// The heading the wandering enemies share and how long until the next one is picked, in seconds
+	std::default_random_engine rng;
+	std::uniform_real_distribution<float> wander_angle{ 0.f, (float)(2 * M_PI) };
+	glm::vec2 wander_direction = { 1.0f, 0.0f };
+	float wander_direction_timer = 0.0f;
+
+	void updateEnemyAI(float elapsed_ms, Entity enemy_entity, Entity player_entity);
+	void moveEnemyTowardsPlayer(Motion& enemy_motion, Motion& player_motion, unsigned int mask, float elapsed_ms);
+	void moveEnemyRandomly(Motion& enemy_motion, unsigned int mask, float elapsed_ms);
+	void moveEnemyTowardsSpawn(Motion& enemy_motion, glm::vec2 spawn_position, unsigned int mask, float elapsed_ms);
 
-	UISystem* m_ui_system = nullptr;
+	// mask is the CollisionFilter mask of the moving entity, what it may not walk into
+	glm::vec2 handleCollision(const Motion& entity_motion, glm::vec2 next_position, glm::vec2 direction, unsigned int mask, float elapsed_ms);
+	bool isCollision(const Motion& entity_motion, unsigned int mask);
 };
\ No newline at end of file
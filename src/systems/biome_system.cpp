@@ -1,5 +1,6 @@
 #include "common.hpp"
 #include "biome_system.hpp"
+#include "world.hpp"
 #include "physics_system.hpp"
 #include "item_system.hpp"
 #include "world_init.hpp"
@@ -9,6 +10,11 @@
 
 #include <vector>
 
+BiomeSystem::BiomeSystem(World& world)
+	: world(world), registry(world.registry), m_loaded_game_data(nullptr), m_has_pending_chest_inventory(false)
+{
+}
+
 void BiomeSystem::init(RenderSystem* renderer_arg) {
 	this->renderer = renderer_arg;
 	ScreenState& screen = registry.screenStates.components[0];
@@ -49,14 +55,6 @@ void BiomeSystem::step(float elapsed_ms_since_last_update) {
 			screen.darken_screen_factor += elapsed_ms_since_last_update * TIME_UPDATE_FACTOR;
 			if (screen.darken_screen_factor >= 1)
 				screen.fade_status = 1; // after fade out
-
-			// stop ammo motion, enemy motion is handled in ai_system
-			for (Entity ammo : registry.ammo.entities) {
-				if (registry.motions.has(ammo)) {
-					registry.motions.get(ammo).velocity = { 0,0 };
-				}
-			}
-
 		}
 		else if (screen.fade_status == 1)
 		{
@@ -85,13 +83,14 @@ void BiomeSystem::step(float elapsed_ms_since_last_update) {
 void BiomeSystem::switchBiome(int biome, bool is_first_load) {
 	std::vector<Entity> to_remove;
 
-	for (auto entity : registry.motions.entities) {
-		if (registry.players.has(entity) || registry.inventories.has(entity) || registry.potions.has(entity)) continue; // don't lose potion effects
+	// thrown ammo does not follow the player, it lands and stays hidden for the next throws
+	world.projectiles.retire_all();
 
+	// don't lose players, inventories or potion effects
+	for (auto [entity, motion] : registry.view<Motion>(exclude<Player, Inventory, Potion>)) {
 		// don't delete any render requests marked as invisible
-		if (registry.renderRequests.has(entity)) {
-			if (!registry.renderRequests.get(entity).is_visible) continue;
-		}
+		RenderRequest* render_request = registry.renderRequests.find(entity);
+		if (render_request && !render_request->is_visible) continue;
 
 		// Register with RespawnSystem before removal if it's a tracked entity type
 		if (registry.items.has(entity) || registry.enemies.has(entity)) {
@@ -100,7 +99,7 @@ void BiomeSystem::switchBiome(int biome, bool is_first_load) {
 			}
 			else {
 				// Mark as still in the respawn pool (no timer running yet)
-				RespawnSystem::getInstance().registerEntity(entity, true);
+				world.respawns.registerEntity(entity, true);
 			}
 		}
 
@@ -151,6 +150,9 @@ void BiomeSystem::switchBiome(int biome, bool is_first_load) {
 
 	renderPlayerInNewBiome(is_first_load);
 	m_ui_system->createEnemyHealthBars();
+
+	// the biome's terrain is in place and does not move until the next switch
+	world.collision.build_terrain(registry);
 }
 
 void BiomeSystem::renderPlayerInNewBiome(bool is_first_load) {
@@ -185,7 +187,7 @@ void BiomeSystem::renderPlayerInNewBiome(bool is_first_load) {
 			// recreate textbox
 			if (registry.motions.has(cauldron)) {
 				Motion& motion = registry.motions.get(cauldron);
-				createTextbox(renderer, vec2(motion.position.x + 70, motion.position.y - 80), cauldron, "[F] Use Cauldron");
+				createTextbox(registry, renderer, vec2(motion.position.x + 70, motion.position.y - 80), cauldron, "[F] Use Cauldron");
 			}
 		}
 
@@ -203,14 +205,14 @@ void BiomeSystem::renderPlayerInNewBiome(bool is_first_load) {
 						break;
 					}
 				}
-				createTextbox(renderer, vec2(motion.position.x, motion.position.y - 50), chest, "[F] Open Chest");
+				createTextbox(registry, renderer, vec2(motion.position.x, motion.position.y - 50), chest, "[F] Open Chest");
 			}
 		}
 
 		if (!m_loaded_game_data.is_null() || m_has_pending_chest_inventory) {
 			std::cout << "Loading inventory state in grotto. Current chest count: " << registry.chests.entities.size() << std::endl;
 			if (!m_loaded_game_data.is_null()) {
-				ItemSystem::loadInventoryState(m_loaded_game_data);
+				ItemSystem::loadInventoryState(registry, m_loaded_game_data);
 				m_loaded_game_data = nullptr;
 			}
 			m_has_pending_chest_inventory = false;
@@ -230,7 +232,7 @@ void BiomeSystem::renderPlayerInNewBiome(bool is_first_load) {
 						break;
 					}
 				}
-				createTextbox(renderer, vec2(motion.position.x, motion.position.y - 25), mortar, "[F] Mortar & Pestle");
+				createTextbox(registry, renderer, vec2(motion.position.x, motion.position.y - 25), mortar, "[F] Mortar & Pestle");
 			}
 		}
 	}
@@ -328,10 +330,10 @@ void BiomeSystem::renderPlayerInNewBiome(bool is_first_load) {
 					for (const auto& inv_data : m_loaded_game_data["inventories"]) {
 						std::string owner_type = inv_data["owner_type"];
 						if (owner_type == "player") {
-							ItemSystem::deserializeInventory(player, inv_data);
+							ItemSystem::deserializeInventory(registry, player, inv_data);
 						}
 						else if (owner_type == "cauldron" && !registry.cauldrons.entities.empty()) {
-							ItemSystem::deserializeInventory(registry.cauldrons.entities[0], inv_data);
+							ItemSystem::deserializeInventory(registry, registry.cauldrons.entities[0], inv_data);
 						}
 					}
 				}
@@ -342,10 +344,13 @@ void BiomeSystem::renderPlayerInNewBiome(bool is_first_load) {
 		}
 	}
 
+	// the player was placed, not walked here, the next collision check must not sweep from where it was
+	player_motion.previous_position = player_motion.position;
+
 	// If this is a direct load into the grotto, just load inventory data
 	if (screen.biome == (int)BIOME::GROTTO && !is_first_load && !m_loaded_game_data.is_null()) {
 		std::cout << "Loading inventory state after biome initialization. Current chest count: " << registry.chests.entities.size() << std::endl;
-		ItemSystem::loadInventoryState(m_loaded_game_data);
+		ItemSystem::loadInventoryState(registry, m_loaded_game_data);
 		m_loaded_game_data = nullptr;
 		m_has_pending_chest_inventory = false; // Reset the flag
 	}
@@ -355,24 +360,24 @@ void BiomeSystem::createGrotto()
 {
 	// create tutorial screen
 	if (registry.screenStates.components[0].tutorial_state == (int)TUTORIAL::WELCOME_SCREEN) {
-		createWelcomeScreen(renderer, vec2(WINDOW_WIDTH_PX / 2, WINDOW_HEIGHT_PX / 2 - 50));
+		createWelcomeScreen(registry, renderer, vec2(WINDOW_WIDTH_PX / 2, WINDOW_HEIGHT_PX / 2 - 50));
 	}
 
 	// positions are according to sample grotto interior
 	for (const auto& [position, scale] : biome_boundaries.at((int)BIOME::GROTTO))
 	{
-		createBoundaryLine(renderer, position, scale);
+		createBoundaryLine(registry, renderer, position, scale);
 	}
 
 	for (const auto& [position, size, rotation, texture, layer] : grotto_static_entity_pos) {
-		createGrottoStaticEntities(renderer, position, size, rotation, texture, layer);
+		createGrottoStaticEntities(registry, renderer, position, size, rotation, texture, layer);
 	}
 
-	createGrottoPoolMesh(renderer, vec2(GRID_CELL_WIDTH_PX * 4.8, GRID_CELL_HEIGHT_PX * 11));
+	createGrottoPoolMesh(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 4.8, GRID_CELL_HEIGHT_PX * 11));
 
 	if (registry.cauldrons.entities.size() == 0) {
 		std::cout << "creating cauldron in grotto" << std::endl;
-		Entity new_cauldron = createCauldron(renderer, vec2({ GRID_CELL_WIDTH_PX * 13.45, GRID_CELL_HEIGHT_PX * 6.05 }), vec2({ 140, 210 }), "Cauldron", false);
+		Entity new_cauldron = createCauldron(registry, renderer, vec2({ GRID_CELL_WIDTH_PX * 13.45, GRID_CELL_HEIGHT_PX * 6.05 }), vec2({ 140, 210 }), "Cauldron", false);
 		for (Entity cauldron : registry.cauldrons.entities) {
 			if (new_cauldron != cauldron) registry.remove_all_components_of(cauldron);
 		}
@@ -386,7 +391,7 @@ void BiomeSystem::createGrotto()
 	// assert(registry.cauldrons.entities.size() == 1); // We should always only have one cauldron for testing purposes
 
 	if (registry.mortarAndPestles.entities.size() == 0) {
-		Entity new_mortar = createMortarPestle(renderer, vec2({ GRID_CELL_WIDTH_PX * 7.5, GRID_CELL_HEIGHT_PX * 5.22 }), vec2({ 213, 141 }), "Mortar and Pestle");
+		Entity new_mortar = createMortarPestle(registry, renderer, vec2({ GRID_CELL_WIDTH_PX * 7.5, GRID_CELL_HEIGHT_PX * 5.22 }), vec2({ 213, 141 }), "Mortar and Pestle");
 		for (Entity mortar : registry.mortarAndPestles.entities) {
 			if (new_mortar != mortar) registry.remove_all_components_of(mortar);
 		}
@@ -399,9 +404,9 @@ void BiomeSystem::createGrotto()
 	}
 
 	// createMortarPestle(renderer, vec2({ GRID_CELL_WIDTH_PX * 7.5, GRID_CELL_HEIGHT_PX * 5.22 }), vec2({ 213, 141 }), "Mortar and Pestle");
-	createRecipeBook(renderer, vec2({ GRID_CELL_WIDTH_PX * 4.15, GRID_CELL_HEIGHT_PX * 5.05 }), vec2({ 108, 160 }), "Recipe Book");
-	createChest(renderer, vec2({ GRID_CELL_WIDTH_PX * 1.35, GRID_CELL_HEIGHT_PX * 5.2 }), vec2({ 100, 150 }), "Chest");
-	createGrottoToForest(renderer, vec2(GRID_CELL_WIDTH_PX * 20.5, GRID_CELL_HEIGHT_PX * 13), "Grotto Exit");
+	createRecipeBook(registry, renderer, vec2({ GRID_CELL_WIDTH_PX * 4.15, GRID_CELL_HEIGHT_PX * 5.05 }), vec2({ 108, 160 }), "Recipe Book");
+	createChest(registry, renderer, vec2({ GRID_CELL_WIDTH_PX * 1.35, GRID_CELL_HEIGHT_PX * 5.2 }), vec2({ 100, 150 }), "Chest");
+	createGrottoToForest(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 20.5, GRID_CELL_HEIGHT_PX * 13), "Grotto Exit");
 }
 
 bool BiomeSystem::handleEntranceInteraction(Entity entrance_entity)
@@ -451,116 +456,116 @@ void BiomeSystem::createForest()
 {
 	for (const auto& [position, scale] : biome_boundaries.at((int)BIOME::FOREST))
 	{
-		createBoundaryLine(renderer, position, scale);
+		createBoundaryLine(registry, renderer, position, scale);
 	}
 
-	createForestBridge(renderer, vec2(307, 485));
-	createForestBridgeTop(renderer, vec2(307, 425));
-	createForestBridgeBottom(renderer, vec2(309, 545));
+	createForestBridge(registry, renderer, vec2(307, 485));
+	createForestBridgeTop(registry, renderer, vec2(307, 425));
+	createForestBridgeBottom(registry, renderer, vec2(309, 545));
 
 	// NOTE: leaving this in for debugging vertices of meshes for the future
 	/*
-		Entity terrain_entity = createMushroomAcidLakeMesh(renderer, vec2(670, 117));
+		Entity terrain_entity = createMushroomAcidLakeMesh(registry, renderer, vec2(670, 117));
 		Mesh* mesh = registry.meshPtrs.get(terrain_entity);
 		Motion motion = registry.motions.get(terrain_entity);
-		std::vector<vec2> transformed_vertices = PhysicsSystem::get_transformed_vertices(*mesh, motion);
+		FrameVector<vec2> transformed_vertices = PhysicsSystem::get_transformed_vertices(*mesh, motion);
 
 		for (vec2 vertex : transformed_vertices) {
-			createCollectableIngredient(renderer, vertex, ItemType::COFFEE_BEANS, 1, true);
+			createCollectableIngredient(world, renderer, vertex, ItemType::COFFEE_BEANS, 1, true);
 		}
 	*/
 
-	createForestRiver(renderer, vec2(307, 0));
+	createForestRiver(registry, renderer, vec2(307, 0));
 
-	createTree(renderer, vec2(530, 330));
-	createTree(renderer, vec2(703, 165));
+	createTree(world, renderer, vec2(530, 330));
+	createTree(world, renderer, vec2(703, 165));
 
-	createTreeNoFruit(renderer, vec2(714, 465));
-	createTree(renderer, vec2(857, 540));
-	createTreeNoFruit(renderer, vec2(520, 550));
+	createTreeNoFruit(registry, renderer, vec2(714, 465));
+	createTree(world, renderer, vec2(857, 540));
+	createTreeNoFruit(registry, renderer, vec2(520, 550));
 
-	createBush(renderer, vec2(1078, 620));
+	createBush(world, renderer, vec2(1078, 620));
 
-	createCollectableIngredient(renderer, vec2(1085, 282), ItemType::STORM_BARK, 1, true);
-	createCollectableIngredient(renderer, vec2(560, 160), ItemType::STORM_BARK, 1, true);
-	createCollectableIngredient(renderer, vec2(650, 610), ItemType::BLIGHTLEAF, 1, true);
+	createCollectableIngredient(world, renderer, vec2(1085, 282), ItemType::STORM_BARK, 1, true);
+	createCollectableIngredient(world, renderer, vec2(560, 160), ItemType::STORM_BARK, 1, true);
+	createCollectableIngredient(world, renderer, vec2(650, 610), ItemType::BLIGHTLEAF, 1, true);
 
 	// admin flag used so we can test the game and disable guardian spawns
 	if (!ADMIN_FLAG) {
 		ScreenState screen = registry.screenStates.components[0];
 		if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "desert") == screen.unlocked_biomes.end())
 		{
-			Entity desertGuardian = createGuardianDesert(renderer, vec2(GRID_CELL_WIDTH_PX * 2, GRID_CELL_HEIGHT_PX * 2.5), 0, "Desert Guardian");
+			createGuardianDesert(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 2, GRID_CELL_HEIGHT_PX * 2.5), 0, "Desert Guardian");
 		}
 
 		if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "mushroom") == screen.unlocked_biomes.end())
 		{
-			Entity mushroomGuardian = createGuardianMushroom(renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, WINDOW_HEIGHT_PX - 80), 0, "Mushroom Guardian");
+			createGuardianMushroom(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, WINDOW_HEIGHT_PX - 80), 0, "Mushroom Guardian");
 		}
 		else {
-			createForestToMushroom(renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, WINDOW_HEIGHT_PX - 40), "Mushroom Entrance");
+			createForestToMushroom(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, WINDOW_HEIGHT_PX - 40), "Mushroom Entrance");
 		}
 	}
 
-	createForestToGrotto(renderer, vec2(GRID_CELL_WIDTH_PX * 20, GRID_CELL_HEIGHT_PX * 1), "Grotto Entrance");
-	createForestToForestEx(renderer, vec2(WINDOW_WIDTH_PX, 470), "Forest Ex Entrance");
-	createForestToDesert(renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, GRID_CELL_HEIGHT_PX * 1.2), "Desert Entrance");
+	createForestToGrotto(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 20, GRID_CELL_HEIGHT_PX * 1), "Grotto Entrance");
+	createForestToForestEx(registry, renderer, vec2(WINDOW_WIDTH_PX, 470), "Forest Ex Entrance");
+	createForestToDesert(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, GRID_CELL_HEIGHT_PX * 1.2), "Desert Entrance");
 }
 
 void BiomeSystem::createForestEx()
 {
 	for (const auto& [position, scale] : biome_boundaries.at((int)BIOME::FOREST_EX))
 	{
-		createBoundaryLine(renderer, position, scale);
+		createBoundaryLine(registry, renderer, position, scale);
 	}
 
-	createTreeNoFruit(renderer, vec2(130, 130));
-	createTreeNoFruit(renderer, vec2(216, 240));
-	createTree(renderer, vec2(403, 180));
-	createTree(renderer, vec2(504, 535));
-	createTreeNoFruit(renderer, vec2(857, 140));
-	createTreeNoFruit(renderer, vec2(1120, 280));
-	createTreeNoFruit(renderer, vec2(1080, 535));
+	createTreeNoFruit(registry, renderer, vec2(130, 130));
+	createTreeNoFruit(registry, renderer, vec2(216, 240));
+	createTree(world, renderer, vec2(403, 180));
+	createTree(world, renderer, vec2(504, 535));
+	createTreeNoFruit(registry, renderer, vec2(857, 140));
+	createTreeNoFruit(registry, renderer, vec2(1120, 280));
+	createTreeNoFruit(registry, renderer, vec2(1080, 535));
 
-	createBush(renderer, vec2(225, 600));
+	createBush(world, renderer, vec2(225, 600));
 
-	createCollectableIngredient(renderer, vec2(288, 101), ItemType::EVERFERN, 1, true);
-	createCollectableIngredient(renderer, vec2(708, 580), ItemType::EVERFERN, 1, true);
-	createCollectableIngredient(renderer, vec2(1153, 109), ItemType::BLIGHTLEAF, 1, true);
-	createCollectableIngredient(renderer, vec2(72, 619), ItemType::BLIGHTLEAF, 1, true);
-	createCollectableIngredient(renderer, vec2(63, 278), ItemType::STORM_BARK, 1, true);
-	createCollectableIngredient(renderer, vec2(950, 325), ItemType::STORM_BARK, 1, true);
+	createCollectableIngredient(world, renderer, vec2(288, 101), ItemType::EVERFERN, 1, true);
+	createCollectableIngredient(world, renderer, vec2(708, 580), ItemType::EVERFERN, 1, true);
+	createCollectableIngredient(world, renderer, vec2(1153, 109), ItemType::BLIGHTLEAF, 1, true);
+	createCollectableIngredient(world, renderer, vec2(72, 619), ItemType::BLIGHTLEAF, 1, true);
+	createCollectableIngredient(world, renderer, vec2(63, 278), ItemType::STORM_BARK, 1, true);
+	createCollectableIngredient(world, renderer, vec2(950, 325), ItemType::STORM_BARK, 1, true);
 
 
 	ScreenState& screen = registry.screenStates.components[0];
 	if (!screen.saved_grotto) {
 		// should we also have a check for killed enemies here like we do with mummies?
-		createEnt(renderer, vec2(606, 390), 1, "Ent");
-		createEnt(renderer, vec2(1011, 158), 1, "Ent 2");
+		createEnt(world, renderer, vec2(606, 390), 1, "Ent");
+		createEnt(world, renderer, vec2(1011, 158), 1, "Ent 2");
 	}
 
-	createMasterPotionPedestal(renderer, vec2(638, 150));
+	createMasterPotionPedestal(registry, renderer, vec2(638, 150));
 
 	if (!ADMIN_FLAG) {
 		ScreenState screen = registry.screenStates.components[0];
 		if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "crystal") == screen.unlocked_biomes.end())
 		{
-			createGuardianCrystal(renderer, vec2(900, 620), 0, "Crystal Guardian");
+			createGuardianCrystal(registry, renderer, vec2(900, 620), 0, "Crystal Guardian");
 		}
 		else {
-			createForestExToCrystal(renderer, vec2(930, 665), "Forest Ex to Crystal");
+			createForestExToCrystal(registry, renderer, vec2(930, 665), "Forest Ex to Crystal");
 		}
 
 		// render potion of rejuvenation on pedestal if we've saved the grotto
 		if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "saved-grotto") != screen.unlocked_biomes.end())
 		{
-			createRejuvenationPotion(renderer);
-			createGlowEffect(renderer, true); // don't regrow effect when re-entering biome
+			createRejuvenationPotion(registry, renderer);
+			createGlowEffect(registry, renderer, true); // don't regrow effect when re-entering biome
 		}
 	}
 
-	createForestExToForest(renderer, vec2(50, 470), "Forest Ex to Forest");
-	if (ADMIN_FLAG) createForestExToCrystal(renderer, vec2(930, 665), "Forest Ex to Crystal");
+	createForestExToForest(registry, renderer, vec2(50, 470), "Forest Ex to Forest");
+	if (ADMIN_FLAG) createForestExToCrystal(registry, renderer, vec2(930, 665), "Forest Ex to Crystal");
 }
 
 void BiomeSystem::createDesert()
@@ -568,26 +573,26 @@ void BiomeSystem::createDesert()
 	// positions are according to sample desert
 	for (const auto& [position, scale] : biome_boundaries.at((int)BIOME::DESERT))
 	{
-		createBoundaryLine(renderer, position, scale);
+		createBoundaryLine(registry, renderer, position, scale);
 	}
 
-	createDesertToForest(renderer, vec2(GRID_CELL_WIDTH_PX * 20.3, GRID_CELL_HEIGHT_PX * 12.9), "Desert Exit");
-	createDesertTree(renderer, vec2(GRID_CELL_WIDTH_PX * 20, GRID_CELL_HEIGHT_PX * 3.9));
-	createDesertCactus(renderer, vec2(GRID_CELL_WIDTH_PX * 4.1, GRID_CELL_HEIGHT_PX * 6.2));
-	createDesertRiver(renderer, vec2(1190, WINDOW_HEIGHT_PX / 2));
-	createDesertPage(renderer, vec2(GRID_CELL_WIDTH_PX * 13.5, GRID_CELL_HEIGHT_PX * 3.2));
-	createDesertSkull(renderer, vec2(GRID_CELL_WIDTH_PX * 13.7, GRID_CELL_HEIGHT_PX * 10.9));
-	createCollectableIngredient(renderer, vec2(1096, 373), ItemType::HEALING_LILY, 1, true);
-	createCollectableIngredient(renderer, vec2(400, 194), ItemType::HEALING_LILY, 1, true);
+	createDesertToForest(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 20.3, GRID_CELL_HEIGHT_PX * 12.9), "Desert Exit");
+	createDesertTree(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 20, GRID_CELL_HEIGHT_PX * 3.9));
+	createDesertCactus(world, renderer, vec2(GRID_CELL_WIDTH_PX * 4.1, GRID_CELL_HEIGHT_PX * 6.2));
+	createDesertRiver(registry, renderer, vec2(1190, WINDOW_HEIGHT_PX / 2));
+	createDesertPage(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 13.5, GRID_CELL_HEIGHT_PX * 3.2));
+	createDesertSkull(world, renderer, vec2(GRID_CELL_WIDTH_PX * 13.7, GRID_CELL_HEIGHT_PX * 10.9));
+	createCollectableIngredient(world, renderer, vec2(1096, 373), ItemType::HEALING_LILY, 1, true);
+	createCollectableIngredient(world, renderer, vec2(400, 194), ItemType::HEALING_LILY, 1, true);
 
 	ScreenState screen = registry.screenStates.components[0];
 	if (!screen.saved_grotto) {
 		if (std::find(screen.killed_enemies.begin(), screen.killed_enemies.end(), "Mummy 1") == screen.killed_enemies.end())
 		{
-			createMummy(renderer, vec2(GRID_CELL_WIDTH_PX * 15, GRID_CELL_HEIGHT_PX * 5), 1, "Mummy 1");
+			createMummy(world, renderer, vec2(GRID_CELL_WIDTH_PX * 15, GRID_CELL_HEIGHT_PX * 5), 1, "Mummy 1");
 		}
 		if (std::find(screen.killed_enemies.begin(), screen.killed_enemies.end(), "Mummy 2") == screen.killed_enemies.end()) {
-			createMummy(renderer, vec2(GRID_CELL_WIDTH_PX * 4, GRID_CELL_HEIGHT_PX * 8), 1, "Mummy 2");
+			createMummy(world, renderer, vec2(GRID_CELL_WIDTH_PX * 4, GRID_CELL_HEIGHT_PX * 8), 1, "Mummy 2");
 		}
 	}
 }
@@ -596,71 +601,71 @@ void BiomeSystem::createMushroom()
 {
 	for (const auto& [position, scale] : biome_boundaries.at((int)BIOME::MUSHROOM))
 	{
-		createBoundaryLine(renderer, position, scale);
+		createBoundaryLine(registry, renderer, position, scale);
 	}
 
-	createMushroomAcidLake(renderer, vec2(670, 117));
-	createMushroomAcidLakeMesh(renderer, vec2(670, 117));
+	createMushroomAcidLake(registry, renderer, vec2(670, 117));
+	createMushroomAcidLakeMesh(registry, renderer, vec2(670, 117));
 
-	createMushRoomTallPink(renderer, vec2(320, 160));
-	createMushroomBlue(renderer, vec2(170, 440));
-	createMushroomPurple(renderer, vec2(380, 485));
-	createMushroomPink(renderer, vec2(560, 440));
-	createMushroomBlue(renderer, vec2(750, 515));
-	createMushroomTallBlue(renderer, vec2(1055, 435));
+	createMushRoomTallPink(registry, renderer, vec2(320, 160));
+	createMushroomBlue(registry, renderer, vec2(170, 440));
+	createMushroomPurple(registry, renderer, vec2(380, 485));
+	createMushroomPink(registry, renderer, vec2(560, 440));
+	createMushroomBlue(registry, renderer, vec2(750, 515));
+	createMushroomTallBlue(registry, renderer, vec2(1055, 435));
 
-	createCollectableIngredient(renderer, vec2(260, 584), ItemType::GLOWSHROOM, 1, true);
-	createCollectableIngredient(renderer, vec2(904, 454), ItemType::GLOWSHROOM, 1, true);
-	createCollectableIngredient(renderer, vec2(1090, 114), ItemType::DOOMCAP, 1, true);
-	createCollectableIngredient(renderer, vec2(1146, 598), ItemType::DOOMCAP, 1, true);
+	createCollectableIngredient(world, renderer, vec2(260, 584), ItemType::GLOWSHROOM, 1, true);
+	createCollectableIngredient(world, renderer, vec2(904, 454), ItemType::GLOWSHROOM, 1, true);
+	createCollectableIngredient(world, renderer, vec2(1090, 114), ItemType::DOOMCAP, 1, true);
+	createCollectableIngredient(world, renderer, vec2(1146, 598), ItemType::DOOMCAP, 1, true);
 
 	ScreenState& screen = registry.screenStates.components[0];
 	if (!screen.saved_grotto) {
-		createEvilMushroom(renderer, vec2(112, 598), 1, "Evil Mushroom 1");
-		createEvilMushroom(renderer, vec2(1037, 501), 1, "Evil Mushroom 2");
+		createEvilMushroom(world, renderer, vec2(112, 598), 1, "Evil Mushroom 1");
+		createEvilMushroom(world, renderer, vec2(1037, 501), 1, "Evil Mushroom 2");
 	}
 
 	if (!ADMIN_FLAG) {
 		ScreenState screen = registry.screenStates.components[0];
 		if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "crystal") == screen.unlocked_biomes.end())
 		{
-			Entity crystalGuardian = createGuardianCrystal(renderer, vec2(1150, 200), 0, "Crystal Guardian");
+			createGuardianCrystal(registry, renderer, vec2(1150, 200), 0, "Crystal Guardian");
 		}
 		else {
-			createMushroomToCrystal(renderer, vec2(1220, 160), "Mushroom to Crystal");
+			createMushroomToCrystal(registry, renderer, vec2(1220, 160), "Mushroom to Crystal");
 		}
 	}
-	createMushroomToForest(renderer, vec2(60, 50), "Mushroom To Forest");
-	if (ADMIN_FLAG) createMushroomToCrystal(renderer, vec2(1220, 160), "Mushroom to Crystal");
+	createMushroomToForest(registry, renderer, vec2(60, 50), "Mushroom To Forest");
+	if (ADMIN_FLAG) createMushroomToCrystal(registry, renderer, vec2(1220, 160), "Mushroom to Crystal");
 }
 
 void BiomeSystem::createCrystal()
 {
 	for (const auto& [position, scale] : biome_boundaries.at((int)BIOME::CRYSTAL))
 	{
-		createBoundaryLine(renderer, position, scale);
+		createBoundaryLine(registry, renderer, position, scale);
 	}
 
-	createCrystal1(renderer, vec2(1100, 240));
-	createCrystal2(renderer, vec2(175, 490));
-	createCrystal3(renderer, vec2(340, 170));
-	createCrystal4(renderer, vec2(100, 92));
+	createCrystal1(registry, renderer, vec2(1100, 240));
+	createCrystal2(registry, renderer, vec2(175, 490));
+	createCrystal3(registry, renderer, vec2(340, 170));
+	createCrystal4(registry, renderer, vec2(100, 92));
 
-	createCrystalMinecart(renderer, vec2(986, 530));
-	createCrystalRock(renderer, vec2(639, 262));
-	createCrystalPage(renderer, vec2(966, 510));
+	createCrystalMinecart(registry, renderer, vec2(986, 530));
+	createCrystalRock(registry, renderer, vec2(639, 262));
+	createCrystalPage(registry, renderer, vec2(966, 510));
 
-	createCollectableIngredient(renderer, vec2(491, 90), ItemType::CRYSTABLOOM, 1, true);
-	createCollectableIngredient(renderer, vec2(458, 355), ItemType::CRYSTAL_SHARD, 1, true);
-	createCollectableIngredient(renderer, vec2(302, 617), ItemType::CRYSTAL_SHARD, 1, true);
-	createCollectableIngredient(renderer, vec2(1141, 624), ItemType::QUARTZMELON, 1, true);
+	createCollectableIngredient(world, renderer, vec2(491, 90), ItemType::CRYSTABLOOM, 1, true);
+	createCollectableIngredient(world, renderer, vec2(458, 355), ItemType::CRYSTAL_SHARD, 1, true);
+	createCollectableIngredient(world, renderer, vec2(302, 617), ItemType::CRYSTAL_SHARD, 1, true);
+	createCollectableIngredient(world, renderer, vec2(1141, 624), ItemType::QUARTZMELON, 1, true);
 
 	ScreenState& screen = registry.screenStates.components[0];
 	if (!screen.saved_grotto) {
-		createCrystalBug(renderer, vec2(632, 586), 1, "Crystal Bug 1");
-		createCrystalBug(renderer, vec2(876, 137), 1, "Crystal Bug 2");
+		createCrystalBug(world, renderer, vec2(632, 586), 1, "Crystal Bug 1");
+		createCrystalBug(world, renderer, vec2(876, 137), 1, "Crystal Bug 2");
 	}
 
-	createCrystalToMushroom(renderer, vec2(50, 200), "Crystal To Mushroom");
-	createCrystalToForestEx(renderer, vec2(930, 30), "Crystal to Forest Ex");
+	createCrystalToMushroom(registry, renderer, vec2(50, 200), "Crystal To Mushroom");
+	createCrystalToForestEx(registry, renderer, vec2(930, 30), "Crystal to Forest Ex");
 }
\ No newline at end of file
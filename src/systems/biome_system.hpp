@@ -36,11 +36,11 @@ public:
         m_has_pending_chest_inventory = true;
     }
 
-    BiomeSystem() : m_loaded_game_data(nullptr), m_has_pending_chest_inventory(false)
-    {
-    }
+    explicit BiomeSystem(World& world);
 
 private:
+    World& world;
+    ECSRegistry& registry;
     RenderSystem* renderer;
     
     // Store loaded game data for deferred inventory loading
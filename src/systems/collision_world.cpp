@@ -0,0 +1,366 @@
+// internal
+#include "collision_world.hpp"
+#include <algorithm>
+#include <cmath>
+
+vec4 get_bounding_box(const Motion& motion, float width_ratio, float height_ratio)
+{
+	// gets the full bounding box
+	float full_width = abs(motion.scale.x);
+	float full_height = abs(motion.scale.y);
+
+	// compute a bottom centered bounding box
+	float box_width = full_width * width_ratio;
+	float box_height = full_height * height_ratio;
+
+	float box_x = motion.position.x - box_width / 2;				// center the box on x-axis
+	float box_y = motion.position.y + full_height / 2 - box_height; // put the box on the bottom
+
+	return { box_x, box_y, box_width, box_height };
+}
+
+static vec4 box_union(const vec4& a, const vec4& b)
+{
+	float x = std::min(a.x, b.x);
+	float y = std::min(a.y, b.y);
+	return { x, y, std::max(a.x + a.z, b.x + b.z) - x, std::max(a.y + a.w, b.y + b.w) - y };
+}
+
+// how many times a move can be redirected along a solid before the rest of it is dropped
+const int MAX_SLIDES = 3;
+// how far a moved box is kept from the solid it stops at, in pixels
+const float CONTACT_SKIN = 0.01f;
+// how much deeper a move may take a box into a solid it started in, for rounding, in pixels
+const float PENETRATION_TOLERANCE = 0.001f;
+
+// the area the top left corner of a box must be in to hit target
+static vec4 target_area(const vec4& target)
+{
+	return { target.x - target.z, target.y - target.w, 2 * target.z, 2 * target.w };
+}
+
+void CollisionWorld::build_terrain(ECSRegistry& registry, float cell_size)
+{
+	this->registry = &registry;
+	terrain.build(registry);
+	build_occupancy(cell_size);
+}
+
+void CollisionWorld::build_occupancy(float cell_size)
+{
+	std::vector<SolidShape> solids;
+	terrain.for_each_static([&](Entity entity, Terrain& terrain_component, Motion& motion) {
+		SolidShape shape;
+		if (solid_shape(entity, terrain_component, motion, shape))
+			solids.push_back(shape);
+	});
+
+	vec4 area = solids.empty() ? vec4(0) : solids[0].box;
+	for (const SolidShape& solid : solids)
+		area = box_union(area, solid.box);
+	occupancy.reset(area, cell_size);
+	for (const SolidShape& solid : solids)
+	{
+		if (solid.mesh)
+			occupancy.mark_if(solid.box, [&](const vec4& cell) { return solid.mesh->overlaps(cell); });
+		else
+			occupancy.mark(solid.box);
+	}
+}
+
+void CollisionWorld::update_dynamic(ECSRegistry& registry)
+{
+	this->registry = &registry;
+	dynamic_grid.clear();
+	dynamic_entities.clear();
+	dynamic_layers.clear();
+	for (auto [entity, enemy, filter, motion] : registry.view<Enemy, CollisionFilter, Motion>())
+	{
+		if (!(filter.layer & (COLLISION_ENEMY | COLLISION_ENEMY_REACH)))
+			continue;
+		// both target areas, they contain the enemy's position too
+		vec4 area = box_union(target_area(get_bounding_box(motion, 0.3f, 0.5f)), target_area(get_bounding_box(motion, 0.8f, 0.8f)));
+		dynamic_grid.add((unsigned int)dynamic_entities.size(), area);
+		dynamic_entities.push_back(entity);
+		dynamic_layers.push_back(filter.layer);
+	}
+	dynamic_grid.build();
+}
+
+bool CollisionWorld::overlapsAny(vec4 box, unsigned int mask) const
+{
+	bool overlap = false;
+	overlapBox(box, mask, [&](Entity) { overlap = true; });
+	return overlap;
+}
+
+bool CollisionWorld::SolidShape::overlaps(const vec4& other) const
+{
+	if (mesh)
+		return mesh->overlaps(other);
+	bool overlap_x = (other.x < box.x + box.z) && (other.x + other.z > box.x);
+	bool overlap_y = (other.y < box.y + box.w) && (other.y + other.w > box.y);
+	return overlap_x && overlap_y;
+}
+
+float CollisionWorld::SolidShape::penetration(const vec4& other) const
+{
+	if (!overlaps(other))
+		return 0.f;
+	// the shortest of the ways out to the four sides
+	float out_x = std::min(other.x + other.z - box.x, box.x + box.z - other.x);
+	float out_y = std::min(other.y + other.w - box.y, box.y + box.w - other.y);
+	return std::max(0.f, std::min(out_x, out_y));
+}
+
+bool CollisionWorld::solid_shape(Entity entity, const Terrain& terrain_component, const Motion& motion, SolidShape& shape) const
+{
+	// terrain should have no collision at all (the texture for a mesh collision entity)
+	if (terrain_component.collision_setting == 2.0f || !on_layer(entity, COLLISION_SOLID))
+		return false;
+
+	// terrain is a mesh collision, the mesh stays transformed until the terrain is moved
+	if (terrain_component.collision_setting == 3.0f)
+	{
+		const MeshCollider* collider = terrain.mesh_collider(entity, motion);
+		shape = { entity, collider ? collider->bounds() : vec4(0), collider };
+		return collider != nullptr;
+	}
+
+	// terrain with setting 0 collides with the bottom part given by its ratios, with setting 1 with all of it
+	vec4 box = terrain_component.collision_setting == 0.0f
+		? get_bounding_box(motion, terrain_component.width_ratio, terrain_component.height_ratio)
+		: get_bounding_box(motion, 1.0f, 1.0f);
+	shape = { entity, box, nullptr };
+	return true;
+}
+
+bool CollisionWorld::solid_overlaps(Entity entity, const Terrain& terrain_component, const Motion& motion, const vec4& box) const
+{
+	SolidShape shape;
+	return solid_shape(entity, terrain_component, motion, shape) && shape.overlaps(box);
+}
+
+void CollisionWorld::gather_solids(vec4 area, FrameVector<SolidShape>& solids) const
+{
+	auto add = [&](Entity entity, Terrain& terrain_component, Motion& motion) {
+		SolidShape shape;
+		if (solid_shape(entity, terrain_component, motion, shape))
+			solids.push_back(shape);
+	};
+	if (occupancy.any(area))
+		terrain.query_static(area, add);
+	terrain.query_movable(area, add);
+}
+
+// Sweeps box by delta against the collision box target
+static SweepHit sweep_against_box(const vec4& target, const vec4& box, vec2 delta)
+{
+	// the times the box starts and stops overlapping target along each axis
+	float enter = -INFINITY, exit = INFINITY;
+	vec2 normal = { 0, 0 };
+	for (int axis = 0; axis < 2; axis++)
+	{
+		float low = box[axis], size = box[axis + 2];
+		float target_low = target[axis], target_size = target[axis + 2];
+		if (delta[axis] == 0.f)
+		{
+			if (!(low < target_low + target_size && low + size > target_low))
+				return {};
+			continue;
+		}
+		float t1 = (target_low - (low + size)) / delta[axis];
+		float t2 = (target_low + target_size - low) / delta[axis];
+		float axis_enter = std::min(t1, t2), axis_exit = std::max(t1, t2);
+		if (axis_enter > enter)
+		{
+			enter = axis_enter;
+			normal = { 0, 0 };
+			normal[axis] = delta[axis] > 0 ? -1.f : 1.f;
+		}
+		exit = std::min(exit, axis_exit);
+	}
+	if (enter >= exit || enter >= 1.f || exit <= 0.f)
+		return {};
+	// overlapping from the start
+	if (enter < 0.f)
+		return { true, 0.f, { 0, 0 } };
+	return { true, enter, normal };
+}
+
+// Sweeps box by delta against a mesh, ignoring hits after max_t
+static SweepHit sweep_against_mesh(const MeshCollider& mesh, const vec4& box, vec2 delta, float max_t)
+{
+	auto overlaps_at = [&](vec2 offset) { return mesh.overlaps({ box.x + offset.x, box.y + offset.y, box.z, box.w }); };
+	if (overlaps_at({ 0, 0 }))
+		return { true, 0.f, { 0, 0 } };
+
+	// no closed form for a mesh, step through the sweep in steps of half the box, then bisect between
+	// the last free and the first overlapping step
+	float step_length = std::max(std::min(box.z, box.w) / 2, 1.f);
+	int steps = std::max(1, (int)std::ceil(length(delta) / step_length));
+	float free_t = 0.f;
+	for (int i = 1; i <= steps && free_t < max_t; i++)
+	{
+		float t = (float)i / steps;
+		if (!overlaps_at(delta * t))
+		{
+			free_t = t;
+			continue;
+		}
+		float blocked_t = t;
+		for (int j = 0; j < 8; j++)
+		{
+			float middle = (free_t + blocked_t) / 2;
+			(overlaps_at(delta * middle) ? blocked_t : free_t) = middle;
+		}
+
+		// a mesh has no sides to take the normal from, it is along the axis the box cannot move on
+		vec2 free = delta * free_t;
+		vec2 step = delta * (blocked_t - free_t);
+		bool blocked_x = step.x != 0.f && overlaps_at(free + vec2(step.x, 0.f));
+		bool blocked_y = step.y != 0.f && overlaps_at(free + vec2(0.f, step.y));
+		vec2 normal = { 0, 0 };
+		if (blocked_x && !blocked_y)
+			normal.x = delta.x > 0 ? -1.f : 1.f;
+		else if (blocked_y && !blocked_x)
+			normal.y = delta.y > 0 ? -1.f : 1.f;
+		return { true, free_t, normal };
+	}
+	return {};
+}
+
+SweepHit CollisionWorld::sweep_solids(const FrameVector<SolidShape>& solids, vec4 box, vec2 delta)
+{
+	SweepHit first;
+	for (const SolidShape& solid : solids)
+	{
+		SweepHit hit = solid.mesh ? sweep_against_mesh(*solid.mesh, box, delta, first.t) : sweep_against_box(solid.box, box, delta);
+		if (hit.hit && (!first.hit || hit.t < first.t))
+		{
+			first = hit;
+			first.entity = solid.entity;
+		}
+	}
+	return first;
+}
+
+void CollisionWorld::first_point_hits(vec2 point, vec2 delta, unsigned int mask, FrameVector<Entity>& hits) const
+{
+	// the earliest entry so far and every body entered then, bodies entered later are dropped
+	float first = 1.f;
+	vec2 inverse = 1.f / delta;
+	auto entry = [&](const vec4& target, float& t) {
+		vec4 area = target_area(target);
+		return AABBTree::ray_entry(point, inverse, first, { area.x, area.y }, { area.x + area.z, area.y + area.w }, t);
+	};
+	auto report = [&](Entity entity, float t) {
+		if (t < first)
+		{
+			hits.clear();
+			first = t;
+		}
+		hits.push_back(entity);
+	};
+
+	// moves are short, the box around one is a tighter query than the ray
+	vec2 end = point + delta;
+	vec4 swept = { std::min(point.x, end.x), std::min(point.y, end.y), std::abs(delta.x), std::abs(delta.y) };
+	if (mask & COLLISION_AMMO_STOPPING)
+	{
+		terrain.query(swept, [&](Entity entity, Terrain&, Motion& motion) {
+			float t;
+			if (on_layer(entity, COLLISION_AMMO_STOPPING) && entry(get_bounding_box(motion, 0.3f, 0.5f), t))
+				report(entity, t);
+		});
+	}
+	if (mask & (COLLISION_ENEMY | COLLISION_ENEMY_REACH))
+	{
+		dynamic_grid.query(swept, [&](unsigned int id) {
+			unsigned int layers = mask & dynamic_layers[id];
+			Motion* motion = registry->motions.find(dynamic_entities[id]);
+			if (!motion)
+				return;
+			// an enemy on both layers counts once, where the point first reaches it
+			float t = INFINITY, layer_t;
+			if ((layers & COLLISION_ENEMY) && entry(get_bounding_box(*motion, 0.3f, 0.5f), layer_t))
+				t = layer_t;
+			if ((layers & COLLISION_ENEMY_REACH) && entry(get_bounding_box(*motion, 0.8f, 0.8f), layer_t))
+				t = std::min(t, layer_t);
+			if (t <= first)
+				report(dynamic_entities[id], t);
+		});
+	}
+}
+
+vec2 CollisionWorld::slide(const FrameVector<SolidShape>& solids, vec4 box, vec2 delta)
+{
+	vec2 moved = { 0, 0 };
+	vec2 remaining = delta;
+	for (int i = 0; i < MAX_SLIDES; i++)
+	{
+		SweepHit hit = sweep_solids(solids, { box.x + moved.x, box.y + moved.y, box.z, box.w }, remaining);
+		if (!hit.hit)
+			return moved + remaining;
+
+		// stop a little short of the contact, so rounding cannot leave the box inside the solid
+		float t = std::max(0.f, hit.t - CONTACT_SKIN / length(remaining));
+		moved += remaining * t;
+		remaining *= 1.f - t;
+
+		// the rest of the move goes along the solid
+		if (hit.normal == vec2(0, 0))
+			break;
+		remaining -= dot(remaining, hit.normal) * hit.normal;
+		if (remaining == vec2(0, 0))
+			break;
+	}
+	return moved;
+}
+
+vec2 CollisionWorld::moveAndSlide(vec4 box, vec2 delta, unsigned int mask) const
+{
+	if (!(mask & COLLISION_SOLID) || delta == vec2(0, 0))
+		return delta;
+
+	// sliding only ever drops part of the move, so the solids around the whole of it are all that
+	// can be hit
+	FrameVector<SolidShape> solids;
+	gather_solids(box_union(box, { box.x + delta.x, box.y + delta.y, box.z, box.w }), solids);
+
+	// a solid the box is already in cannot be swept against, it is checked after the move instead
+	FrameVector<SolidShape> inside;
+	FrameVector<float> depths;
+	auto starts_inside = [&](const SolidShape& solid) {
+		if (!solid.overlaps(box))
+			return false;
+		inside.push_back(solid);
+		depths.push_back(solid.penetration(box));
+		return true;
+	};
+	solids.erase(std::remove_if(solids.begin(), solids.end(), starts_inside), solids.end());
+
+	vec2 moved = slide(solids, box, delta);
+	if (inside.empty())
+		return moved;
+
+	// the whole move if it does not go deeper into any of them, otherwise only its part along one axis
+	auto deeper = [&](vec2 offset) {
+		vec4 moved_box = { box.x + offset.x, box.y + offset.y, box.z, box.w };
+		for (size_t i = 0; i < inside.size(); i++)
+			if (inside[i].penetration(moved_box) > depths[i] + PENETRATION_TOLERANCE)
+				return true;
+		return false;
+	};
+	if (!deeper(moved))
+		return moved;
+	for (vec2 part : { vec2(delta.x, 0.f), vec2(0.f, delta.y) })
+	{
+		if (part == vec2(0, 0))
+			continue;
+		moved = slide(solids, box, part);
+		if (!deeper(moved))
+			return moved;
+	}
+	return { 0, 0 };
+}
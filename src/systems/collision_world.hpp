@@ -0,0 +1,172 @@
+#pragma once
+
+#include <vector>
+
+#include "common.hpp"
+#include "tinyECS/registry.hpp"
+#include "tinyECS/frame_arena.hpp"
+#include "terrain_tree.hpp"
+#include "uniform_grid.hpp"
+#include "occupancy_grid.hpp"
+
+// The bottom centered part of the sprite of motion, as (x, y, width, height)
+vec4 get_bounding_box(const Motion& motion, float width_ratio, float height_ratio);
+
+// Where a box moved by a sweep first touches a solid. The box can move by t times the sweep before
+// touching entity, normal points away from the side that was hit. It is zero if the box started out
+// overlapping, or ran into the corner of a mesh head on.
+struct SweepHit
+{
+	bool hit = false;
+	float t = 1.f;
+	vec2 normal = { 0, 0 };
+	Entity entity = Entity::null();
+};
+
+// The collision queries of one world, shared by the physics step, the AI and the player movement.
+// The biome's terrain is static and kept in a TerrainTree that is built once per biome. The solid
+// terrain is also baked into an OccupancyGrid then, which lets box queries in the open skip the tree.
+// Enemies move, they are indexed again in a UniformGrid at the start of every physics step.
+//
+// A body is only hit by a query whose mask shares a bit with the layer bits of its CollisionFilter.
+// What it is hit by depends on the layer:
+// - solid terrain is hit by boxes overlapping its collision box, the bottom part of its sprite given
+//   by its width/height ratios (the whole sprite with collision_setting 1), or its mesh.
+// - ammo stopping terrain and enemies are hit by the top left corner of thrown ammo, enemies in reach
+//   by the top left corner of the player. The corner has to lie within a target box around their
+//   bottom, grown by its own size to the top left.
+class CollisionWorld
+{
+public:
+	// The static bodies, BiomeSystem::switchBiome calls this once the biome's terrain exists
+	void build_terrain(ECSRegistry& registry, float cell_size = COLLISION_CELL_SIZE_PX);
+	// The dynamic bodies, PhysicsSystem::step calls this every step
+	void update_dynamic(ECSRegistry& registry);
+
+	// Calls func(entity) for every solid whose collision shape overlaps box
+	template <typename Func>
+	void overlapBox(vec4 box, unsigned int mask, Func func) const
+	{
+		if (!(mask & COLLISION_SOLID))
+			return;
+		auto report = [&](Entity entity, Terrain& terrain_component, Motion& motion) {
+			if (solid_overlaps(entity, terrain_component, motion, box))
+				func(entity);
+		};
+		// only the terrain that can move has to be looked at for boxes in the open
+		if (occupancy.any(box))
+			terrain.query_static(box, report);
+		terrain.query_movable(box, report);
+	}
+
+	// True if any solid's collision shape overlaps box
+	bool overlapsAny(vec4 box, unsigned int mask) const;
+
+	// Calls func(entity) for every enemy whose target area contains point
+	template <typename Func>
+	void overlapPoint(vec2 point, unsigned int mask, Func func) const
+	{
+		if (mask & (COLLISION_ENEMY | COLLISION_ENEMY_REACH))
+		{
+			dynamic_grid.query({ point.x, point.y, 0.f, 0.f }, [&](unsigned int id) {
+				Entity entity = dynamic_entities[id];
+				unsigned int layers = mask & dynamic_layers[id];
+				Motion* motion = registry->motions.find(entity);
+				if (!motion || !layers)
+					return;
+				if (((layers & COLLISION_ENEMY) && in_target_area(point, get_bounding_box(*motion, 0.3f, 0.5f))) ||
+					((layers & COLLISION_ENEMY_REACH) && in_target_area(point, get_bounding_box(*motion, 0.8f, 0.8f))))
+					func(entity);
+			});
+		}
+	}
+
+	// Like overlapPoint() for a point moving by delta, on the ammo stopping terrain too: calls func(entity)
+	// for the body whose target area the point enters first, or for each of them if it enters several at once
+	template <typename Func>
+	void sweepPoint(vec2 point, vec2 delta, unsigned int mask, Func func) const
+	{
+		FrameVector<Entity> hits;
+		first_point_hits(point, delta, mask, hits);
+		for (Entity entity : hits)
+			func(entity);
+	}
+
+	// Moves box by delta, stopping where it touches a solid and sliding along it for the rest of the
+	// way, and returns how far it got. The solids along the whole move are looked up once and nothing
+	// is modified. Solids the box already overlaps only stop the moves that take it deeper into them,
+	// so it can walk out of them but not on through them.
+	vec2 moveAndSlide(vec4 box, vec2 delta, unsigned int mask) const;
+
+	// Calls func(entity) for every body on the mask's layers whose position is within radius of centre
+	template <typename Func>
+	void queryRadius(vec2 centre, float radius, unsigned int mask, Func func) const
+	{
+		vec4 box = { centre.x - radius, centre.y - radius, 2 * radius, 2 * radius };
+		auto within = [&](const Motion& motion) {
+			vec2 offset = motion.position - centre;
+			return dot(offset, offset) <= radius * radius;
+		};
+		if (mask & (COLLISION_SOLID | COLLISION_AMMO_STOPPING))
+		{
+			terrain.query(box, [&](Entity entity, Terrain&, Motion& motion) {
+				if (on_layer(entity, mask) && within(motion))
+					func(entity);
+			});
+		}
+		if (mask & (COLLISION_ENEMY | COLLISION_ENEMY_REACH))
+		{
+			// an enemy's position lies within its indexed area
+			dynamic_grid.query(box, [&](unsigned int id) {
+				Motion* motion = registry->motions.find(dynamic_entities[id]);
+				if ((mask & dynamic_layers[id]) && motion && within(*motion))
+					func(dynamic_entities[id]);
+			});
+		}
+	}
+
+	// Where the static solid terrain is, for debug drawing and path finding
+	const OccupancyGrid& occupancy_grid() const { return occupancy; }
+
+private:
+	ECSRegistry* registry = nullptr;
+	TerrainTree terrain;
+	OccupancyGrid occupancy;
+	UniformGrid dynamic_grid;
+	std::vector<Entity> dynamic_entities; // by the id they have in the grid
+	std::vector<unsigned int> dynamic_layers; // their CollisionFilter layers, by the same id
+
+	// The collision shape of a solid: its mesh if it has one, its collision box otherwise
+	struct SolidShape
+	{
+		Entity entity;
+		vec4 box;
+		const MeshCollider* mesh;
+
+		bool overlaps(const vec4& other) const;
+		// How far other would have to move to stop overlapping it, measured against the bounds of a mesh
+		float penetration(const vec4& other) const;
+	};
+
+	// False if the terrain does not collide at all
+	bool solid_shape(Entity entity, const Terrain& terrain_component, const Motion& motion, SolidShape& shape) const;
+	bool solid_overlaps(Entity entity, const Terrain& terrain_component, const Motion& motion, const vec4& box) const;
+	void gather_solids(vec4 area, FrameVector<SolidShape>& solids) const;
+	void build_occupancy(float cell_size);
+	static SweepHit sweep_solids(const FrameVector<SolidShape>& solids, vec4 box, vec2 delta);
+	static vec2 slide(const FrameVector<SolidShape>& solids, vec4 box, vec2 delta);
+	void first_point_hits(vec2 point, vec2 delta, unsigned int mask, FrameVector<Entity>& hits) const;
+	bool on_layer(Entity entity, unsigned int mask) const
+	{
+		CollisionFilter* filter = registry->collisionFilters.find(entity);
+		return filter && (filter->layer & mask);
+	}
+
+	// the top left corner of a box hits target when it lies within target grown by its own size to the top left
+	static bool in_target_area(vec2 corner, const vec4& target)
+	{
+		bool overlap_x = (corner.x < target.x + target.z) && (corner.x + target.z > target.x);
+		bool overlap_y = (corner.y < target.y + target.w) && (corner.y + target.w > target.y);
+		return overlap_x && overlap_y;
+	}
+};
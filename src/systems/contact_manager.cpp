@@ -0,0 +1,54 @@
+// internal
+#include "contact_manager.hpp"
+#include <algorithm>
+
+void ContactManager::begin_step()
+{
+	std::swap(current, previous);
+	current.clear();
+	step_events.clear();
+}
+
+void ContactManager::end_step()
+{
+	std::sort(current.begin(), current.end(), [](const Contact& a, const Contact& b) { return a.key() < b.key(); });
+	current.erase(std::unique(current.begin(), current.end(), [](const Contact& a, const Contact& b) { return a.key() == b.key(); }), current.end());
+
+	// both are sorted, walk them side by side
+	size_t i = 0, j = 0;
+	while (i < current.size() || j < previous.size())
+	{
+		if (j == previous.size() || (i < current.size() && current[i].key() < previous[j].key()))
+		{
+			step_events.push_back({ ContactState::BEGIN, current[i].entity, current[i].other });
+			i++;
+		}
+		else if (i == current.size() || previous[j].key() < current[i].key())
+		{
+			step_events.push_back({ ContactState::END, previous[j].entity, previous[j].other });
+			j++;
+		}
+		else
+		{
+			step_events.push_back({ ContactState::STAY, current[i].entity, current[i].other });
+			i++;
+			j++;
+		}
+	}
+}
+
+void ContactManager::forget(Entity entity)
+{
+	// the pairs of entity are next to each other, as it makes up the high bits of their keys
+	uint64_t first = (uint64_t)entity.id() << 32;
+	auto begin = std::lower_bound(current.begin(), current.end(), first, [](const Contact& contact, uint64_t key) { return contact.key() < key; });
+	auto end = std::find_if(begin, current.end(), [&](const Contact& contact) { return contact.entity != entity; });
+	current.erase(begin, end);
+}
+
+void ContactManager::clear()
+{
+	current.clear();
+	previous.clear();
+	step_events.clear();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "tinyECS/entity.hpp"
+
+// Two entities touching, entity is the body whose query found other (the player or thrown ammo)
+struct Contact
+{
+	Entity entity;
+	Entity other;
+
+	uint64_t key() const { return ((uint64_t)entity.id() << 32) | other.id(); }
+};
+
+enum class ContactState
+{
+	BEGIN, // touching since this step
+	STAY,  // touching in the last step and still in this one
+	END    // touching in the last step but not anymore, the entities may be gone
+};
+
+struct ContactEvent
+{
+	ContactState state;
+	Entity entity;
+	Entity other;
+};
+
+// The contacts the physics step finds, kept from one step to the next in a flat array sorted by pair,
+// so each step tells the contacts that began from the ones that go on and the ones that ended.
+// A pair found several times in one step is one contact; the same two entities the other way round
+// are a different pair. Between begin_step() and end_step() the contacts are being collected.
+class ContactManager
+{
+public:
+	// Makes the contacts so far the last step's and starts collecting new ones
+	void begin_step();
+	void add(Entity entity, Entity other) { current.push_back({ entity, other }); }
+	// Sorts the contacts found since begin_step() and compares them with the last step's
+	void end_step();
+
+	// Forgets the contacts of entity without reporting that they ended, so the next step finds them
+	// beginning again, e.g. when a projectile is thrown again. Not while contacts are being collected.
+	void forget(Entity entity);
+	// Forgets every contact without reporting that it ended, e.g. when the world is reloaded
+	void clear();
+
+	// The contacts of the last step, sorted by pair
+	const std::vector<Contact>& contacts() const { return current; }
+	// What changed in the last step, sorted by pair
+	const std::vector<ContactEvent>& events() const { return step_events; }
+
+private:
+	std::vector<Contact> current;
+	std::vector<Contact> previous;
+	std::vector<ContactEvent> step_events;
+};
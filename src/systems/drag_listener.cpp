@@ -2,6 +2,7 @@
 #include "potion_system.hpp"
 #include "item_system.hpp"
 #include "sound_system.hpp"
+#include "world.hpp"
 #include "common.hpp"
 #include <iostream>
 #include <sstream>
@@ -47,6 +48,7 @@ float DragListener::getCurrentDegree(Rml::Element* heatknob) {
 }
 
 void DragListener::setHeatDegree(float degree) {
+	ECSRegistry& registry = m_ui_system->getWorld().registry;
 	int heatLevel = getHeatLevel(degree);
 	Entity cauldron = m_ui_system->getOpenedCauldron();
 	registry.cauldrons.get(cauldron).heatLevel = heatLevel;
@@ -61,6 +63,7 @@ std::pair<float, float> DragListener::getPolarCoordinates(Rml::Vector2f input, R
 }
 
 void DragListener::checkCompletedStir() {
+	ECSRegistry& registry = m_ui_system->getWorld().registry;
 	// We know that stir has at least 2 elements
 	int size = stirCoords.size();
 	float curAngle = stirCoords[size - 1].second;
@@ -102,7 +105,7 @@ void DragListener::checkCompletedStir() {
 		}
 
 		if (a && b && c && d) {
-			PotionSystem::stirCauldron(m_ui_system->getOpenedCauldron());
+			PotionSystem::stirCauldron(registry, m_ui_system->getOpenedCauldron());
 			std::cout << "Recorded a successful ladle stir" << std::endl;
 			registry.cauldrons.get(m_ui_system->getOpenedCauldron()).num_stirs += 1;
 
@@ -136,6 +139,7 @@ void DragListener::endStir(Rml::Element* e) {
 }
 
 void DragListener::checkGrindingMotion() {
+	ECSRegistry& registry = m_ui_system->getWorld().registry;
 	// Check if pestle is within the mortar square
 	if (pestleCoords.back().first > INGREDIENT_RADIUS) {
 		return;
@@ -163,12 +167,12 @@ void DragListener::checkGrindingMotion() {
 	}
 
 	// Grind movement succeeded
-	if (PotionSystem::grindIngredient(m_ui_system->getOpenedMortarPestle())) {
+	if (PotionSystem::grindIngredient(registry, m_ui_system->getOpenedMortarPestle())) {
 		SoundSystem::playGrindSound((int)SOUND_CHANNEL::GENERAL, 0);
 	}
 }
 
-void createTempRenderRequestForItem(Entity item) {
+void createTempRenderRequestForItem(ECSRegistry& registry, Entity item) {
 	if (!registry.renderRequests.has(item)) {
 		if (!registry.items.has(item)) {
 			std::cerr << "Attempted to assign RenderRequest to a non-item entity!" << std::endl;
@@ -206,6 +210,8 @@ void createTempRenderRequestForItem(Entity item) {
 }
 
 void DragListener::ProcessEvent(Rml::Event& event) {
+	World& world = m_ui_system->getWorld();
+	ECSRegistry& registry = world.registry;
 	Rml::Element* cur = event.GetCurrentElement();
 	Rml::Vector2f mouseCoords = event.GetUnprojectedMouseScreenPos();
 	if (event == "dragstart") {
@@ -293,7 +299,7 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 		if (cur->GetId() == "heat") {
 			float curDegree = getCurrentDegree(cur);
 			int heatLevel = getHeatLevel(curDegree);
-			PotionSystem::changeHeat(m_ui_system->getOpenedCauldron(), heatLevel);
+			PotionSystem::changeHeat(registry, m_ui_system->getOpenedCauldron(), heatLevel);
 			is_heat_changing = false;
 			return;
 		}
@@ -335,8 +341,8 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 					if (slot < chestInv.items.size() && registry.items.has(chestInv.items[slot])) {
 						Entity item = chestInv.items[slot];
 						
-						if (ItemSystem::addItemToInventory(player, item)) {
-							ItemSystem::removeItemFromInventory(chest, item);
+						if (ItemSystem::addItemToInventory(world, player, item)) {
+							ItemSystem::removeItemFromInventory(world, chest, item);
 							SoundSystem::playInteractMenuSound((int)SOUND_CHANNEL::MENU, 0);
 						}
 					}
@@ -349,8 +355,8 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 				if (playerSlot < playerInv.items.size() && registry.items.has(playerInv.items[playerSlot])) {
 					Entity item = playerInv.items[playerSlot];
 					
-					if (ItemSystem::addItemToInventory(chest, item)) {
-						ItemSystem::removeItemFromInventory(player, item);
+					if (ItemSystem::addItemToInventory(world, chest, item)) {
+						ItemSystem::removeItemFromInventory(world, player, item);
 						SoundSystem::playInteractMenuSound((int)SOUND_CHANNEL::MENU, 0);
 					}
 				}
@@ -362,7 +368,7 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 		
 		// Regular inventory slot handling (outside chest UI)
 		if (slot != -1) {
-			ItemSystem::swapItems(player, slot, selected);
+			ItemSystem::swapItems(registry, player, slot, selected);
 			m_ui_system->updateInventoryBar();
 			return;
 		}
@@ -391,14 +397,14 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 			}
 
 			Item& invItem = registry.items.get(item);
-			Entity copy = ItemSystem::copyItem(item);
+			Entity copy = ItemSystem::copyItem(registry, item);
 			invItem.amount -= 1;
 			if (invItem.amount <= 0) {
-				ItemSystem::removeItemFromInventory(player, item);
+				ItemSystem::removeItemFromInventory(world, player, item);
 			}
 			registry.items.get(copy).amount = 1;
 			SoundSystem::playDropInCauldronSound((int)SOUND_CHANNEL::MENU, 0);
-			PotionSystem::addIngredient(m_ui_system->getOpenedCauldron(), copy);
+			PotionSystem::addIngredient(registry, m_ui_system->getOpenedCauldron(), copy);
 			if (m_ui_system) m_ui_system->updateInventoryBar();
 			return;
 		}
@@ -429,11 +435,11 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 				return;
 			}
 
-			Entity copy = ItemSystem::copyItem(item);
+			Entity copy = ItemSystem::copyItem(registry, item);
 			invItem.amount -= 1;
 			m_ui_system->updateInventoryBar();
 			if (invItem.amount <= 0) {
-				ItemSystem::removeItemFromInventory(player, item);
+				ItemSystem::removeItemFromInventory(world, player, item);
 			}
 			registry.items.get(copy).amount = 1;
 			std::cout << "Added ingredient: " << invItem.name << " to mortar" << std::endl;
@@ -444,9 +450,9 @@ void DragListener::ProcessEvent(Rml::Event& event) {
 				}
 			}
 
-			createTempRenderRequestForItem(copy);
+			createTempRenderRequestForItem(registry, copy);
 			SoundSystem::playDropInBowlSound((int)SOUND_CHANNEL::MENU, 0);
-			PotionSystem::storeIngredientInMortar(m_ui_system->getOpenedMortarPestle(), copy);
+			PotionSystem::storeIngredientInMortar(registry, m_ui_system->getOpenedMortarPestle(), copy);
 			return;
 		}
 	}
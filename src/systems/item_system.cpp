@@ -1,14 +1,14 @@
 #include "item_system.hpp"
 #include "ui_system.hpp"
 #include "world_init.hpp"
+#include "world.hpp"
 #include <iostream>
 #include <fstream>
 
-// initialize m_ui_system
-UISystem* ItemSystem::m_ui_system = nullptr;
+ItemSystem::ItemSystem(World& world) : world(world), registry(world.registry) {}
 
-Entity ItemSystem::createItem(ItemType type, int amount, bool isCollectable, bool is_ammo, bool canRespawn) {
-	Entity entity = Entity();
+Entity ItemSystem::createItem(ECSRegistry& registry, ItemType type, int amount, bool isCollectable, bool is_ammo, bool canRespawn) {
+	Entity entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " of type " << (int) type << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -26,8 +26,8 @@ Entity ItemSystem::createItem(ItemType type, int amount, bool isCollectable, boo
 	return entity;
 }
 
-Entity ItemSystem::createIngredient(ItemType type, int amount) {
-	Entity entity = createItem(type, amount, false, false);
+Entity ItemSystem::createIngredient(ECSRegistry& registry, ItemType type, int amount) {
+	Entity entity = createItem(registry, type, amount, false, false);
 
 	// Add ingredient-specific component
 	Ingredient& ingredient = registry.ingredients.emplace(entity);
@@ -35,9 +35,9 @@ Entity ItemSystem::createIngredient(ItemType type, int amount) {
 	return entity;
 }
 
-Entity ItemSystem::createPotion(PotionEffect effect, int duration, const vec3& color, float quality, float effectValue, int amount) {
+Entity ItemSystem::createPotion(ECSRegistry& registry, PotionEffect effect, int duration, const vec3& color, float quality, float effectValue, int amount) {
 	bool is_throwable = std::find(throwable_potions.begin(), throwable_potions.end(), effect) != throwable_potions.end();
-	Entity entity = createItem(ItemType::POTION, amount, false, is_throwable, false);
+	Entity entity = createItem(registry, ItemType::POTION, amount, false, is_throwable, false);
 
 	// Add potion-specific component
 	Potion& potion = registry.potions.emplace(entity);
@@ -51,7 +51,7 @@ Entity ItemSystem::createPotion(PotionEffect effect, int duration, const vec3& c
 	return entity;
 }
 
-std::string ItemSystem::getItemName(Entity item) {
+std::string ItemSystem::getItemName(ECSRegistry& registry, Entity item) {
 	Item& it = registry.items.get(item);
 	std::string name = ITEM_INFO.at(it.type).name;
 
@@ -87,8 +87,8 @@ std::string ItemSystem::getItemName(Entity item) {
 }
 
 
-Entity ItemSystem::createCollectableIngredient(vec2 position, ItemType type, int amount, bool canRespawn) {
-	Entity item = createItem(type, amount, true, false, canRespawn);
+Entity ItemSystem::createCollectableIngredient(ECSRegistry& registry, vec2 position, ItemType type, int amount, bool canRespawn) {
+	Entity item = createItem(registry, type, amount, true, false, canRespawn);
 	registry.items.get(item).originalPosition = position;
 	Ingredient& ing = registry.ingredients.emplace(item);
 	ing.grindLevel = ITEM_INFO.at(type).grindable ? 0.f : -1.f;
@@ -102,16 +102,17 @@ void ItemSystem::step(float elapsed_ms) {
 }
 
 Entity ItemSystem::createItemEntity(ItemType type, int amount) {
-	return createItem(type, amount, false, false);
+	return createItem(registry, type, amount, false, false);
 }
 
-void ItemSystem::destroyItem(Entity item) {
+void ItemSystem::destroyItem(ECSRegistry& registry, Entity item) {
 	if (registry.items.has(item)) {
 		registry.remove_all_components_of(item);
 	}
 }
 
-bool ItemSystem::addItemToInventory(Entity inventory, Entity item) {
+bool ItemSystem::addItemToInventory(World& world, Entity inventory, Entity item) {
+	ECSRegistry& registry = world.registry;
 	if (!registry.inventories.has(inventory) || !registry.items.has(item)) {
 		return false;
 	}
@@ -167,13 +168,13 @@ bool ItemSystem::addItemToInventory(Entity inventory, Entity item) {
 
 		// Don't destroy the original item if it's a collectable (it will respawn)
 		if (!item_comp.isCollectable) {
-			destroyItem(item);
+			destroyItem(registry, item);
 		}
 
 		// update bar if inventory belongs to player
-		if (registry.players.has(inventory) && m_ui_system != nullptr) {
-			m_ui_system->updateInventoryBar();
-			m_ui_system->updatePotionInfo();
+		if (registry.players.has(inventory) && world.ui != nullptr) {
+			world.ui->updateInventoryBar();
+			world.ui->updatePotionInfo();
 		}
 
 		return true;
@@ -186,7 +187,7 @@ bool ItemSystem::addItemToInventory(Entity inventory, Entity item) {
 
 	// If item is collectable, create a copy for the inventory
 	if (item_comp.isCollectable) {
-		Entity copy = copyItem(item);
+		Entity copy = copyItem(registry, item);
 		inv.items.push_back(copy);
 	}
 	else {
@@ -200,14 +201,15 @@ bool ItemSystem::addItemToInventory(Entity inventory, Entity item) {
 	//std::cout << "Added new item: " << item_comp.name << " to inventory." << std::endl;
 
 	// update bar if inventory belongs to player
-	if (registry.players.has(inventory) && m_ui_system != nullptr) {
-		m_ui_system->updateInventoryBar();
+	if (registry.players.has(inventory) && world.ui != nullptr) {
+		world.ui->updateInventoryBar();
 	}
 
 	return true;
 }
 
-bool ItemSystem::removeItemFromInventory(Entity inventory, Entity item) {
+bool ItemSystem::removeItemFromInventory(World& world, Entity inventory, Entity item) {
+	ECSRegistry& registry = world.registry;
 	if (!registry.inventories.has(inventory)) {
 		return false;
 	}
@@ -219,9 +221,9 @@ bool ItemSystem::removeItemFromInventory(Entity inventory, Entity item) {
 		inv.items.erase(it);
 		inv.isFull = false;
 		// update bar if inventory belongs to player
-		if (registry.players.has(inventory) && m_ui_system != nullptr) {
-			m_ui_system->updateInventoryBar();
-			m_ui_system->updatePotionInfo();
+		if (registry.players.has(inventory) && world.ui != nullptr) {
+			world.ui->updateInventoryBar();
+			world.ui->updatePotionInfo();
 		}
 		return true;
 	}
@@ -230,17 +232,17 @@ bool ItemSystem::removeItemFromInventory(Entity inventory, Entity item) {
 }
 
 bool ItemSystem::transferItem(Entity source_inventory, Entity target_inventory, Entity item) {
-	if (removeItemFromInventory(source_inventory, item)) {
-		if (addItemToInventory(target_inventory, item)) {
+	if (removeItemFromInventory(world, source_inventory, item)) {
+		if (addItemToInventory(world, target_inventory, item)) {
 			return true;
 		}
 		// If adding to target failed, put it back in source
-		addItemToInventory(source_inventory, item);
+		addItemToInventory(world, source_inventory, item);
 	}
 	return false;
 }
 
-void ItemSystem::swapItems(Entity inventory, int slot1, int slot2) {
+void ItemSystem::swapItems(ECSRegistry& registry, Entity inventory, int slot1, int slot2) {
 	std::vector<Entity>& items = registry.inventories.get(inventory).items;
 	if (items.size() <= slot1 || items.size() <= slot2) {
 		return;
@@ -249,8 +251,8 @@ void ItemSystem::swapItems(Entity inventory, int slot1, int slot2) {
 	registry.inventories.get(inventory).selection = slot1;
 }
 
-Entity ItemSystem::copyItem(Entity toCopy) {
-	Entity res = Entity();
+Entity ItemSystem::copyItem(ECSRegistry& registry, Entity toCopy) {
+	Entity res = registry.create();
 	auto& oldItem = registry.items.get(toCopy);
 
 	Item& newItem = registry.items.emplace(res);
@@ -283,19 +285,16 @@ Entity ItemSystem::copyItem(Entity toCopy) {
 		newPot.color = oldPot.color;
 	}
 	if (registry.ammo.has(toCopy)) {
-		auto& oldAmmo = registry.ammo.get(toCopy);
+		Ammo oldAmmo = registry.ammo.get(toCopy); // a copy, the emplace below may move the dense ammo array
 		// registry.ammo.emplace(res, Ammo(oldAmmo));
 		Ammo& newAmmo = registry.ammo.emplace(res);
-		newAmmo.start_pos = oldAmmo.start_pos;
-		newAmmo.target = oldAmmo.target;
 		newAmmo.is_fired = oldAmmo.is_fired;
-		newAmmo.damage = oldAmmo.damage;
 	}
 	return res;
 }
 
 // Serialization
-nlohmann::json ItemSystem::serializeItem(Entity item) {
+nlohmann::json ItemSystem::serializeItem(ECSRegistry& registry, Entity item) {
 	nlohmann::json data;
 
 	if (!registry.items.has(item)) {
@@ -333,7 +332,7 @@ nlohmann::json ItemSystem::serializeItem(Entity item) {
 	return data;
 }
 
-nlohmann::json ItemSystem::serializeInventory(Entity inventory) {
+nlohmann::json ItemSystem::serializeInventory(ECSRegistry& registry, Entity inventory) {
 	nlohmann::json data;
 
 	if (!registry.inventories.has(inventory)) {
@@ -361,7 +360,7 @@ nlohmann::json ItemSystem::serializeInventory(Entity inventory) {
 	nlohmann::json items_data = nlohmann::json::array();
 	for (Entity item : inv.items) {
 		if (registry.items.has(item)) {
-			items_data.push_back(serializeItem(item));
+			items_data.push_back(serializeItem(registry, item));
 		}
 	}
 	data["items"] = items_data;
@@ -369,7 +368,7 @@ nlohmann::json ItemSystem::serializeInventory(Entity inventory) {
 	return data;
 }
 
-nlohmann::json ItemSystem::serializeScreenState() {
+nlohmann::json ItemSystem::serializeScreenState(ECSRegistry& registry) {
 	ScreenState& screen = registry.screenStates.components[0];
 
 	nlohmann::json data;
@@ -384,7 +383,7 @@ nlohmann::json ItemSystem::serializeScreenState() {
 }
 
 // serializes all player attributes except for inventory
-nlohmann::json ItemSystem::serializePlayerState(Entity player) {
+nlohmann::json ItemSystem::serializePlayerState(ECSRegistry& registry, Entity player) {
 	nlohmann::json data;
 
 	if (registry.players.has(player)) {
@@ -401,7 +400,7 @@ nlohmann::json ItemSystem::serializePlayerState(Entity player) {
 		for (Entity effect : player_comp.active_effects) {
 			// Ensure the effect entity exists and has item/potion components before serializing
 			if (registry.items.has(effect) && registry.potions.has(effect)) {
-				active_effects.push_back(serializeItem(effect));
+				active_effects.push_back(serializeItem(registry, effect));
 			}
 		}
 		data["active_effects"] = active_effects;
@@ -416,12 +415,12 @@ nlohmann::json ItemSystem::serializePlayerState(Entity player) {
 	return data;
 }
 
-Entity ItemSystem::deserializeItem(const nlohmann::json& data) {
-	Entity entity;
+Entity ItemSystem::deserializeItem(ECSRegistry& registry, const nlohmann::json& data) {
+	Entity entity = Entity::null();
 
 	std::string type = data.value("type", "basic");
 	if (type == "ingredient") {
-		entity = createIngredient(data["type_id"], data["amount"]);
+		entity = createIngredient(registry, data["type_id"], data["amount"]);
 		if (registry.ingredients.has(entity)) {
 			Ingredient& ing = registry.ingredients.get(entity);
 			auto& ing_data = data["ingredient"];
@@ -430,7 +429,7 @@ Entity ItemSystem::deserializeItem(const nlohmann::json& data) {
 	}
 	else if (type == "potion") {
 		auto& pot_data = data["potion"];
-		entity = createPotion(
+		entity = createPotion(registry,
 			pot_data["effect"],
 			pot_data["duration"],
 			vec3(pot_data["color"][0], pot_data["color"][1], pot_data["color"][2]),
@@ -440,13 +439,13 @@ Entity ItemSystem::deserializeItem(const nlohmann::json& data) {
 		);
 	}
 	else {
-		entity = createItem(data["type_id"], data["amount"], false, data["is_ammo"]);
+		entity = createItem(registry, data["type_id"], data["amount"], false, data["is_ammo"]);
 	}
 
 	return entity;
 }
 
-void ItemSystem::deserializeInventory(Entity inventory, const nlohmann::json& data) {
+void ItemSystem::deserializeInventory(ECSRegistry& registry, Entity inventory, const nlohmann::json& data) {
 	if (!registry.inventories.has(inventory)) {
 		// std::cout << "Entity " << inventory.id() << " deserialize inventory" << std::endl;
 		registry.inventories.emplace(inventory);
@@ -466,20 +465,20 @@ void ItemSystem::deserializeInventory(Entity inventory, const nlohmann::json& da
 
 	// Clear existing items
 	for (Entity item : inv.items) {
-		destroyItem(item);
+		destroyItem(registry, item);
 	}
 	inv.items.clear();
 
 	// Load new items
 	for (const auto& item_data : data["items"]) {
-		Entity item = deserializeItem(item_data);
+		Entity item = deserializeItem(registry, item_data);
 		if (registry.items.has(item)) {
 			inv.items.push_back(item);
 		}
 	}
 }
 
-void ItemSystem::deserializePlayerState(Entity player_entity, const nlohmann::json& data) {
+void ItemSystem::deserializePlayerState(ECSRegistry& registry, Entity player_entity, const nlohmann::json& data) {
 	if (!registry.players.has(player_entity)) return;
 	
 	Player& player = registry.players.get(player_entity);
@@ -494,13 +493,14 @@ void ItemSystem::deserializePlayerState(Entity player_entity, const nlohmann::js
 	player.active_effects.clear();
 	
 	for (const auto& effect : data["active_effects"]) {
-		player.active_effects.push_back(deserializeItem(effect));
+		player.active_effects.push_back(deserializeItem(registry, effect));
 	}
 
 	registry.players.get(player_entity).load_position = vec2(data["load_position_x"], data["load_position_y"]);
 }
 
-bool ItemSystem::saveGameState() {
+bool ItemSystem::saveGameState(World& world) {
+	ECSRegistry& registry = world.registry;
 	std::cout << "Saving game state..." << std::endl;
 	
 	nlohmann::json data;
@@ -510,14 +510,14 @@ bool ItemSystem::saveGameState() {
 	if (!registry.cauldrons.entities.empty()) {
 		Entity cauldron = registry.cauldrons.entities[0];
 		if (registry.inventories.has(cauldron)) {
-			inventories.push_back(serializeInventory(cauldron));
+			inventories.push_back(serializeInventory(registry, cauldron));
 		}
 	}
 	
 	if (!registry.players.entities.empty()) {
 		Entity player = registry.players.entities[0];
 		if (registry.inventories.has(player)) {
-			inventories.push_back(serializeInventory(player));
+			inventories.push_back(serializeInventory(registry, player));
 		}
 	}
 	
@@ -525,23 +525,23 @@ bool ItemSystem::saveGameState() {
 	if (!registry.chests.entities.empty()) {
 		Entity chest = registry.chests.entities[0];
 		if (registry.inventories.has(chest)) {
-			inventories.push_back(serializeInventory(chest));
+			inventories.push_back(serializeInventory(registry, chest));
 		}
 	}
 	
 	data["inventories"] = inventories;
-	data["screen_state"] = serializeScreenState();
+	data["screen_state"] = serializeScreenState(registry);
 	
-	if (UISystem::s_instance != nullptr) {
-		data["recipe_book_index"] = UISystem::s_instance->current_recipe_index;
+	if (world.ui != nullptr) {
+		data["recipe_book_index"] = world.ui->current_recipe_index;
 	}
 	
 	if (registry.players.size() > 0) {
-		data["player_state"] = serializePlayerState(registry.players.entities[0]);
+		data["player_state"] = serializePlayerState(registry, registry.players.entities[0]);
 	}
 	
 	// Save respawn system state (items, enemies)
-	data["respawn_states"] = RespawnSystem::getInstance().serialize();
+	data["respawn_states"] = world.respawns.serialize();
 
 	try {
 		std::string save_path = game_state_path(GAME_STATE_FILE);
@@ -556,18 +556,19 @@ bool ItemSystem::saveGameState() {
 	}
 }
 
-bool ItemSystem::loadGameState() {
-	nlohmann::json data = loadCoreState();
+bool ItemSystem::loadGameState(World& world) {
+	nlohmann::json data = loadCoreState(world);
 	
 	if (!data.is_null()) {
-		loadInventoryState(data);
+		loadInventoryState(world.registry, data);
 		return true;
 	}
 	
 	return false;
 }
 
-nlohmann::json ItemSystem::loadCoreState() {
+nlohmann::json ItemSystem::loadCoreState(World& world) {
+	ECSRegistry& registry = world.registry;
 	try {
 		std::string save_path = game_state_path(GAME_STATE_FILE);
 		std::ifstream file(save_path);
@@ -578,23 +579,23 @@ nlohmann::json ItemSystem::loadCoreState() {
 		nlohmann::json data;
 		file >> data;
 
-		Entity player;
+		Entity player = Entity::null();
 		if (!registry.players.entities.empty()) {
 			player = registry.players.entities[0];
 		}
 
-		deserializeScreenState(data["screen_state"]);
+		deserializeScreenState(registry, data["screen_state"]);
 		
-		if (data.contains("recipe_book_index") && UISystem::s_instance != nullptr) {
-			UISystem::s_instance->current_recipe_index = data["recipe_book_index"];
+		if (data.contains("recipe_book_index") && world.ui != nullptr) {
+			world.ui->current_recipe_index = data["recipe_book_index"];
 		}
 		
 		if (data.contains("player_state") && !registry.players.entities.empty()) {
-			deserializePlayerState(registry.players.entities[0], data["player_state"]);
+			deserializePlayerState(registry, registry.players.entities[0], data["player_state"]);
 		}
 		
 		if (data.contains("respawn_states")) {
-			RespawnSystem::getInstance().deserialize(data["respawn_states"]);
+			world.respawns.deserialize(data["respawn_states"]);
 		}
 
 		// Only load player inventory now (not chest or cauldron)
@@ -602,7 +603,7 @@ nlohmann::json ItemSystem::loadCoreState() {
 			for (const auto& inv_data : data["inventories"]) {
 				std::string owner_type = inv_data["owner_type"];
 				if (owner_type == "player") {
-					deserializeInventory(player, inv_data);
+					deserializeInventory(registry, player, inv_data);
 				}
 			}
 		}
@@ -615,7 +616,7 @@ nlohmann::json ItemSystem::loadCoreState() {
 	}
 }
 
-void ItemSystem::loadInventoryState(const nlohmann::json& data) {
+void ItemSystem::loadInventoryState(ECSRegistry& registry, const nlohmann::json& data) {
 	if (data.is_null() || !data.contains("inventories")) {
 		return;
 	}
@@ -628,14 +629,14 @@ void ItemSystem::loadInventoryState(const nlohmann::json& data) {
 
 			if (owner_type == "cauldron") {
 				if (!registry.cauldrons.entities.empty()) {
-					deserializeInventory(registry.cauldrons.entities[0], inv_data);
+					deserializeInventory(registry, registry.cauldrons.entities[0], inv_data);
 				}
 			}
 			else if (owner_type == "chest") {
 				// Always use the first chest entity to maintain consistency with saveGameState
 				if (!registry.chests.entities.empty()) {
 					std::cout << "Loading chest inventory data into first chest entity" << std::endl;
-					deserializeInventory(registry.chests.entities[0], inv_data);
+					deserializeInventory(registry, registry.chests.entities[0], inv_data);
 				}
 				else {
 					std::cout << "Warning: Chest inventory found in save data but no chest entity exists to load it into" << std::endl;
@@ -648,7 +649,7 @@ void ItemSystem::loadInventoryState(const nlohmann::json& data) {
 	}
 }
 
-void ItemSystem::deserializeScreenState(const nlohmann::json& data) {
+void ItemSystem::deserializeScreenState(ECSRegistry& registry, const nlohmann::json& data) {
 	ScreenState& screen = registry.screenStates.components[0];
 
 	screen.tutorial_state = data["tutorial_state"];
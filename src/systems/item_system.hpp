@@ -11,55 +11,54 @@
 #include "respawn_system.hpp"
 #include "ui_system.hpp"
 
+struct World;
+
 // Main system for managing items and inventories
 class ItemSystem {
 public:
-	ItemSystem() {}
+	explicit ItemSystem(World& world);
 	
 	void step(float elapsed_ms);
 	
 	// Item management
 	Entity createItemEntity(ItemType type, int amount = 1);
-	static void destroyItem(Entity item);
+	static void destroyItem(ECSRegistry& registry, Entity item);
 	
 	// Inventory management
-	static bool addItemToInventory(Entity inventory, Entity item);
-	static bool removeItemFromInventory(Entity inventory, Entity item);
+	static bool addItemToInventory(World& world, Entity inventory, Entity item);
+	static bool removeItemFromInventory(World& world, Entity inventory, Entity item);
 	bool transferItem(Entity source_inventory, Entity target_inventory, Entity item);
-	static void swapItems(Entity inventory, int slot1, int slot2);
+	static void swapItems(ECSRegistry& registry, Entity inventory, int slot1, int slot2);
 
 	// Creates an exact copy of an item thats stored in a new entity
-	static Entity copyItem(Entity toCopy);
+	static Entity copyItem(ECSRegistry& registry, Entity toCopy);
 	
 	// Serialization
-	static bool saveGameState();
-	static bool loadGameState();
+	static bool saveGameState(World& world);
+	static bool loadGameState(World& world);
 	
 	// Item factory methods
-	static Entity createItem(ItemType type, int amount = 1, bool isCollectable = false, bool is_ammo = false, bool canRespawn = true);
-	static Entity createIngredient(ItemType type, int amount = 1);
-	static Entity createPotion(PotionEffect effect, int duration, const vec3& color, float quality, float effectValue, int amount);
-	static Entity createCollectableIngredient(vec2 position, ItemType type, int amount, bool canRespawn = true);
-	static std::string getItemName(Entity item);
+	static Entity createItem(ECSRegistry& registry, ItemType type, int amount = 1, bool isCollectable = false, bool is_ammo = false, bool canRespawn = true);
+	static Entity createIngredient(ECSRegistry& registry, ItemType type, int amount = 1);
+	static Entity createPotion(ECSRegistry& registry, PotionEffect effect, int duration, const vec3& color, float quality, float effectValue, int amount);
+	static Entity createCollectableIngredient(ECSRegistry& registry, vec2 position, ItemType type, int amount, bool canRespawn = true);
+	static std::string getItemName(ECSRegistry& registry, Entity item);
 	
 	// Serialization helpers made public and static
-	static nlohmann::json serializeItem(Entity item);
-	static nlohmann::json serializeInventory(Entity inventory);
-	static nlohmann::json serializeScreenState();
-	static nlohmann::json serializePlayerState(Entity player_entity);
-	static Entity deserializeItem(const nlohmann::json& data);
-	static void deserializeInventory(Entity inventory, const nlohmann::json& data);
-	static void deserializeScreenState(const nlohmann::json& data);
-	static void deserializePlayerState(Entity player_entity, const nlohmann::json& data);
-
-	// Set reference to UI system
-	static void setUISystem(UISystem* ui_system) { m_ui_system = ui_system; }
+	static nlohmann::json serializeItem(ECSRegistry& registry, Entity item);
+	static nlohmann::json serializeInventory(ECSRegistry& registry, Entity inventory);
+	static nlohmann::json serializeScreenState(ECSRegistry& registry);
+	static nlohmann::json serializePlayerState(ECSRegistry& registry, Entity player_entity);
+	static Entity deserializeItem(ECSRegistry& registry, const nlohmann::json& data);
+	static void deserializeInventory(ECSRegistry& registry, Entity inventory, const nlohmann::json& data);
+	static void deserializeScreenState(ECSRegistry& registry, const nlohmann::json& data);
+	static void deserializePlayerState(ECSRegistry& registry, Entity player_entity, const nlohmann::json& data);
 
 	// Split loading into two phases to handle biome initialization timing for the CHEST :(
-	static nlohmann::json loadCoreState(); // Load screen state & other core data, returns the parsed JSON
-	static void loadInventoryState(const nlohmann::json& data); // Load inventory data after biomes initialized
+	static nlohmann::json loadCoreState(World& world); // Load screen state & other core data, returns the parsed JSON
+	static void loadInventoryState(ECSRegistry& registry, const nlohmann::json& data); // Load inventory data after biomes initialized
 
 private:
-	// Pointer to the UI system for passing input events
-	static UISystem* m_ui_system;
+	World& world;
+	ECSRegistry& registry;
 }; 
\ No newline at end of file
@@ -0,0 +1,142 @@
+// internal
+#include "mesh_collider.hpp"
+#include "physics_system.hpp"
+
+// this function checks if a point is inside a triangle using the barycentric coordinates (raycasting thing)
+bool isPointInTriangle(const vec2& p, const vec2& v1, const vec2& v2, const vec2& v3) {
+	// vectors and dot products
+	vec2 v0 = v3 - v1;
+	vec2 v1v = v2 - v1;
+	vec2 v2v = p - v1;
+
+	float dot00 = dot(v0, v0);
+	float dot01 = dot(v0, v1v);
+	float dot02 = dot(v0, v2v);
+	float dot11 = dot(v1v, v1v);
+	float dot12 = dot(v1v, v2v);
+
+	// Using barycentric coordinates
+	float invDenom = 1.0f / (dot00 * dot11 - dot01 * dot01);
+	float u = (dot11 * dot02 - dot01 * dot12) * invDenom;
+	float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
+
+	// check if the point is in triangle
+	return (u >= 0) && (v >= 0) && (u + v <= 1);
+}
+
+// checks if a line segment intersects with another line segment
+bool doLinesIntersect(const vec2& p1, const vec2& p2, const vec2& p3, const vec2& p4) {
+	vec2 r = p2 - p1;
+	vec2 s = p4 - p3;
+
+	float rxs = r.x * s.y - r.y * s.x;
+
+	// this calculates the cross product, if 0 then the lines are parallel or collinear (NOT INTERSECTING)
+	if (fabs(rxs) < 1e-6f) {
+		return false;
+	}
+
+	// calculate the parameters for the intersection point
+	vec2 qp = p3 - p1;
+	float t = (qp.x * s.y - qp.y * s.x) / rxs;
+	float u = (qp.x * r.y - qp.y * r.x) / rxs;
+
+	// check if the intersection point is within both line segments
+	return (t >= 0 && t <= 1 && u >= 0 && u <= 1);
+}
+
+bool triangleBoxOverlap(const vec2& v1, const vec2& v2, const vec2& v3, const vec4& box) {
+	vec2 box_tl = { box.x, box.y };
+	vec2 box_tr = { box.x + box.z, box.y };
+	vec2 box_bl = { box.x, box.y + box.w };
+	vec2 box_br = { box.x + box.z, box.y + box.w };
+
+	// is any box corner is inside the triangle
+	if (isPointInTriangle(box_tl, v1, v2, v3) ||
+		isPointInTriangle(box_tr, v1, v2, v3) ||
+		isPointInTriangle(box_bl, v1, v2, v3) ||
+		isPointInTriangle(box_br, v1, v2, v3)) {
+		return true;
+	}
+
+	// is any triangle vertex is inside the box
+	if ((v1.x >= box.x && v1.x <= box.x + box.z && v1.y >= box.y && v1.y <= box.y + box.w) ||
+		(v2.x >= box.x && v2.x <= box.x + box.z && v2.y >= box.y && v2.y <= box.y + box.w) ||
+		(v3.x >= box.x && v3.x <= box.x + box.z && v3.y >= box.y && v3.y <= box.y + box.w)) {
+		return true;
+	}
+
+	// is a triangle edge intersecting with any box edge
+	// Triangle edges
+	if (doLinesIntersect(v1, v2, box_tl, box_tr) ||
+		doLinesIntersect(v1, v2, box_tr, box_br) ||
+		doLinesIntersect(v1, v2, box_br, box_bl) ||
+		doLinesIntersect(v1, v2, box_bl, box_tl) ||
+		doLinesIntersect(v2, v3, box_tl, box_tr) ||
+		doLinesIntersect(v2, v3, box_tr, box_br) ||
+		doLinesIntersect(v2, v3, box_br, box_bl) ||
+		doLinesIntersect(v2, v3, box_bl, box_tl) ||
+		doLinesIntersect(v3, v1, box_tl, box_tr) ||
+		doLinesIntersect(v3, v1, box_tr, box_br) ||
+		doLinesIntersect(v3, v1, box_br, box_bl) ||
+		doLinesIntersect(v3, v1, box_bl, box_tl)) {
+		return true;
+	}
+
+	return false;
+}
+
+void MeshCollider::build(const Mesh& mesh, const Motion& motion)
+{
+	this->mesh = &mesh;
+	position = motion.position;
+	angle = motion.angle;
+	scale = motion.scale;
+
+	FrameVector<vec2> transformed_vertices = PhysicsSystem::get_transformed_vertices(mesh, motion);
+
+	// Each triangle is made of three entries of vertex_indices
+	// ex. 30 vertices and 84 vertex indices, indices 0, 1, 2 are for triangle one, 3, 4, 5 for next triangle and so on
+	corners.clear();
+	triangles.clear();
+	size_t triangle_count = mesh.vertex_indices.size() / 3;
+	for (size_t i = 0; i < triangle_count; i++)
+	{
+		vec2 p1 = transformed_vertices[mesh.vertex_indices[3 * i]];
+		vec2 p2 = transformed_vertices[mesh.vertex_indices[3 * i + 1]];
+		vec2 p3 = transformed_vertices[mesh.vertex_indices[3 * i + 2]];
+		corners.push_back(p1);
+		corners.push_back(p2);
+		corners.push_back(p3);
+
+		vec2 low = glm::min(p1, glm::min(p2, p3));
+		vec2 high = glm::max(p1, glm::max(p2, p3));
+		triangles.add((unsigned int)i, { low.x, low.y, high.x - low.x, high.y - low.y });
+	}
+	triangles.build();
+
+	vec2 low = transformed_vertices.empty() ? position : transformed_vertices[0];
+	vec2 high = low;
+	for (vec2 vertex : transformed_vertices)
+	{
+		low = glm::min(low, vertex);
+		high = glm::max(high, vertex);
+	}
+	box = { low.x, low.y, high.x - low.x, high.y - low.y };
+}
+
+bool MeshCollider::built_for(const Mesh& mesh, const Motion& motion) const
+{
+	return this->mesh == &mesh && position == motion.position && angle == motion.angle && scale == motion.scale;
+}
+
+bool MeshCollider::overlaps(const vec4& box) const
+{
+	// the bounds of a triangle touch every box the triangle does, only those get the full test
+	bool overlap = false;
+	triangles.query(box, [&](unsigned int i) {
+		if (!overlap && triangleBoxOverlap(corners[3 * i], corners[3 * i + 1], corners[3 * i + 2], box))
+			overlap = true;
+	});
+	return overlap;
+}
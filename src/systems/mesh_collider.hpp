@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "common.hpp"
+#include "tinyECS/components.hpp"
+#include "aabb_tree.hpp"
+
+// True if box (x, y, width, height) overlaps the triangle v1 v2 v3, touching counts
+bool triangleBoxOverlap(const vec2& v1, const vec2& v2, const vec2& v3, const vec4& box);
+
+// A collision mesh transformed into world space, with the bounds of every triangle in an AABBTree.
+// A box is only put through the exact triangle test against the triangles whose bounds it touches.
+// The collider remembers the Mesh and the position, angle and scale it was built for, so its owner
+// can keep it until the entity is moved.
+class MeshCollider
+{
+public:
+	void build(const Mesh& mesh, const Motion& motion);
+	bool built_for(const Mesh& mesh, const Motion& motion) const;
+
+	// True if box (x, y, width, height) overlaps any triangle, touching counts
+	bool overlaps(const vec4& box) const;
+
+	// The box around all of the mesh's vertices
+	vec4 bounds() const { return box; }
+
+private:
+	const Mesh* mesh = nullptr;
+	vec2 position = { 0, 0 };
+	float angle = 0;
+	vec2 scale = { 0, 0 };
+
+	std::vector<vec2> corners; // three per triangle, in the order of the mesh's vertex_indices
+	AABBTree triangles;        // triangle i is corners[3 * i] to corners[3 * i + 2]
+	vec4 box = { 0, 0, 0, 0 };
+};
@@ -0,0 +1,124 @@
+// internal
+#include "motion_system.hpp"
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define MOTION_SIMD_X86 1
+#endif
+
+void MotionSoA::reset(size_t n)
+{
+	count = 0;
+	size_t padded = (n + LANES - 1) / LANES * LANES;
+	if (x.size() >= padded)
+		return;
+	for (FloatArray* array : { &x, &y, &vx, &vy, &previous_x, &previous_y, &dt })
+		array->resize(padded);
+	motions.resize(padded);
+}
+
+void MotionSoA::add(Motion& motion, float entity_dt)
+{
+	assert(count < x.size() && "MotionSoA::reset was given too few entries");
+	x[count] = motion.position.x;
+	y[count] = motion.position.y;
+	vx[count] = motion.velocity.x;
+	vy[count] = motion.velocity.y;
+	dt[count] = entity_dt;
+	motions[count] = &motion;
+	count++;
+}
+
+void MotionSoA::pad()
+{
+	for (size_t i = count; i < padded_size(); i++)
+		x[i] = y[i] = vx[i] = vy[i] = dt[i] = 0.f;
+}
+
+void MotionSoA::scatter() const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		Motion& motion = *motions[i];
+		motion.previous_position = { previous_x[i], previous_y[i] };
+		motion.position = { x[i], y[i] };
+	}
+}
+
+void MotionSystem::integrate(MotionSoA& soa)
+{
+	float* x = soa.x.data();
+	float* y = soa.y.data();
+	const float* vx = soa.vx.data();
+	const float* vy = soa.vy.data();
+	float* px = soa.previous_x.data();
+	float* py = soa.previous_y.data();
+	const float* dt = soa.dt.data();
+	size_t n = soa.padded_size();
+
+#if defined(__AVX__)
+	for (size_t i = 0; i < n; i += 8)
+	{
+		__m256 pos_x = _mm256_load_ps(x + i);
+		__m256 pos_y = _mm256_load_ps(y + i);
+		__m256 step = _mm256_load_ps(dt + i);
+		_mm256_store_ps(px + i, pos_x);
+		_mm256_store_ps(py + i, pos_y);
+		_mm256_store_ps(x + i, _mm256_add_ps(pos_x, _mm256_mul_ps(_mm256_load_ps(vx + i), step)));
+		_mm256_store_ps(y + i, _mm256_add_ps(pos_y, _mm256_mul_ps(_mm256_load_ps(vy + i), step)));
+	}
+#elif defined(MOTION_SIMD_X86)
+	for (size_t i = 0; i < n; i += 4)
+	{
+		__m128 pos_x = _mm_load_ps(x + i);
+		__m128 pos_y = _mm_load_ps(y + i);
+		__m128 step = _mm_load_ps(dt + i);
+		_mm_store_ps(px + i, pos_x);
+		_mm_store_ps(py + i, pos_y);
+		_mm_store_ps(x + i, _mm_add_ps(pos_x, _mm_mul_ps(_mm_load_ps(vx + i), step)));
+		_mm_store_ps(y + i, _mm_add_ps(pos_y, _mm_mul_ps(_mm_load_ps(vy + i), step)));
+	}
+#else
+	for (size_t i = 0; i < n; i++)
+	{
+		px[i] = x[i];
+		py[i] = y[i];
+		x[i] += vx[i] * dt[i];
+		y[i] += vy[i] * dt[i];
+	}
+#endif
+}
+
+// Motion is stored as an array of structs, so by default the game loop integrates in place: copying
+// the few moving entities into a MotionSoA and back costs more than the vector kernel saves.
+static void advance(Motion& motion, float dt)
+{
+	motion.previous_position = motion.position;
+	motion.position += motion.velocity * dt;
+}
+
+void MotionSystem::step(float elapsed_ms)
+{
+	if (registry.screenStates.components[0].is_switching_biome) return;
+
+	float walk_dt = elapsed_ms * TIME_UPDATE_FACTOR;
+	if (use_soa)
+	{
+		soa.reset(registry.players.size() + registry.guardians.size());
+		for (auto [entity, player, motion] : registry.view<Player, Motion>())
+			soa.add(motion, walk_dt);
+		for (auto [entity, guardian, motion] : registry.view<Guardian, Motion>())
+			if (motion.velocity != vec2(0, 0))
+				soa.add(motion, walk_dt);
+		soa.pad();
+		integrate(soa);
+		soa.scatter();
+		return;
+	}
+
+	for (auto [entity, player, motion] : registry.view<Player, Motion>())
+		advance(motion, walk_dt);
+	for (auto [entity, guardian, motion] : registry.view<Guardian, Motion>())
+		if (motion.velocity != vec2(0, 0))
+			advance(motion, walk_dt);
+}
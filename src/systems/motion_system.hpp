@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <new>
+
+#include "common.hpp"
+#include "tinyECS/registry.hpp"
+
+// Allocator for the SoA arrays, aligned so the integration kernel can use aligned vector loads
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+	using value_type = T;
+	template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+	AlignedAllocator() = default;
+	template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+	T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment))); }
+	void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+	template <typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+	template <typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Struct-of-arrays layout of the Motion fields the integration touches: one float array per coordinate,
+// for batches of moving objects that are kept in SoA form and advanced with MotionSystem::integrate().
+// Arrays are 32-byte aligned and padded to a multiple of LANES with zeros, so the kernel never needs a
+// scalar tail loop. Entry i belongs to motions[i].
+// The arrays only ever grow, so refilling them every frame does not allocate or clear memory.
+struct MotionSoA
+{
+	static constexpr size_t LANES = 8; // floats per AVX register
+	using FloatArray = std::vector<float, AlignedAllocator<float, 32>>;
+
+	FloatArray x, y;                   // position
+	FloatArray vx, vy;                 // velocity
+	FloatArray previous_x, previous_y; // position before the last integration
+	FloatArray dt;                     // per entity time step, so entities with different time factors share a pass
+	std::vector<Motion*> motions;      // where each entry was gathered from and is written back to
+
+	size_t size() const { return count; }
+	size_t padded_size() const { return (count + LANES - 1) / LANES * LANES; }
+
+	// Makes room for n entries and empties the arrays, the entries are then filled with add()
+	void reset(size_t n);
+	// Copies motion in as the next entry, reset() must have made room for it
+	void add(Motion& motion, float entity_dt);
+	// Zero-fills the arrays up to padded_size()
+	void pad();
+	// Copies position and previous_position back into the gathered motions
+	void scatter() const;
+
+private:
+	size_t count = 0;
+};
+
+// Advances every moving entity by its velocity and records previous_position in the same pass.
+// Moving entities are the player and guardians; enemies move through the AISystem and thrown ammo
+// through the ProjectileSystem.
+class MotionSystem
+{
+public:
+	explicit MotionSystem(ECSRegistry& registry) : registry(registry) {}
+
+	void step(float elapsed_ms);
+
+	// position += velocity * dt and previous_position = old position for every (padded) entry of soa.
+	// Uses AVX when the build enables it, SSE otherwise and plain floats on non-x86 targets.
+	static void integrate(MotionSoA& soa);
+
+	// Gather the moving entities into a MotionSoA and advance them with integrate() instead of in place.
+	// Off by default, it only pays off with many moving entities (compare BM_MotionIntegrate and
+	// BM_MotionScalar).
+	bool use_soa = false;
+
+private:
+	ECSRegistry& registry;
+	MotionSoA soa;
+};
@@ -0,0 +1,42 @@
+// internal
+#include "occupancy_grid.hpp"
+
+void OccupancyGrid::reset(vec4 area, float cell_size)
+{
+	origin = { area.x, area.y };
+	cell = std::max({ cell_size, area.z / MAX_CELLS_PER_AXIS, area.w / MAX_CELLS_PER_AXIS });
+	columns = std::min((int)(area.z / cell) + 1, MAX_CELLS_PER_AXIS);
+	rows = std::min((int)(area.w / cell) + 1, MAX_CELLS_PER_AXIS);
+	words_per_row = (columns + 63) / 64;
+	bits.assign((size_t)words_per_row * rows, 0);
+}
+
+void OccupancyGrid::mark(vec4 box)
+{
+	mark_if(box, [](const vec4&) { return true; });
+}
+
+bool OccupancyGrid::any(vec4 box) const
+{
+	int first_column, first_row, last_column, last_row;
+	if (!cells_of(box, first_column, first_row, last_column, last_row))
+		return false;
+
+	int first_word = first_column / 64, last_word = last_column / 64;
+	for (int row = first_row; row <= last_row; row++)
+	{
+		const uint64_t* words = &bits[row * words_per_row];
+		for (int word = first_word; word <= last_word; word++)
+		{
+			// only the bits of the columns within the box
+			uint64_t mask = ~uint64_t(0);
+			if (word == first_word)
+				mask &= ~uint64_t(0) << (first_column % 64);
+			if (word == last_word)
+				mask &= ~uint64_t(0) >> (63 - last_column % 64);
+			if (words[word] & mask)
+				return true;
+		}
+	}
+	return false;
+}
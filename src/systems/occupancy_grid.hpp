@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "common.hpp"
+
+// Bitmap of the cells of an area that hold something solid, one bit per square cell. A cell is marked
+// when a solid touches any part of it, so the bitmap is conservative: a box covering only unmarked
+// cells overlaps no solid, one covering a marked cell needs the exact test. Nothing outside the area
+// is marked. Every row starts on a new 64 bit word, so checking a box reads one or two words per row.
+// The cells are cell_size pixels wide; if the area is too large for that, they are made larger so the
+// bitmap never has more than MAX_CELLS_PER_AXIS cells in either direction.
+class OccupancyGrid
+{
+public:
+	static constexpr int MAX_CELLS_PER_AXIS = 4096;
+
+	// Unmarks everything and makes the grid cover area (x, y, width, height)
+	void reset(vec4 area, float cell_size);
+
+	// Marks every cell box touches
+	void mark(vec4 box);
+
+	// Marks the cells touching box for which is_solid(cell) is true, cell given as (x, y, width, height)
+	template <typename Func>
+	void mark_if(vec4 box, Func is_solid)
+	{
+		int first_column, first_row, last_column, last_row;
+		if (!cells_of(box, first_column, first_row, last_column, last_row))
+			return;
+		for (int row = first_row; row <= last_row; row++)
+			for (int column = first_column; column <= last_column; column++)
+				if (is_solid(cell_box(column, row)))
+					set(column, row);
+	}
+
+	// True if any cell box touches is marked
+	bool any(vec4 box) const;
+
+	bool blocked(int column, int row) const
+	{
+		return column >= 0 && column < columns && row >= 0 && row < rows && (bits[row * words_per_row + column / 64] >> (column % 64)) & 1;
+	}
+
+	int column_count() const { return columns; }
+	int row_count() const { return rows; }
+	float cell_size() const { return cell; }
+	vec4 cell_box(int column, int row) const { return { origin.x + column * cell, origin.y + row * cell, cell, cell }; }
+
+private:
+	float cell = 1.f;
+	vec2 origin = { 0.f, 0.f };
+	int columns = 0;
+	int rows = 0;
+	int words_per_row = 0;
+	std::vector<uint64_t> bits;
+
+	void set(int column, int row) { bits[row * words_per_row + column / 64] |= uint64_t(1) << (column % 64); }
+
+	// The cells box touches, clipped to the grid. False if it touches none.
+	bool cells_of(const vec4& box, int& first_column, int& first_row, int& last_column, int& last_row) const
+	{
+		if (columns == 0)
+			return false;
+		float first_x = std::floor((box.x - origin.x) / cell), last_x = std::floor((box.x + box.z - origin.x) / cell);
+		float first_y = std::floor((box.y - origin.y) / cell), last_y = std::floor((box.y + box.w - origin.y) / cell);
+		if (last_x < 0 || last_y < 0 || first_x >= columns || first_y >= rows)
+			return false;
+		first_column = (int)std::max(first_x, 0.f);
+		first_row = (int)std::max(first_y, 0.f);
+		last_column = (int)std::min(last_x, (float)columns - 1);
+		last_row = (int)std::min(last_y, (float)rows - 1);
+		return true;
+	}
+};
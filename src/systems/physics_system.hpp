@@ -4,41 +4,31 @@
 #include "tinyECS/tiny_ecs.hpp"
 #include "tinyECS/components.hpp"
 #include "tinyECS/registry.hpp"
+#include "tinyECS/frame_arena.hpp"
+#include "collision_world.hpp"
+#include "contact_manager.hpp"
+#include "projectile_system.hpp"
 
 // A simple physics system that moves rigid bodies and checks for collision
 class PhysicsSystem
 {
 public:
 	void step(float elapsed_ms);
-	static std::vector<vec2> get_transformed_vertices(const Mesh& mesh, const Motion& motion);
-	static bool collides(const Motion& player_motion, const Motion& terrain_motion, const Terrain* terrain, Entity terrain_entity);
+	// World-space mesh vertices, allocated from the frame arena so they are only valid for this frame
+	static FrameVector<vec2> get_transformed_vertices(const Mesh& mesh, const Motion& motion);
 
-	PhysicsSystem()
+	PhysicsSystem(ECSRegistry& registry, CollisionWorld& collision, ContactManager& contacts, const ProjectileSystem& projectiles)
+		: registry(registry), collision(collision), contacts(contacts), projectiles(projectiles)
 	{
 	}
 
-	std::vector<int> ammo_stopping_entities = {
-		(int)TEXTURE_ASSET_ID::TREE,
-		(int)TEXTURE_ASSET_ID::GROTTO_RIGHT_BOOKSHELF,
-		(int)TEXTURE_ASSET_ID::GROTTO_TOP_BOOKSHELF,
-		(int)TEXTURE_ASSET_ID::DESERT_CACTUS,
-		(int)TEXTURE_ASSET_ID::DESERT_SKULL,
-		(int)TEXTURE_ASSET_ID::DESERT_TREE,
-		(int)TEXTURE_ASSET_ID::DESERT_SAND_PILE_PAGE,
-		(int)TEXTURE_ASSET_ID::BUSH,
-		(int)TEXTURE_ASSET_ID::ENT,
-		(int)TEXTURE_ASSET_ID::MUMMY,
-		(int)TEXTURE_ASSET_ID::WELCOME_TO_GROTTO,
-		(int)TEXTURE_ASSET_ID::MUSHROOM_BLUE,
-		(int)TEXTURE_ASSET_ID::MUSHROOM_PINK,
-		(int)TEXTURE_ASSET_ID::MUSHROOM_PURPLE,
-		(int)TEXTURE_ASSET_ID::MUSHROOM_TALL_BLUE,
-		(int)TEXTURE_ASSET_ID::MUSHROOM_TALL_PINK,
-		(int)TEXTURE_ASSET_ID::CRYSTAL_1,
-		(int)TEXTURE_ASSET_ID::CRYSTAL_2,
-		(int)TEXTURE_ASSET_ID::CRYSTAL_3,
-		(int)TEXTURE_ASSET_ID::CRYSTAL_4,
-		(int)TEXTURE_ASSET_ID::CRYSTAL_MINECART,
-		(int)TEXTURE_ASSET_ID::CRYSTAL_ROCK
-	};
-};
\ No newline at end of file
+private:
+	ECSRegistry& registry;
+	CollisionWorld& collision;
+	ContactManager& contacts;
+	const ProjectileSystem& projectiles;
+
+	void update_damage_flashes(float elapsed_ms);
+	// Reports the contacts of the player and the thrown ammo to contacts
+	void find_contacts();
+};
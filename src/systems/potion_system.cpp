@@ -27,18 +27,8 @@ void PotionSystem::updateCauldrons(float elapsed_ms) {
 
 		// Add wait action if threshold exceeded
 		if (cc.timeSinceLastAction >= DEFAULT_WAIT) {
-			std::cout << "WAIT action recorded!" << std::endl;
-			recordAction(cauldron, ActionType::WAIT, cc.timeSinceLastAction / DEFAULT_WAIT);
-
-			// checks if we have waited 1 wait action (5 seconds) to advance tutorial
-			Action& lastAction = cc.actions[cc.actions.size() - 1];
-			if (lastAction.type == ActionType::WAIT && lastAction.value == 1) {
-				if (registry.screenStates.components[0].tutorial_state == (int)TUTORIAL::WAIT) {
-					ScreenState& screen = registry.screenStates.components[0];
-					screen.tutorial_step_complete = true;
-					screen.tutorial_state += 1;
-				}
-			}
+			recordAction(registry, cauldron, ActionType::WAIT, cc.timeSinceLastAction / DEFAULT_WAIT);
+			recorded_waits.push_back(cauldron);
 
 			cc.timeSinceLastAction = 0;
 		}
@@ -53,11 +43,29 @@ void PotionSystem::updateCauldrons(float elapsed_ms) {
 		// the cauldron's current color and the stored color.
 		cc.colorElapsed += elapsed_ms;
 		float ratio = cc.colorElapsed / (float)COLOR_FADE_DURATION;
-		cc.color = interpolateColor(cc.color, getPotion(cauldron).color, ratio);
+		cc.color = interpolateColor(cc.color, getPotion(registry, cauldron).color, ratio);
+	}
+}
+
+void PotionSystem::applyRecordedWaits() {
+	for (Entity cauldron : recorded_waits) {
+		std::cout << "WAIT action recorded!" << std::endl;
+
+		// checks if we have waited 1 wait action (5 seconds) to advance tutorial
+		Cauldron& cc = registry.cauldrons.get(cauldron);
+		Action& lastAction = cc.actions[cc.actions.size() - 1];
+		if (lastAction.type == ActionType::WAIT && lastAction.value == 1) {
+			if (registry.screenStates.components[0].tutorial_state == (int)TUTORIAL::WAIT) {
+				ScreenState& screen = registry.screenStates.components[0];
+				screen.tutorial_step_complete = true;
+				screen.tutorial_state += 1;
+			}
+		}
 	}
+	recorded_waits.clear();
 }
 
-void PotionSystem::addIngredient(Entity cauldron, Entity ingredient) {
+void PotionSystem::addIngredient(ECSRegistry& registry, Entity cauldron, Entity ingredient) {
 	Cauldron& cc = registry.cauldrons.get(cauldron);
 	Inventory& ci = registry.inventories.get(cauldron);
 
@@ -96,12 +104,12 @@ void PotionSystem::addIngredient(Entity cauldron, Entity ingredient) {
 		}
 
 		lastItem.amount += curItem.amount;
-		updatePotion(cauldron);
+		updatePotion(registry, cauldron);
 		return;
 	} while (false);
 
 	ci.items.push_back(ingredient);
-	recordAction(cauldron, ActionType::ADD_INGREDIENT, ci.items.size() - 1);
+	recordAction(registry, cauldron, ActionType::ADD_INGREDIENT, ci.items.size() - 1);
 
 	// handle tutorial adding damage potion ingredients
 	if (registry.screenStates.components[0].tutorial_state == (int)TUTORIAL::ADD_INGREDIENTS) {
@@ -136,7 +144,7 @@ void PotionSystem::addIngredient(Entity cauldron, Entity ingredient) {
 	}
 }
 
-void PotionSystem::changeHeat(Entity cauldron, int value) {
+void PotionSystem::changeHeat(ECSRegistry& registry, Entity cauldron, int value) {
 	Cauldron& cc = registry.cauldrons.get(cauldron);
 
 	// Update sounds
@@ -161,24 +169,24 @@ void PotionSystem::changeHeat(Entity cauldron, int value) {
 
 	// Record the actiono
 	cc.heatLevel = value;
-	recordAction(cauldron, ActionType::MODIFY_HEAT, value);
+	recordAction(registry, cauldron, ActionType::MODIFY_HEAT, value);
 }
 
-void PotionSystem::stirCauldron(Entity cauldron) {
-	stirCauldron(cauldron, 1);
+void PotionSystem::stirCauldron(ECSRegistry& registry, Entity cauldron) {
+	stirCauldron(registry, cauldron, 1);
 }
 
-void PotionSystem::stirCauldron(Entity cauldron, int amount)
+void PotionSystem::stirCauldron(ECSRegistry& registry, Entity cauldron, int amount)
 {
 	registry.cauldrons.get(cauldron).stirFlash = STIR_FLASH_DURATION;
 	Inventory& ci = registry.inventories.get(cauldron);
 	if (ci.items.size() == 0) {
 		return;
 	}
-	recordAction(cauldron, ActionType::STIR, amount);
+	recordAction(registry, cauldron, ActionType::STIR, amount);
 }
 
-Potion PotionSystem::bottlePotion(Entity cauldron) {
+Potion PotionSystem::bottlePotion(ECSRegistry& registry, Entity cauldron) {
 	// handle bottling tutorial
 	if (registry.screenStates.components[0].tutorial_state == (int)TUTORIAL::BOTTLE) {
 		ScreenState& screen = registry.screenStates.components[0];
@@ -187,7 +195,7 @@ Potion PotionSystem::bottlePotion(Entity cauldron) {
 	}
 
 	// Return potion immediately if effect is useless
-	Potion potion = getPotion(cauldron);
+	Potion potion = getPotion(registry, cauldron);
 	if (isUselessEffect(potion.effect)) {
 		return potion;
 	}
@@ -205,7 +213,7 @@ Potion PotionSystem::bottlePotion(Entity cauldron) {
 	PotionQuality pq = getNormalizedQuality(potion);
 	if (pq.threshold > 0) {
 		potion.quality = pq.normalized_quality;
-		vec3 baseColor = getBaseColor(registry.inventories.get(cauldron));
+		vec3 baseColor = getBaseColor(registry, registry.inventories.get(cauldron));
 		potion.color = interpolateColor(baseColor, recipe.finalPotionColor, potion.quality);
 		potion.duration = recipe.baseDuration + potion.quality * (recipe.highestQualityDuration - recipe.baseDuration);
 		potion.duration *= 1000; // So that it is in ms now
@@ -233,7 +241,7 @@ PotionQuality PotionSystem::getNormalizedQuality(Potion& potion) {
 	return pq;
 }
 
-void PotionSystem::resetCauldron(Entity cauldron) {
+void PotionSystem::resetCauldron(ECSRegistry& registry, Entity cauldron) {
 	// Clear cauldron
 	Cauldron& cc = registry.cauldrons.get(cauldron);
 	cc.color = DEFAULT_COLOR;
@@ -249,7 +257,7 @@ void PotionSystem::resetCauldron(Entity cauldron) {
 	// Clear cauldron items
 	Inventory& cinv = registry.inventories.get(cauldron);
 	for (Entity item : cinv.items) {
-		ItemSystem::destroyItem(item);
+		ItemSystem::destroyItem(registry, item);
 	}
 	cinv.items.clear();
 
@@ -257,7 +265,7 @@ void PotionSystem::resetCauldron(Entity cauldron) {
 	registry.potions.remove(cauldron);
 }
 
-bool PotionSystem::grindIngredient(Entity mortar) {
+bool PotionSystem::grindIngredient(ECSRegistry& registry, Entity mortar) {
 	if (!registry.mortarAndPestles.has(mortar)) {
 		// std::cerr << "Invalid mortar entity" << std::endl;
 		return false;
@@ -363,7 +371,7 @@ bool PotionSystem::grindIngredient(Entity mortar) {
 	return true;
 }
 
-void PotionSystem::storeIngredientInMortar(Entity mortar, Entity ingredient) {
+void PotionSystem::storeIngredientInMortar(ECSRegistry& registry, Entity mortar, Entity ingredient) {
 	Inventory& mortarInventory = registry.inventories.get(mortar);
 	const ItemInfo& itemInfo = ITEM_INFO.find(registry.items.get(ingredient).type)->second;
 
@@ -401,7 +409,7 @@ void PotionSystem::storeIngredientInMortar(Entity mortar, Entity ingredient) {
 // Private Helpers below  //
 ////////////////////////////
 
-void PotionSystem::recordAction(Entity cauldron, ActionType action, int value = 0) {
+void PotionSystem::recordAction(ECSRegistry& registry, Entity cauldron, ActionType action, int value = 0) {
 	Cauldron& cc = registry.cauldrons.get(cauldron);
 
 	// For stir, heat, and wait actions, if the last action was the same action,
@@ -429,16 +437,16 @@ void PotionSystem::recordAction(Entity cauldron, ActionType action, int value =
 			lastAction.value += value;
 		}
 
-		updatePotion(cauldron);
+		updatePotion(registry, cauldron);
 		return;
 	} while (false);
 
 	// Otherwise just add the action to the list
 	cc.actions.push_back({ action, value });
-	updatePotion(cauldron);
+	updatePotion(registry, cauldron);
 }
 
-Potion PotionSystem::getPotion(Entity cauldron) {
+Potion PotionSystem::getPotion(ECSRegistry& registry, Entity cauldron) {
 	if (registry.potions.has(cauldron)) {
 		return registry.potions.get(cauldron);
 	}
@@ -455,30 +463,31 @@ Potion PotionSystem::getDefaultPotion() {
 	return potion;
 }
 
-vec3 PotionSystem::getBaseColor(Inventory& ci) {
-	// Find all potions that have been dumped in cauldron
-	std::vector<vec3> colors;
+vec3 PotionSystem::getBaseColor(ECSRegistry& registry, Inventory& ci) {
+	// Sum up the colors of all potions that have been dumped in cauldron
+	int sum[3] = { 0, 0, 0 };
+	size_t count = 0;
 	for (Entity i : ci.items) {
-		if (!registry.potions.has(i)) {
+		Potion* potion = registry.potions.find(i);
+		if (!potion) {
 			continue;
 		}
 
-		colors.push_back(registry.potions.get(i).color);
+		for (int c = 0; c < 3; c++) {
+			sum[c] += potion->color[c];
+		}
+		count++;
 	}
 
 	// Return default if no potions found
-	if (!colors.size()) {
+	if (!count) {
 		return DEFAULT_COLOR;
 	}
 
 	// Otherwise mix all the colors together
 	vec3 res = vec3(0);
 	for (int i = 0; i < 3; i++) {
-		int sum = 0;
-		for (vec3 color : colors) {
-			sum += color[i];
-		}
-		res[i] = sum / colors.size();
+		res[i] = sum[i] / count;
 	}
 	return res;
 }
@@ -500,7 +509,7 @@ vec3 PotionSystem::interpolateColor(vec3 init, vec3 end, float ratio) {
 ///////////// Potion calculation functions ///////////
 
 // Gets levenshtein distance and a penalty
-std::pair<int, float> levDist(Entity cauldron, Recipe& recipe,
+std::pair<int, float> levDist(ECSRegistry& registry, Entity cauldron, Recipe& recipe,
 	std::vector<Action> playerActions, std::vector<Action> recipeActions) {
 	// Return other length if respective length is 0
 	if (playerActions.size() == 0) {
@@ -521,9 +530,9 @@ std::pair<int, float> levDist(Entity cauldron, Recipe& recipe,
 
 	// Check minimum of next possible iterations if action is different
 	if (pa.type != ra.type) {
-		std::pair next = levDist(cauldron, recipe, paTail, raTail);
-		std::pair alt1 = levDist(cauldron, recipe, paTail, recipeActions);
-		std::pair alt2 = levDist(cauldron, recipe, playerActions, raTail);
+		std::pair next = levDist(registry, cauldron, recipe, paTail, raTail);
+		std::pair alt1 = levDist(registry, cauldron, recipe, paTail, recipeActions);
+		std::pair alt2 = levDist(registry, cauldron, recipe, playerActions, raTail);
 		if (alt1.first < next.first) {
 			next = alt1;
 		}
@@ -576,7 +585,7 @@ std::pair<int, float> levDist(Entity cauldron, Recipe& recipe,
 		break;
 	}
 
-	std::pair<int, float> next = levDist(cauldron, recipe, paTail, raTail);
+	std::pair<int, float> next = levDist(registry, cauldron, recipe, paTail, raTail);
 	next.second += penalty;
 	return next;
 
@@ -585,7 +594,7 @@ std::pair<int, float> levDist(Entity cauldron, Recipe& recipe,
 // Gets the recipe of the current ingredients in the cauldron
 // Only the item and potion types have to match for a recipe to match
 // If a recipe is not found, the PotionEffect in the returned recipe will be FAILED
-Recipe getRecipe(Inventory& cauldronInventory) {
+Recipe getRecipe(ECSRegistry& registry, Inventory& cauldronInventory) {
 	Recipe recipe;
 	recipe.effect = PotionEffect::FAILED;
 
@@ -622,7 +631,7 @@ Recipe getRecipe(Inventory& cauldronInventory) {
 
 // Gets the maximum quality of the potion based on an average of the qualities
 // of the potions currently used in the recipe
-float getMaxQuality(Inventory& cauldronInventory) {
+float getMaxQuality(ECSRegistry& registry, Inventory& cauldronInventory) {
 	float res = 1.0f;
 	int pots = 0;
 	for (Entity e : cauldronInventory.items) {
@@ -643,28 +652,28 @@ float getMaxQuality(Inventory& cauldronInventory) {
 	return res;
 }
 
-void PotionSystem::updatePotion(Entity cauldron) {
+void PotionSystem::updatePotion(ECSRegistry& registry, Entity cauldron) {
 	Cauldron& cc = registry.cauldrons.get(cauldron);
 	Inventory& ci = registry.inventories.get(cauldron);
 	Potion potion = getDefaultPotion();
 
 	// Set color to mix of currently added potions
-	potion.color = getBaseColor(ci);
+	potion.color = getBaseColor(registry, ci);
 
 	// Reset last action time, since every action triggers an update
 	cc.timeSinceLastAction = 0;
 
 	// Step 1: Get recipe
-	Recipe recipe = getRecipe(ci);
+	Recipe recipe = getRecipe(registry, ci);
 
 	// Step 2: Get levenshtein distance and assign value for color
 	if (recipe.effect != PotionEffect::FAILED) {
 		// Effect is already known
 		potion.effect = recipe.effect;
-		float maxQuality = getMaxQuality(ci);
+		float maxQuality = getMaxQuality(registry, ci);
 
 		// Get quality based on formula and assign color
-		std::pair<int, float> dist = levDist(cauldron, recipe, cc.actions, recipe.steps);
+		std::pair<int, float> dist = levDist(registry, cauldron, recipe, cc.actions, recipe.steps);
 		int steps = recipe.steps.size();
 		potion.quality = maxQuality * max(steps - (dist.first + dist.second) * POTION_DIFFICULTY, 0.f) / steps;
 		potion.color = interpolateColor(potion.color, recipe.finalPotionColor, potion.quality);
@@ -682,12 +691,14 @@ void PotionSystem::updatePotion(Entity cauldron) {
 		potion.effect = PotionEffect::FAILED;
 	}
 
-	// Update values in registry
-	// Note: An extremely rare bug may happen here where a player
-	// takes out a default potion because getPotion() executed
-	// right in the middle of the two lines below. Just saying.
-	registry.potions.remove(cauldron);
-	registry.potions.insert(cauldron, potion);
+	// Update values in registry, in place once the cauldron has a potion so
+	// updateCauldrons() adds no components while other systems run
+	if (Potion* current = registry.potions.find(cauldron)) {
+		*current = potion;
+	}
+	else {
+		registry.potions.insert(cauldron, potion);
+	}
 
 	// Allow color update to happen
 	cc.colorElapsed = 0;
@@ -10,59 +10,64 @@
 // filled boolean to true, nothing needs to be done here
 class PotionSystem {
 public:
-	PotionSystem() {}
+	explicit PotionSystem(ECSRegistry& registry) : registry(registry) {}
 
 	// Update active cauldrons. Checks for wait actions, and
-	// updates the color of active cauldrons.
+	// updates the color of active cauldrons. Touches only the cauldrons'
+	// components, so it can run alongside other systems.
 	void updateCauldrons(float elapsed_ms);
 
+	// Logs the wait actions updateCauldrons() recorded and advances the
+	// tutorial for them. Call on the main thread once it has finished.
+	void applyRecordedWaits();
+
 	// Record adding an ingredient to a cauldron. Requires that the
 	// cauldron entity has an inventory component, and the ingredient
 	// entity has an item AND ingredient component!
-	static void addIngredient(Entity cauldron, Entity ingredient);
+	static void addIngredient(ECSRegistry& registry, Entity cauldron, Entity ingredient);
 
 	// Record a heatknob modification to the cauldron
 	// value is an integer from 1-100, where 100 is max heat
 	// A value of 0 is ignored if its the first action
-	static void changeHeat(Entity cauldron, int value);
+	static void changeHeat(ECSRegistry& registry, Entity cauldron, int value);
 
 	// Record a stir action to the cauldron
 	// This method does nothing if the cauldron inventory is empty
-	static void stirCauldron(Entity cauldron);
-	static void stirCauldron(Entity cauldron, int amount);
+	static void stirCauldron(ECSRegistry& registry, Entity cauldron);
+	static void stirCauldron(ECSRegistry& registry, Entity cauldron, int amount);
 
 	// Gets the resulting potion in its current state. Requires that
 	// the cauldron is filled (but no other requirements)
-	static Potion bottlePotion(Entity cauldron);
+	static Potion bottlePotion(ECSRegistry& registry, Entity cauldron);
 
 	// Get the normalized quality values of a potion
 	// If the returned PotionQuality::threshold < 0, then no quality was found
 	static PotionQuality getNormalizedQuality(Potion& potion);
 
+	// Gets the base color this cauldron from have, by mixing all the potions
+	// that were dumped in as ingredients.
+	static vec3 getBaseColor(ECSRegistry& registry, Inventory& ci);
+
 	// Empties the cauldron, resetting its values.
-	static void resetCauldron(Entity cauldron);
+	static void resetCauldron(ECSRegistry& registry, Entity cauldron);
 
 	// Grind the current ingredient in the mortar. Returns true if the grinding occured
-	static bool grindIngredient(Entity mortar);
+	static bool grindIngredient(ECSRegistry& registry, Entity mortar);
 
 	// Stores an ingredient inside the mortar. Requires the entity is an ingredient with grindLevel < 1
-	static void storeIngredientInMortar(Entity mortar, Entity ingredient);
+	static void storeIngredientInMortar(ECSRegistry& registry, Entity mortar, Entity ingredient);
 
 private:
 	// Base method for recording an action to a cauldron
-	static void recordAction(Entity cauldron, ActionType action, int value);
+	static void recordAction(ECSRegistry& registry, Entity cauldron, ActionType action, int value);
 
 	// Returns a COPY of the potion currently associated with this entity.
-	static Potion getPotion(Entity cauldron);
+	static Potion getPotion(ECSRegistry& registry, Entity cauldron);
 
 	// Returns a default water potion, used if no potion component is
 	// currently associated with the cauldron
 	static Potion getDefaultPotion();
 
-	// Gets the base color this cauldron from have, by mixing all the potions
-	// that were dumped in as ingredients.
-	static vec3 getBaseColor(Inventory& ci);
-
 	// Gets a color value that is a percentage distance between the start and end
 	// ratio is a number between 0 and 1 representing the percentage
 	static vec3 interpolateColor(vec3 init, vec3 end, float ratio);
@@ -103,5 +108,10 @@ private:
 	// color = default_color +/- abs(max_color - default_color) * quality
 	//   color is calculated per-channel and is added or subtracted
 	//   based on if the approaching color is higher or lower
-	static void updatePotion(Entity cauldron);
+	static void updatePotion(ECSRegistry& registry, Entity cauldron);
+
+	ECSRegistry& registry;
+
+	// Cauldrons that recorded a wait action since the last applyRecordedWaits()
+	std::vector<Entity> recorded_waits;
 };
\ No newline at end of file
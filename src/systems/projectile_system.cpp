@@ -0,0 +1,141 @@
+// internal
+#include "projectile_system.hpp"
+
+Entity ProjectileSystem::acquire()
+{
+	while (!retired.empty())
+	{
+		Entity entity = retired.back();
+		retired.pop_back();
+		if (!registry.is_alive(entity))
+			continue;
+		if (registry.ammo.has(entity) && registry.motions.has(entity) && registry.renderRequests.has(entity) && registry.collisionFilters.has(entity))
+			return entity;
+		// something stripped it while it was waiting, it is of no use anymore
+		registry.remove_all_components_of(entity);
+	}
+
+	auto entity = registry.create();
+	registry.ammo.emplace(entity);
+	registry.motions.emplace(entity);
+	registry.renderRequests.emplace(entity);
+	registry.collisionFilters.emplace(entity);
+	return entity;
+}
+
+void ProjectileSystem::launch(Entity entity, vec2 start, vec2 target, float speed, int damage)
+{
+	assert(!flying(entity) && "Launching a projectile that is already flying");
+	vec2 direction = target - start;
+	float distance = length(direction);
+	vec2 velocity = distance > 0.f ? direction * (speed / distance) : vec2(0.f, 0.f);
+
+	// a flight left by a destroyed entity with the same index ends here, before its slot is taken
+	unsigned int stale = slots.find(entity.index());
+	if (stale != SparseIndex::NONE)
+		remove_slot(stale);
+	slots.set(entity.index(), (unsigned int)projectiles.size());
+	projectiles.push_back({ entity, start, target, speed, damage, velocity, start, start });
+
+	registry.ammo.get(entity).is_fired = true;
+	Motion& motion = registry.motions.get(entity);
+	motion.position = start;
+	motion.previous_position = start;
+}
+
+void ProjectileSystem::retire(Entity entity)
+{
+	unsigned int slot = slot_of(entity);
+	if (slot == SparseIndex::NONE)
+		return;
+	remove_slot(slot);
+
+	if (Ammo* ammo = registry.ammo.find(entity))
+		ammo->is_fired = false;
+	if (RenderRequest* render_request = registry.renderRequests.find(entity))
+		render_request->is_visible = false;
+	contacts.forget(entity);
+	retired.push_back(entity);
+}
+
+void ProjectileSystem::retire_all()
+{
+	while (!projectiles.empty())
+		retire(projectiles.back().entity);
+}
+
+void ProjectileSystem::clear()
+{
+	projectiles.clear();
+	slots.clear();
+	retired.clear();
+}
+
+const Projectile* ProjectileSystem::find(Entity entity) const
+{
+	unsigned int slot = slot_of(entity);
+	return slot == SparseIndex::NONE ? nullptr : &projectiles[slot];
+}
+
+unsigned int ProjectileSystem::slot_of(Entity entity) const
+{
+	unsigned int slot = slots.find(entity.index());
+	return slot != SparseIndex::NONE && projectiles[slot].entity == entity ? slot : SparseIndex::NONE;
+}
+
+void ProjectileSystem::remove_slot(unsigned int slot)
+{
+	slots.reset(projectiles[slot].entity.index());
+	if (slot + 1 != projectiles.size())
+	{
+		projectiles[slot] = projectiles.back();
+		slots.set(projectiles[slot].entity.index(), slot);
+	}
+	projectiles.pop_back();
+}
+
+void ProjectileSystem::step(float elapsed_ms)
+{
+	if (registry.screenStates.components[0].is_switching_biome)
+		return;
+
+	// every flight only touches its own entry, so chunks of the array can run on any thread
+	auto advance = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			Projectile& projectile = projectiles[i];
+			projectile.previous_position = projectile.position;
+			projectile.position += projectile.velocity * elapsed_ms;
+		}
+	};
+	if (jobs)
+		jobs->parallel_for(0, projectiles.size(), PARALLEL_GRAIN, advance);
+	else
+		advance(0, projectiles.size());
+
+	// backwards, as removing a flight moves the last one into its place
+	for (size_t i = projectiles.size(); i-- > 0;)
+	{
+		Projectile& projectile = projectiles[i];
+		Motion* motion = registry.motions.find(projectile.entity);
+		if (!motion)
+		{
+			// the entity was removed, e.g. for leaving the screen
+			remove_slot((unsigned int)i);
+			continue;
+		}
+
+		// it is not drawn past its target
+		vec2 travelled = projectile.position - projectile.start;
+		vec2 range = projectile.target - projectile.start;
+		if (dot(travelled, travelled) > dot(range, range))
+		{
+			retire(projectile.entity);
+			continue;
+		}
+
+		motion->previous_position = projectile.previous_position;
+		motion->position = projectile.position;
+		motion->angle += SPIN_PER_STEP;
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+#include "common.hpp"
+#include "tinyECS/registry.hpp"
+#include "tinyECS/job_system.hpp"
+#include "contact_manager.hpp"
+
+// The flight of one thrown projectile, from start to target, speed in px per ms
+struct Projectile
+{
+	Entity entity;
+	vec2 start;
+	vec2 target;
+	float speed;
+	int damage;
+
+	vec2 velocity;          // px per ms towards target
+	vec2 position;          // where its Motion is, the center of the sprite
+	vec2 previous_position; // where it was before the last step
+};
+
+// Thrown ammo in flight. The flights are kept in a dense array that one loop advances every step,
+// the Motion of a projectile's entity only receives the result for drawing. The physics step sweeps
+// each flight's last move against the collision world, so a fast throw cannot pass a thin body.
+// Entities of finished flights are hidden and kept for the next throw instead of destroyed: they keep
+// their Ammo, Motion, RenderRequest and CollisionFilter and are handed out again by acquire(), and
+// their contacts are forgotten, so hitting the same body on the next throw is a new contact again.
+class ProjectileSystem
+{
+public:
+	ProjectileSystem(ECSRegistry& registry, ContactManager& contacts) : registry(registry), contacts(contacts) {}
+
+	// With a job system, large numbers of flights are advanced on its threads
+	void init(JobSystem* jobs) { this->jobs = jobs; }
+
+	// An entity for a new projectile, with the components above: a retired one if there is any
+	Entity acquire();
+	// Starts the flight of an acquired entity, its Motion is moved to start
+	void launch(Entity entity, vec2 start, vec2 target, float speed, int damage);
+	// Ends the flight of entity and keeps it for acquire(), does nothing if it is not flying
+	void retire(Entity entity);
+	void retire_all();
+	// Forgets every flight and retired entity, for when the registry removed them
+	void clear();
+
+	// Moves every flight and retires the ones that would pass their target
+	void step(float elapsed_ms);
+
+	bool flying(Entity entity) const { return slot_of(entity) != SparseIndex::NONE; }
+	const Projectile* find(Entity entity) const;
+	const std::vector<Projectile>& flights() const { return projectiles; }
+
+private:
+	static constexpr size_t PARALLEL_GRAIN = 4096; // fewer flights than this are not worth handing to other threads
+	static constexpr float SPIN_PER_STEP = 5.f;    // degrees a projectile turns every step
+
+	ECSRegistry& registry;
+	ContactManager& contacts;
+	JobSystem* jobs = nullptr;
+	std::vector<Projectile> projectiles;
+	SparseIndex slots; // index into projectiles by entity index
+	std::vector<Entity> retired;
+
+	// Index into projectiles of entity's flight or SparseIndex::NONE, an older entity with the same index has none
+	unsigned int slot_of(Entity entity) const;
+	// Removes the flight at slot, the last one takes its place
+	void remove_slot(unsigned int slot);
+};
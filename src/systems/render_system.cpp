@@ -367,7 +367,7 @@ void RenderSystem::draw(UISystem* ui_system, float elapsed_ms)
 
 	// Textured geometry, ensuring that render layers are respected, and that y-position sorting
 	// occurs for terrain and players
-	std::vector<Entity> entities = process_render_requests();
+	FrameVector<Entity> entities = process_render_requests();
 
 	// draw all entities with a render request to the frame buffer
 	for (Entity entity : entities)
@@ -624,22 +624,23 @@ void RenderSystem::swap_buffers()
 	gl_has_errors();
 }
 
-std::vector<Entity> RenderSystem::process_render_requests() {
-	std::vector<Entity> entities = registry.renderRequests.entities;
-
-	// don't render entities with no motion (position)
-	entities.erase(std::remove_if(entities.begin(), entities.end(), [](Entity e) {
-		return !registry.motions.has(e);
-		}), entities.end());
+FrameVector<Entity> RenderSystem::process_render_requests() {
+	// don't render entities with no motion (position), the group holds exactly those that have both
+	auto drawable = registry.group<Motion, RenderRequest>();
+	FrameVector<Entity> entities(drawable.size());
+	for (size_t i = 0; i < drawable.size(); i++)
+		entities[i] = drawable.entity(i);
 
 	/*
 		Rendering order is specified in components.hpp where background < terrain < structure < player
 		Note: Terrain and Player is y-position sorted, so that players can go behind and in front of trees ect.
+		Sorted again every frame: positions are written straight into Motion all over the game, so change
+		tracking would not see most moves.
 		Examples:
 		-	Terrain: Trees, rocks, bushes
 		-	Structure: Bridge, river
 	*/
-	std::sort(entities.begin(), entities.end(), [](Entity a, Entity b) {
+	std::sort(entities.begin(), entities.end(), [this](Entity a, Entity b) {
 		RenderRequest& renderA = registry.renderRequests.get(a);
 		RenderRequest& renderB = registry.renderRequests.get(b);
 
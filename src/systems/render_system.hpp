@@ -7,6 +7,7 @@
 #include "ui_system.hpp"
 #include "tinyECS/components.hpp"
 #include "tinyECS/tiny_ecs.hpp"
+#include "tinyECS/frame_arena.hpp"
 
 // System responsible for setting up OpenGL and for rendering all the
 // visual entities in the game
@@ -154,6 +155,8 @@ class RenderSystem {
 	std::array<Mesh, geometry_count> meshes;
 
 public:
+	explicit RenderSystem(ECSRegistry& registry) : registry(registry) {}
+
 	// Initialize the window
 	bool init(GLFWwindow* window);
 
@@ -188,7 +191,8 @@ public:
 	// Swap the frame buffers to display rendered content
 	void swap_buffers();
 
-	std::vector<Entity> process_render_requests();
+	// Entities to draw in drawing order, allocated from the frame arena
+	FrameVector<Entity> process_render_requests();
 
 	mat3 createProjectionMatrix();
 
@@ -208,6 +212,7 @@ public:
 	void setFPS(float fps) { m_fps = fps; }
 
 private:
+	ECSRegistry& registry;
 	GLuint vao;
 
 	// Internal drawing functions for each entity type
@@ -334,6 +334,7 @@ RenderSystem::~RenderSystem()
 bool RenderSystem::initScreenTexture()
 {
 	// create a single entry
+	screen_state_entity = registry.create();
 	registry.screenStates.emplace(screen_state_entity);
 
 	glGenTextures(1, &off_screen_render_buffer_color);
@@ -1,9 +1,12 @@
 #include "respawn_system.hpp"
 #include "sound_system.hpp"
+#include "world.hpp"
 #include <sstream>
 #include <iomanip>
 #include <iostream>
 
+RespawnSystem::RespawnSystem(World& world) : world(world), registry(world.registry) {}
+
 std::string RespawnSystem::generatePersistentID(BIOME biome, const std::string& entityType, const vec2& position) {
     std::stringstream ss;
     ss << static_cast<int>(biome) << "_" << entityType << "_";
@@ -115,10 +118,6 @@ bool RespawnSystem::shouldEntitySpawn(const std::string& persistentID) {
 }
 
 void RespawnSystem::step(float elapsed_ms) {
-    if (!renderer) return;
-    
-    GLuint currentBiome = registry.screenStates.components[0].biome;
-    
     for (auto& [id, state] : respawnStates) {
         // Skip entities that are already spawned
         if (state.isSpawned) continue;
@@ -132,48 +131,62 @@ void RespawnSystem::step(float elapsed_ms) {
             //               << state.respawnCooldownRemaining / 1000.0f << " seconds." << std::endl;
             // }
             
-            // Check if cooldown is complete
+            // Check if cooldown is complete, the entity is created by spawnFinished()
             if (state.respawnCooldownRemaining <= 0) {
                 state.isSpawned = true;
+                finished.push_back(id);
+            }
+        }
+    }
+}
+
+void RespawnSystem::spawnFinished() {
+    if (!renderer) {
+        finished.clear();
+        return;
+    }
+    
+    GLuint currentBiome = registry.screenStates.components[0].biome;
+    
+    for (const std::string& id : finished) {
+        const RespawnState& state = respawnStates[id];
+        std::cout << "Timer finished for entity " << id << " in biome " 
+                  << static_cast<int>(state.biome) << std::endl;
+        
+        // Only spawn entities in the current biome
+        if (static_cast<GLuint>(state.biome) == currentBiome) { 
+            std::cout << "Creating entity now because player is in the correct biome" << std::endl;
+            Entity entity = spawnEntityFromState(renderer, id);
+            
+            if (entity) {
+                std::cout << "Successfully created entity with ID " << entity.id() << std::endl;
                 
-                std::cout << "Timer finished for entity " << id << " in biome " 
-                          << static_cast<int>(state.biome) << std::endl;
-                
-                // Only spawn entities in the current biome
-                if (static_cast<GLuint>(state.biome) == currentBiome) { 
-                    std::cout << "Creating entity now because player is in the correct biome" << std::endl;
-                    Entity entity = spawnEntityFromState(renderer, id);
-                    
-                    if (entity) {
-                        std::cout << "Successfully created entity with ID " << entity.id() << std::endl;
-                        
-                        if (registry.motions.has(entity)) {
-                            registry.motions.get(entity).angle = 180.f;
-                        }
-                    } else {
-                        std::cout << "Failed to create entity!" << std::endl;
-                    }
-                } else {
-                    std::cout << "Player is in biome " << currentBiome 
-                              << ", entity will spawn when player enters biome " 
-                              << static_cast<int>(state.biome) << std::endl;
+                if (registry.motions.has(entity)) {
+                    registry.motions.get(entity).angle = 180.f;
                 }
+            } else {
+                std::cout << "Failed to create entity!" << std::endl;
             }
+        } else {
+            std::cout << "Player is in biome " << currentBiome 
+                      << ", entity will spawn when player enters biome " 
+                      << static_cast<int>(state.biome) << std::endl;
         }
     }
+    finished.clear();
 }
 
 Entity RespawnSystem::spawnEntityFromState(RenderSystem* renderer, const std::string& persistentID) {
     if (respawnStates.count(persistentID) == 0) {
-        return Entity(); // Invalid entity
+        return Entity::null(); // Invalid entity
     }
     
     RespawnState& state = respawnStates[persistentID];
-    Entity entity;
+    Entity entity = Entity::null();
     
     // Spawn item
     if (state.itemType != ItemType::POTION) {
-        entity = createCollectableIngredient(renderer, state.originalPosition, state.itemType, state.itemAmount, true);
+        entity = createCollectableIngredient(world, renderer, state.originalPosition, state.itemType, state.itemAmount, true);
         
         if (registry.items.has(entity) && registry.motions.has(entity)) {
             registry.items.get(entity).persistentID = persistentID;
@@ -182,16 +195,16 @@ Entity RespawnSystem::spawnEntityFromState(RenderSystem* renderer, const std::st
     }
     else if (!state.enemyName.empty()) {
         if (state.enemyName.find("Ent") != std::string::npos) {
-            entity = createEnt(renderer, state.originalPosition, state.enemyMovable, state.enemyName);
+            entity = createEnt(world, renderer, state.originalPosition, state.enemyMovable, state.enemyName);
         } 
         else if (state.enemyName.find("Mummy") != std::string::npos) {
-            entity = createMummy(renderer, state.originalPosition, state.enemyMovable, state.enemyName);
+            entity = createMummy(world, renderer, state.originalPosition, state.enemyMovable, state.enemyName);
         }
         else if (state.enemyName.find("Bug") != std::string::npos) {
-            entity = createCrystalBug(renderer, state.originalPosition, state.enemyMovable, state.enemyName);
+            entity = createCrystalBug(world, renderer, state.originalPosition, state.enemyMovable, state.enemyName);
         }
         else if (state.enemyName.find("Evil Mushroom") != std::string::npos) {
-            entity = createEvilMushroom(renderer, state.originalPosition, state.enemyMovable, state.enemyName);
+            entity = createEvilMushroom(world, renderer, state.originalPosition, state.enemyMovable, state.enemyName);
         }
         
         // Set the persistent ID
@@ -240,6 +253,7 @@ void RespawnSystem::deserialize(const nlohmann::json& data) {
     }
     
     respawnStates.clear();
+    finished.clear();
     
     for (const auto& stateData : data) {
         RespawnState state;
@@ -280,4 +294,5 @@ void RespawnSystem::deserialize(const nlohmann::json& data) {
 
 void RespawnSystem::reset() {
     respawnStates.clear();
+    finished.clear();
 } 
\ No newline at end of file
@@ -4,9 +4,12 @@
 #include <unordered_map>
 #include <string>
 #include "../tinyECS/tiny_ecs.hpp"
+#include "../tinyECS/registry.hpp"
 #include "../world_init.hpp"
 #include <nlohmann/json.hpp>
 
+struct World;
+
 struct RespawnState {
     std::string persistentID;
     float respawnCooldownRemaining = 0.0f;
@@ -23,14 +26,16 @@ struct RespawnState {
 
 class RespawnSystem {
 public:
-    static RespawnSystem& getInstance() {
-        static RespawnSystem instance;
-        return instance;
-    }
+    // Keeps the respawn states of entities in the given world
+    explicit RespawnSystem(World& world);
     
-    // Update all respawn timers
+    // Update all respawn timers. Touches nothing but the respawn states, so it can run alongside
+    // other systems; the entities whose timers finished are created by spawnFinished().
     void step(float elapsed_ms);
     
+    // Creates the entities whose timers finished in the current biome, on the main thread
+    void spawnFinished();
+    
     // Register or update an entity's respawn state
     void registerEntity(Entity entity, bool isSpawned);
     
@@ -58,11 +63,15 @@ public:
     void reset();
     
 private:
-    RespawnSystem() {}
+    World& world;
+    ECSRegistry& registry;
     
     // Map of persistent IDs to respawn states
     std::unordered_map<std::string, RespawnState> respawnStates;
     
+    // Persistent IDs whose timers finished since the last spawnFinished()
+    std::vector<std::string> finished;
+    
     RenderSystem* renderer = nullptr;
     
     friend class WorldSystem;
@@ -0,0 +1,57 @@
+// internal
+#include "terrain_tree.hpp"
+#include "collision_world.hpp"
+
+void TerrainTree::build(ECSRegistry& registry)
+{
+	this->registry = &registry;
+	clear();
+	for (auto [entity, terrain, motion] : registry.group<Terrain>(observe<Motion>))
+	{
+		if (registry.guardians.has(entity))
+		{
+			movable.push_back(entity);
+			continue;
+		}
+		tree.add((unsigned int)entities.size(), bounds(entity, motion, terrain));
+		entities.push_back(entity);
+	}
+	tree.build();
+}
+
+void TerrainTree::clear()
+{
+	tree.clear();
+	entities.clear();
+	movable.clear();
+	mesh_colliders.clear();
+}
+
+vec4 TerrainTree::bounds(Entity entity, const Motion& motion, const Terrain& terrain) const
+{
+	// the whole sprite, the collision boxes are bottom centered parts of it
+	vec4 box = get_bounding_box(motion, 1.f, 1.f);
+	if (terrain.collision_setting != 3.0f)
+		return box;
+
+	const MeshCollider* collider = mesh_collider(entity, motion);
+	if (!collider)
+		return box;
+	vec4 mesh_box = collider->bounds();
+	float x = std::min(box.x, mesh_box.x);
+	float y = std::min(box.y, mesh_box.y);
+	return { x, y, std::max(box.x + box.z, mesh_box.x + mesh_box.z) - x, std::max(box.y + box.w, mesh_box.y + mesh_box.w) - y };
+}
+
+const MeshCollider* TerrainTree::mesh_collider(Entity entity, const Motion& motion) const
+{
+	if (!registry)
+		return nullptr;
+	Mesh** mesh = registry->meshPtrs.find(entity);
+	if (!mesh || !*mesh)
+		return nullptr;
+	MeshCollider& collider = mesh_colliders[entity.id()];
+	if (!collider.built_for(**mesh, motion))
+		collider.build(**mesh, motion);
+	return &collider;
+}
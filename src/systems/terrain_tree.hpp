@@ -0,0 +1,86 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "tinyECS/registry.hpp"
+#include "aabb_tree.hpp"
+#include "mesh_collider.hpp"
+
+// The terrain of the current biome in an AABBTree, so a collision check only looks at the terrain
+// around the box it tests instead of at all of it. Terrain does not move, so the tree is
+// built once per biome, by BiomeSystem::switchBiome after the biome's entities are created.
+// Each terrain is indexed by the box around its whole sprite, which contains the collision box its
+// width/height ratios cut out of it, together with its mesh if it collides by mesh. The queries hand
+// out candidates, the callers run their exact collision test on them.
+// Guardians are terrain too but walk off once they are given their potion, they are kept out of the
+// tree and tested with their current Motion. Terrain removed since the build is skipped.
+// The tree also keeps the world space collision meshes of the terrain colliding by mesh, each is
+// transformed once and again only if its entity is moved. They are filled in while querying, so
+// like the rest of the collision checks, queries must not run on several threads at once.
+class TerrainTree
+{
+public:
+	void build(ECSRegistry& registry);
+	void clear();
+
+	// The box a terrain is indexed by
+	vec4 bounds(Entity entity, const Motion& motion, const Terrain& terrain) const;
+
+	// The collision mesh of entity placed at motion, null if it has no mesh
+	const MeshCollider* mesh_collider(Entity entity, const Motion& motion) const;
+
+	// Calls func(entity, terrain, motion) for the terrain whose bounds overlap box
+	template <typename Func>
+	void query(vec4 box, Func func) const
+	{
+		query_static(box, func);
+		query_movable(box, func);
+	}
+
+	// query() for the terrain in the tree only, or the movable terrain only
+	template <typename Func>
+	void query_static(vec4 box, Func func) const
+	{
+		tree.query(box, [&](unsigned int id) { report(entities[id], func); });
+	}
+	template <typename Func>
+	void query_movable(vec4 box, Func func) const
+	{
+		for (Entity entity : movable)
+		{
+			Terrain* terrain = registry->terrains.find(entity);
+			Motion* motion = registry->motions.find(entity);
+			if (!terrain || !motion)
+				continue;
+			vec4 other = bounds(entity, *motion, *terrain);
+			if (other.x <= box.x + box.z && other.x + other.z >= box.x && other.y <= box.y + box.w && other.y + other.w >= box.y)
+				func(entity, *terrain, *motion);
+		}
+	}
+
+	// Calls func(entity, terrain, motion) for all of the terrain in the tree
+	template <typename Func>
+	void for_each_static(Func func) const
+	{
+		for (Entity entity : entities)
+			report(entity, func);
+	}
+
+private:
+	ECSRegistry* registry = nullptr;
+	AABBTree tree;
+	std::vector<Entity> entities; // by the id they have in the tree
+	std::vector<Entity> movable;
+	mutable std::unordered_map<unsigned int, MeshCollider> mesh_colliders; // by entity id
+
+	template <typename Func>
+	void report(Entity entity, Func&& func) const
+	{
+		Terrain* terrain = registry->terrains.find(entity);
+		Motion* motion = registry->motions.find(entity);
+		if (terrain && motion)
+			func(entity, *terrain, *motion);
+	}
+};
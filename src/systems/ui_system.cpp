@@ -6,6 +6,7 @@
 #include "rmlui_system_interface.hpp"
 #include "rmlui_render_interface.hpp"
 #include "sound_system.hpp"
+#include "world.hpp"
 #include <iostream>
 #include <vector>
 #include <string>
@@ -20,17 +21,15 @@
 // Used to prevent OpenGL error checking during RmlUi rendering
 bool g_ui_rendering_in_progress = false;
 
-// Static instance for callbacks
-UISystem* UISystem::s_instance = nullptr;
-
-UISystem::UISystem()
-	: m_window(nullptr),
+UISystem::UISystem(World& world)
+	: world(world),
+	registry(world.registry),
+	m_window(nullptr),
 	m_renderer(nullptr),
 	m_context(nullptr),
 	m_document(nullptr),
 	m_initialized(false)
 {
-	s_instance = this;
 }
 
 UISystem::~UISystem()
@@ -47,8 +46,6 @@ UISystem::~UISystem()
 	}
 
 	Rml::Shutdown();
-
-	s_instance = nullptr;
 }
 
 bool UISystem::init(GLFWwindow* window, RenderSystem* renderer)
@@ -200,6 +197,13 @@ void UISystem::step(float elapsed_ms)
 		// update all the textboxes
 		updateTextboxes();
 
+		// move the health bars of the enemies that are up and about along with them
+		for (Entity enemy : registry.enemies.entities) {
+			Motion* motion = registry.motions.find(enemy);
+			if (motion && registry.enemies.get(enemy).state != (int)ENEMY_STATE::IDLE)
+				updateEnemyHealthBarPos(enemy, motion->position);
+		}
+
 		// Update cauldron (heat/timer)
 		if (isCauldronOpen()) {
 			updateCauldronUI();
@@ -508,8 +512,8 @@ void UISystem::handleMouseButtonEvent(int button, int action, int mods)
 						if (slotId < chestInv.items.size() && registry.items.has(chestInv.items[slotId])) {
 							Entity item = chestInv.items[slotId];
 
-							if (ItemSystem::addItemToInventory(player, item)) {
-								ItemSystem::removeItemFromInventory(chest, item);
+							if (ItemSystem::addItemToInventory(world, player, item)) {
+								ItemSystem::removeItemFromInventory(world, chest, item);
 								SoundSystem::playInteractMenuSound((int)SOUND_CHANNEL::MENU, 0);
 
 								updateInventoryBar();
@@ -525,8 +529,8 @@ void UISystem::handleMouseButtonEvent(int button, int action, int mods)
 					if (playerSlot < playerInv.items.size() && registry.items.has(playerInv.items[playerSlot])) {
 						Entity item = playerInv.items[playerSlot];
 
-						if (ItemSystem::addItemToInventory(chest, item)) {
-							ItemSystem::removeItemFromInventory(player, item);
+						if (ItemSystem::addItemToInventory(world, chest, item)) {
+							ItemSystem::removeItemFromInventory(world, player, item);
 							SoundSystem::playInteractMenuSound((int)SOUND_CHANNEL::MENU, 0);
 
 							updateInventoryBar();
@@ -592,11 +596,11 @@ void UISystem::handleMouseButtonEvent(int button, int action, int mods)
 
 				// Create potion and add to player inventory
 				Entity cauldron = getOpenedCauldron();
-				Potion potion = PotionSystem::bottlePotion(cauldron);
+				Potion potion = PotionSystem::bottlePotion(registry, cauldron);
 
 				// Create potion item and add to player inventory
 				Entity player = registry.players.entities[0];
-				Entity potionItem = ItemSystem::createPotion(
+				Entity potionItem = ItemSystem::createPotion(registry,
 					potion.effect,
 					potion.duration,
 					potion.color,
@@ -606,12 +610,12 @@ void UISystem::handleMouseButtonEvent(int button, int action, int mods)
 				);
 
 				// If couldn't be added to inventory then don't do anything (obviously)
-				if (!ItemSystem::addItemToInventory(player, potionItem)) {
+				if (!ItemSystem::addItemToInventory(world, player, potionItem)) {
 					break;
 				}
 
 				// Reset cauldron
-				PotionSystem::resetCauldron(cauldron);
+				PotionSystem::resetCauldron(registry, cauldron);
 				m_renderer->initializeWaterBuffers(true); // Will not be necessary once empty cauldron is supported
 
 				// stop the boiling sound and play potion bottling sound
@@ -671,13 +675,13 @@ void UISystem::handleMouseButtonEvent(int button, int action, int mods)
 
 				// Move to inventory
 				Entity player = registry.players.entities[0];
-				if (!ItemSystem::addItemToInventory(player, ingredient)) {
+				if (!ItemSystem::addItemToInventory(world, player, ingredient)) {
 					break;
 				}
 
 				SoundSystem::playCollectItemSound((int)SOUND_CHANNEL::MENU, 0);
 				mortarInventory.items.clear();
-				ItemSystem::destroyItem(ingredient);
+				ItemSystem::destroyItem(registry, ingredient);
 			}
 		} while (false);
 	}
@@ -690,7 +694,7 @@ void UISystem::handleMouseButtonEvent(int button, int action, int mods)
 		Inventory& inventory = registry.inventories.get(entity);
 
 		if (slotId != -1 && slotId + 1 <= inventory.items.size()) {
-			ItemSystem::removeItemFromInventory(entity, inventory.items[slotId]);
+			ItemSystem::removeItemFromInventory(world, entity, inventory.items[slotId]);
 
 			if (m_inventory_document) {
 				updateInventoryBar();
@@ -715,13 +719,6 @@ void UISystem::handleScrollWheelEvent(double xoffset, double yoffset)
 	m_context->ProcessMouseWheel(Rml::Vector2f(xoffset, yoffset), getKeyModifiers());
 }
 
-void UISystem::charCallback(GLFWwindow* window, unsigned int codepoint)
-{
-	if (s_instance) {
-		s_instance->handleTextInput(codepoint);
-	}
-}
-
 void UISystem::updateFPS(float elapsed_ms)
 {
 	m_frame_time_sum -= m_frame_times[m_frame_time_index];
@@ -833,6 +830,7 @@ void UISystem::createInventoryBar()
 
 		inventory_rml += "</div></body></rml>";
 		m_inventory_document = m_context->LoadDocumentFromMemory(inventory_rml.c_str());
+		m_slot_rml.assign(m_hotbar_size, "");
 		if (m_inventory_document) {
 			m_inventory_document->Show();
 			std::cout << "UISystem::createInventoryBar - Inventory bar created successfully" << std::endl;
@@ -868,7 +866,7 @@ void UISystem::updateInventoryBar()
 		// Update the item name
 		Rml::Element* item_name = m_inventory_document->GetElementById("item-name");
 		if (getSelectedSlot() < inventory.items.size()) {
-			item_name->SetInnerRML(ItemSystem::getItemName(inventory.items[getSelectedSlot()]));
+			item_name->SetInnerRML(ItemSystem::getItemName(registry, inventory.items[getSelectedSlot()]));
 		}
 		else {
 			item_name->SetInnerRML("");
@@ -961,6 +959,10 @@ void UISystem::updateInventoryBar()
 				}
 			}
 
+			// parsing the RML is the expensive part, most updates only change one or two slots
+			if (m_slot_rml[i] == slot_content)
+				continue;
+			m_slot_rml[i] = slot_content;
 			slot_element->SetInnerRML(slot_content);
 		}
 	}
@@ -2049,7 +2051,7 @@ void UISystem::closeRecipeBook()
 		Mix_VolumeMusic(MUSIC_VOLUME);
 	}
 
-	openedRecipeBook = {};
+	openedRecipeBook = Entity::null();
 }
 
 bool UISystem::isRecipeBookOpen()
@@ -2862,7 +2864,7 @@ void UISystem::closeChestMenu() {
 		m_chest_document->Hide();
 		SoundSystem::playInteractMenuSound((int)SOUND_CHANNEL::MENU, 0);
 		Mix_VolumeMusic(MUSIC_VOLUME);
-		openedChest = Entity();
+		openedChest = Entity::null();
 	}
 }
 
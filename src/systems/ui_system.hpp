@@ -17,6 +17,7 @@
 
 // Forward declarations
 class RenderSystem;
+struct World;
 
 struct TextQueueItem {
     std::string text;
@@ -27,11 +28,11 @@ struct TextQueueItem {
 // Main UI system class
 class UISystem {
 public:
-    UISystem();
+    explicit UISystem(World& world);
     ~UISystem();
 
-    // Static instance for callbacks
-    static UISystem* s_instance;
+    // The world this UI shows
+    World& getWorld() { return world; }
 
     bool init(GLFWwindow* window, RenderSystem* renderer);
     void updateWindowSize(float scale);
@@ -45,9 +46,6 @@ public:
     void handleScrollWheelEvent(double xoffset, double yoffset);
     void handleTextInput(unsigned int codepoint);
 
-    // Static callbacks for GLFW
-    static void charCallback(GLFWwindow* window, unsigned int codepoint);
-
     // FPS counter
     void updateFPS(float elapsed_ms);
     float getFPS() const { return m_current_fps; }
@@ -144,6 +142,9 @@ public:
     void startGrindAnimation();
 
 private:
+    World& world;
+    ECSRegistry& registry;
+
     GLFWwindow* m_window;
     RenderSystem* m_renderer;
 
@@ -181,6 +182,7 @@ private:
     // Inventory bar variables
     Rml::ElementDocument* m_inventory_document = nullptr;
     int m_hotbar_size = 10;
+    std::vector<std::string> m_slot_rml; // what each slot's content was last set to, slots start empty
     const int SHOW_TEXT_MS = 4000;
     const int FADE_TEXT_MS = 1000;
     int showText = 0;
@@ -188,22 +190,22 @@ private:
 
     // Cauldron variables
     Rml::ElementDocument* m_cauldron_document = nullptr;
-    Entity openedCauldron;
+    Entity openedCauldron = Entity::null();
     Rml::Element* heldLadle = nullptr;
     Rml::Element* heldBottle = nullptr;
 
     // Recipe book variables
     Rml::ElementDocument* m_recipe_book_document = nullptr;
-    Entity openedRecipeBook;
+    Entity openedRecipeBook = Entity::null();
 
     // Mortar & Pestle variables
     Rml::ElementDocument* m_mortar_document = nullptr;
-    Entity openedMortar;
+    Entity openedMortar = Entity::null();
     Rml::Element* heldPestle = nullptr;
 
     // Chest variables
     Rml::ElementDocument* m_chest_document = nullptr;
-    Entity openedChest;
+    Entity openedChest = Entity::null();
 
     // Tutorial variables
     Rml::ElementDocument* m_tutorial_document = nullptr;
@@ -0,0 +1,62 @@
+// internal
+#include "uniform_grid.hpp"
+
+void UniformGrid::clear()
+{
+	ids.clear();
+	boxes.clear();
+	columns = 0;
+	rows = 0;
+}
+
+void UniformGrid::add(unsigned int id, vec4 box)
+{
+	ids.push_back(id);
+	boxes.push_back(box);
+}
+
+void UniformGrid::build()
+{
+	if (boxes.empty())
+	{
+		columns = 0;
+		rows = 0;
+		return;
+	}
+
+	// fit the grid around the boxes
+	vec2 low = { boxes[0].x, boxes[0].y };
+	vec2 high = low;
+	for (const vec4& box : boxes)
+	{
+		low = glm::min(low, vec2(box.x, box.y));
+		high = glm::max(high, vec2(box.x + box.z, box.y + box.w));
+	}
+	origin = low;
+	vec2 extent = high - low;
+	cell = std::max({ cell_size, extent.x / MAX_CELLS_PER_AXIS, extent.y / MAX_CELLS_PER_AXIS });
+	columns = std::min((int)(extent.x / cell) + 1, MAX_CELLS_PER_AXIS);
+	rows = std::min((int)(extent.y / cell) + 1, MAX_CELLS_PER_AXIS);
+
+	// count the boxes per cell, then turn the counts into the start of each cell's entries
+	cell_start.assign((size_t)columns * rows + 1, 0);
+	for (const vec4& box : boxes)
+		for (int row = row_of(box.y); row <= row_of(box.y + box.w); row++)
+			for (int column = column_of(box.x); column <= column_of(box.x + box.z); column++)
+				cell_start[row * columns + column + 1]++;
+	for (size_t cell_index = 1; cell_index < cell_start.size(); cell_index++)
+		cell_start[cell_index] += cell_start[cell_index - 1];
+
+	// fill in cell order, each cell's start moves to its end while filling and is moved back afterwards
+	cell_entries.resize(cell_start.back());
+	for (unsigned int i = 0; i < boxes.size(); i++)
+	{
+		const vec4& box = boxes[i];
+		for (int row = row_of(box.y); row <= row_of(box.y + box.w); row++)
+			for (int column = column_of(box.x); column <= column_of(box.x + box.z); column++)
+				cell_entries[cell_start[row * columns + column]++] = i;
+	}
+	for (size_t cell_index = cell_start.size() - 1; cell_index > 0; cell_index--)
+		cell_start[cell_index] = cell_start[cell_index - 1];
+	cell_start[0] = 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "common.hpp"
+
+// Broadphase over axis aligned boxes given as (x, y, width, height), like get_bounding_box() returns.
+// The boxes are collected with add() and bucketed into a uniform grid by build(): a counting sort into
+// one flat array, so rebuilding every step is two linear passes and allocates nothing once the arrays
+// have grown. A query only visits the cells its box covers.
+// The grid spans the added boxes; if they are spread too far for the requested cell size, the cells
+// are made larger so the grid never has more than MAX_CELLS_PER_AXIS cells in either direction.
+class UniformGrid
+{
+public:
+	static constexpr int MAX_CELLS_PER_AXIS = 256;
+
+	explicit UniformGrid(float cell_size = 64.f) : cell_size(cell_size) {}
+
+	void clear();
+	void add(unsigned int id, vec4 box);
+	void build();
+
+	size_t size() const { return ids.size(); }
+
+	// Calls func(id) once for every box that overlaps box, touching edges count as overlapping.
+	// Only valid after build().
+	template <typename Func>
+	void query(vec4 box, Func func) const
+	{
+		if (columns == 0)
+			return;
+		int first_column = column_of(box.x), last_column = column_of(box.x + box.z);
+		int first_row = row_of(box.y), last_row = row_of(box.y + box.w);
+		for (int row = first_row; row <= last_row; row++)
+		{
+			for (int column = first_column; column <= last_column; column++)
+			{
+				unsigned int cell = row * columns + column;
+				for (unsigned int entry = cell_start[cell]; entry < cell_start[cell + 1]; entry++)
+				{
+					unsigned int i = cell_entries[entry];
+					const vec4& other = boxes[i];
+					if (other.x > box.x + box.z || other.x + other.z < box.x || other.y > box.y + box.w || other.y + other.w < box.y)
+						continue;
+					// a box is in every cell it covers, report it only from the cell holding the corner of the overlap
+					if (column_of(std::max(box.x, other.x)) != column || row_of(std::max(box.y, other.y)) != row)
+						continue;
+					func(ids[i]);
+				}
+			}
+		}
+	}
+
+private:
+	float cell_size; // requested
+	float cell = 1.f; // used by the current build
+	vec2 origin = { 0.f, 0.f };
+	int columns = 0;
+	int rows = 0;
+
+	std::vector<unsigned int> ids;
+	std::vector<vec4> boxes;
+	std::vector<unsigned int> cell_start;   // the entries of cell c are cell_entries[cell_start[c]] to cell_entries[cell_start[c + 1] - 1]
+	std::vector<unsigned int> cell_entries; // index into ids and boxes
+
+	int column_of(float x) const { return std::min(std::max((int)std::floor((x - origin.x) / cell), 0), columns - 1); }
+	int row_of(float y) const { return std::min(std::max((int)std::floor((y - origin.y) / cell), 0), rows - 1); }
+};
@@ -1,5 +1,6 @@
 // Header
 #include "world_system.hpp"
+#include "world.hpp"
 #include "world_init.hpp"
 #include "common.hpp"
 #include "item_system.hpp"
@@ -14,7 +15,7 @@
 #include "physics_system.hpp"
 
 // create the world
-WorldSystem::WorldSystem()
+WorldSystem::WorldSystem(World& world) : world(world), registry(world.registry)
 {
 	// seeding rng with random device
 	rng = std::default_random_engine(std::random_device()());
@@ -96,12 +97,15 @@ GLFWwindow* WorldSystem::create_window()
 		{ ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_mouse_wheel(_xoffset, _yoffset); };
 	auto window_resize_redirect = [](GLFWwindow* wnd, int _width, int _height)
 		{ ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_window_resize(_width, _height); };
+	auto char_redirect = [](GLFWwindow* wnd, unsigned int _codepoint)
+		{ ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_char(_codepoint); };
 
 	glfwSetKeyCallback(window, key_redirect);
 	glfwSetCursorPosCallback(window, cursor_pos_redirect);
 	glfwSetMouseButtonCallback(window, mouse_button_pressed_redirect);
 	glfwSetScrollCallback(window, scroll_wheel_redirect);
 	glfwSetWindowSizeCallback(window, window_resize_redirect);
+	glfwSetCharCallback(window, char_redirect);
 
 	return window;
 }
@@ -112,7 +116,7 @@ bool WorldSystem::init(RenderSystem* renderer_arg, BiomeSystem* biome_sys)
 	this->renderer = renderer_arg;
 	this->biome_sys = biome_sys;
 
-	RespawnSystem::getInstance().renderer = renderer_arg;
+	world.respawns.renderer = renderer_arg;
 
 	// Set all states to default
 	restart_game(false);
@@ -144,7 +148,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	screen.autosave_timer -= elapsed_ms_since_last_update;
 	if (screen.autosave_timer <= 0) {
 		screen.autosave_timer = AUTOSAVE_TIMER;
-		ItemSystem::saveGameState();
+		ItemSystem::saveGameState(world);
 	}
 
 	if (registry.players.entities.size() < 1)
@@ -162,23 +166,20 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	auto& motions_registry = registry.motions;
 
 	// Remove entities that leave the screen on the left side
-	// Iterate backwards to be able to remove without unterfering with the next object to visit
-	// (the containers exchange the last element with the current)
-	for (int i = (int)motions_registry.components.size() - 1; i >= 0; --i)
+	// (destroyed at the next sync point, so the loop can visit every object in order)
+	for (size_t i = 0; i < motions_registry.components.size(); i++)
 	{
 		Motion& motion = motions_registry.components[i];
 		if (motion.position.x + abs(motion.scale.x) < 0.f)
 		{
 			if (!registry.players.has(motions_registry.entities[i])) // don't remove the player
-				registry.remove_all_components_of(motions_registry.entities[i]);
+				registry.commands.destroy(motions_registry.entities[i]);
 		}
 	}
 
-	// Update respawn system timers for persistent respawns
-	RespawnSystem::getInstance().step(elapsed_ms_since_last_update);
-
 	// Remove enemies from killed_enemies list if they're respawned in RespawnSystem
-	for (auto& [id, state] : RespawnSystem::getInstance().getRespawnStates()) {
+	// (its timers run alongside the AI, see main.cpp)
+	for (auto& [id, state] : world.respawns.getRespawnStates()) {
 		if (state.isSpawned && !state.enemyName.empty()) {
 			// Find and remove from killed_enemies if present
 			auto& killed_list = registry.screenStates.components[0].killed_enemies;
@@ -190,9 +191,11 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 		}
 	}
 
-	updateThrownAmmo(elapsed_ms_since_last_update);
-
-	if (m_ui_system->isCauldronOpen() || m_ui_system->isMortarPestleOpen()) return true; // skip the following updates if menu is open
+	// skip the following updates if menu is open, and keep the MotionSystem from moving the player
+	if (m_ui_system->isCauldronOpen() || m_ui_system->isMortarPestleOpen()) {
+		player_motion.velocity = { 0, 0 };
+		return true;
+	}
 	updatePlayerState(player, player_motion, elapsed_ms_since_last_update);
 	update_textbox_visibility();
 
@@ -203,7 +206,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			if (registry.motions.has(e)) {
 				registry.motions.get(e).velocity = delay.velocity;
 			}
-			registry.delayedMovements.remove(e);
+			registry.commands.remove(registry.delayedMovements, e);
 		}
 	}
 
@@ -334,13 +337,15 @@ void WorldSystem::restart_game(bool hard_reset)
 	// All that have a motion, we could also iterate over all bug, eagles, ... but that would be more cumbersome
 	while (registry.motions.entities.size() > 0)
 		registry.remove_all_components_of(registry.motions.entities.back());
+	// the projectiles were among them
+	world.projectiles.clear();
 
 	// debugging for memory/component leaks
 	registry.list_all_components();
 
 	if (registry.players.components.size() == 0)
 	{
-		createPlayer(renderer, vec2(GRID_CELL_WIDTH_PX * 17.5, GRID_CELL_HEIGHT_PX * 12.0));
+		createPlayer(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 17.5, GRID_CELL_HEIGHT_PX * 12.0));
 	}
 
 	// re-open tutorial, state is loaded from persistence
@@ -354,7 +359,7 @@ void WorldSystem::restart_game(bool hard_reset)
 		screen.tutorial_state = 0;
 		screen.tutorial_step_complete = true;
 		screen.fog_intensity = FOG_INTENSITY;
-		createWelcomeScreen(renderer, vec2(WINDOW_WIDTH_PX / 2, WINDOW_HEIGHT_PX / 2 - 50));
+		createWelcomeScreen(registry, renderer, vec2(WINDOW_WIDTH_PX / 2, WINDOW_HEIGHT_PX / 2 - 50));
 		screen.killed_enemies = {};
 		screen.unlocked_biomes = {};
 		if (m_ui_system) {
@@ -371,7 +376,7 @@ void WorldSystem::restart_game(bool hard_reset)
 		biome_sys->switchBiome((int)BIOME::GROTTO, true);
 	}
 	else {
-		nlohmann::json loaded_data = ItemSystem::loadCoreState();
+		nlohmann::json loaded_data = ItemSystem::loadCoreState(world);
 
 		// Initialize the biome system after core data is loaded
 		biome_sys->init(renderer);
@@ -396,43 +401,41 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 	vec2 original_position = player_motion.position;
 	vec2 previous_position = player_motion.previous_position;
 
-	// Handle non-terrain collisions first (ammo, enemies, etc.)
-	for (Entity collision_entity : registry.collisions.entities)
+	// Handle the enemy contacts first, ammo hitting an enemy does not also hit the terrain around it.
+	// Indexed, as the player dying clears the contacts and with them the events.
+	const std::vector<ContactEvent>& events = world.contacts.events();
+	for (size_t i = 0; i < events.size(); i++)
 	{
 		ScreenState& screen = registry.screenStates.components[0];
+		const ContactEvent& event = events[i];
 
-		if (!registry.collisions.has(collision_entity))
+		// an earlier contact this frame already used up one of the two
+		if (event.state == ContactState::END || registry.commands.is_destroyed(event.entity) || registry.commands.is_destroyed(event.other))
 			continue;
-		Collision& collision = registry.collisions.get(collision_entity);
 
-		// case ammo hits enemy
-		if ((registry.ammo.has(collision_entity) || registry.ammo.has(collision.other)) && (registry.enemies.has(collision_entity) || registry.enemies.has(collision.other))) {
-			Entity ammo_entity = registry.ammo.has(collision_entity) ? collision_entity : collision.other;
-			Entity enemy_entity = registry.enemies.has(collision_entity) ? collision_entity : collision.other;
+		// case ammo hits enemy, when it reaches it
+		if (event.state == ContactState::BEGIN && world.projectiles.flying(event.entity) && registry.enemies.has(event.other)) {
+			Entity ammo_entity = event.entity;
+			Entity enemy_entity = event.other;
 
 			Enemy& enemy = registry.enemies.get(enemy_entity);
-			Ammo& ammo = registry.ammo.get(ammo_entity);
+			int damage = world.projectiles.find(ammo_entity)->damage;
 			if (!registry.potions.has(ammo_entity)) continue;
 			Potion& potion = registry.potions.get(ammo_entity);
 
 			if (registry.potions.get(ammo_entity).effect == PotionEffect::MOLOTOV && registry.motions.has(enemy_entity)) {
-				// damage all enemies within 100 px
+				// damage all enemies within 100 px, the collision world only visits the ones near the hit
 				vec2 enemy_pos = registry.motions.get(enemy_entity).position;
-				for (auto neighbour_enemy : registry.enemies.entities) {
-					if (neighbour_enemy == enemy_entity || !registry.motions.has(neighbour_enemy)) continue;
-					vec2 pos = registry.motions.get(neighbour_enemy).position;
-					float dx = pos.x - enemy_pos.x;
-					float dy = pos.y - enemy_pos.y;
-					if ((dx * dx + dy * dy) <= MOLOTOV_RADIUS_SQUARED) {
-						// apply damage over time effect
-						Enemy& neighbour = registry.enemies.get(neighbour_enemy);
-						neighbour.dot_damage = potion.effectValue * MOLOTOV_MULTIPLIER;
-						neighbour.dot_timer = DOT_MOLOTOV_TIMER;
-						neighbour.dot_duration = potion.duration;
-						neighbour.dot_effect = PotionEffect::MOLOTOV;
-						handleEnemyInjured(neighbour_enemy, ammo.damage);
-					}
-				}
+				world.collision.queryRadius(enemy_pos, MOLOTOV_RADIUS, COLLISION_ENEMY, [&](Entity neighbour_enemy) {
+					if (neighbour_enemy == enemy_entity) return;
+					// apply damage over time effect
+					Enemy& neighbour = registry.enemies.get(neighbour_enemy);
+					neighbour.dot_damage = potion.effectValue * MOLOTOV_MULTIPLIER;
+					neighbour.dot_timer = DOT_MOLOTOV_TIMER;
+					neighbour.dot_duration = potion.duration;
+					neighbour.dot_effect = PotionEffect::MOLOTOV;
+					handleEnemyInjured(neighbour_enemy, damage);
+				});
 			}
 
 			if (potion.effect == PotionEffect::POISON) {
@@ -448,13 +451,13 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 				enemy.dot_effect = PotionEffect::MOLOTOV;
 			}
 
-			handleEnemyInjured(enemy_entity, ammo.damage);
-			registry.remove_all_components_of(ammo_entity);
+			handleEnemyInjured(enemy_entity, damage);
+			world.projectiles.retire(ammo_entity);
 		}
-		// case where enemy hits player
-		else if ((registry.players.has(collision_entity) || registry.players.has(collision.other)) && (registry.enemies.has(collision_entity) || registry.enemies.has(collision.other))) {
-			Entity player_entity = registry.players.has(collision_entity) ? collision_entity : collision.other;
-			Entity enemy_entity = registry.enemies.has(collision_entity) ? collision_entity : collision.other;
+		// case where enemy hits player, for as long as they touch
+		else if (registry.players.has(event.entity) && registry.enemies.has(event.other)) {
+			Entity player_entity = event.entity;
+			Entity enemy_entity = event.other;
 
 			Player& player = registry.players.get(player_entity);
 
@@ -473,9 +476,7 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 				GLuint last_biome = screen.biome; // this is the biome that the player died in
 
 				// remove any ammo from screen
-				for (auto thrown_ammo : registry.ammo.entities) {
-					if (registry.ammo.get(thrown_ammo).is_fired) registry.remove_all_components_of(thrown_ammo);
-				}
+				world.projectiles.retire_all();
 
 				// Apply death penalty: remove a random valid item
 				if (registry.inventories.has(player_entity)) {
@@ -483,7 +484,7 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 
 					std::vector<Entity> valid_items;
 					for (Entity item : inventory.items) {
-						if (item != Entity() && registry.items.has(item)) {
+						if (item != Entity::null() && registry.items.has(item)) {
 							valid_items.push_back(item);
 						}
 					}
@@ -498,8 +499,8 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 						// Remove 1 amount
 						item.amount -= 1;
 						if (item.amount <= 0) {
-							ItemSystem::removeItemFromInventory(player_entity, item_to_remove);
-							ItemSystem::destroyItem(item_to_remove);
+							ItemSystem::removeItemFromInventory(world, player_entity, item_to_remove);
+							ItemSystem::destroyItem(registry, item_to_remove);
 						}
 
 						if (m_ui_system) {
@@ -508,7 +509,7 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 					}
 				}
 
-				ItemSystem::loadGameState();
+				ItemSystem::loadGameState(world);
 				screen.is_switching_biome = true;
 				screen.switching_to_biome = (GLuint)BIOME::GROTTO;
 				screen.from_biome = (GLuint)BIOME::GROTTO;
@@ -516,7 +517,7 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 				// we set screen.from_biome and screen.biome to the same from_biome on reload so we need to overide the biome with the latest one
 				screen.biome = last_biome;
 				screen.fade_status = 0;
-				registry.collisions.clear();
+				world.contacts.clear();
 				registry.damageFlashes.clear();
 				player.health = PLAYER_MAX_HEALTH; // reset to max health
 				for (auto effect : player.active_effects) {
@@ -531,101 +532,40 @@ void WorldSystem::handle_collisions(float elapsed_ms)
 				m_ui_system->updateEffectsBar();
 				m_ui_system->updateInventoryBar();
 			}
-			continue;
 		}
-		else if ((registry.ammo.has(collision_entity) || registry.ammo.has(collision.other)) && (registry.terrains.has(collision_entity) || registry.terrains.has(collision.other))) {
-			Entity ammo_entity = registry.ammo.has(collision_entity) ? collision_entity : collision.other;
-			Entity terrain_entity = registry.terrains.has(collision_entity) ? collision_entity : collision.other;
+	}
+
+	// then ammo reaching the terrain that stops it
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		const ContactEvent& event = events[i];
+		if (event.state != ContactState::BEGIN || registry.commands.is_destroyed(event.entity))
+			continue;
+
+		if (world.projectiles.flying(event.entity) && registry.terrains.has(event.other)) {
+			Entity ammo_entity = event.entity;
+			Entity terrain_entity = event.other;
 
 			if (registry.potions.has(ammo_entity) && registry.potions.get(ammo_entity).effect == PotionEffect::MOLOTOV && registry.motions.has(terrain_entity)) {
 				// damage all enemies within 100 px
 				vec2 terrain_pos = registry.motions.get(terrain_entity).position;
-				for (auto neighbour_enemy : registry.enemies.entities) {
-					if (!registry.motions.has(neighbour_enemy)) continue;
-					vec2 pos = registry.motions.get(neighbour_enemy).position;
-					float dx = pos.x - terrain_pos.x;
-					float dy = pos.y - terrain_pos.y;
-					if ((dx * dx + dy * dy) <= MOLOTOV_RADIUS_SQUARED) handleEnemyInjured(neighbour_enemy, registry.ammo.get(ammo_entity).damage);
-				}
+				int damage = world.projectiles.find(ammo_entity)->damage;
+				world.collision.queryRadius(terrain_pos, MOLOTOV_RADIUS, COLLISION_ENEMY, [&](Entity neighbour_enemy) {
+					handleEnemyInjured(neighbour_enemy, damage);
+				});
 			}
 
-			registry.remove_all_components_of(ammo_entity);
-			continue;
-		}
-	}
-
-	bool moving_diagonally = (original_position.x != previous_position.x) && (original_position.y != previous_position.y);
-
-	// Helper function to check collisions with all terrain entities for an updated position
-	// this takes in a test_position argument that will act as player's "new" position, 
-	// returns a boolean if there is a collision or not
-	auto checkCollisions = [](const vec2& test_position) {
-		for (Entity terrain_entity : registry.terrains.entities) {
-			if (!registry.motions.has(terrain_entity))
-				continue;
-
-			Motion& terrain_motion = registry.motions.get(terrain_entity);
-			Terrain& terrain = registry.terrains.get(terrain_entity);
-
-			vec2 orig_pos = registry.motions.get(registry.players.entities[0]).position;
-
-			// set our player's position to the test position
-			registry.motions.get(registry.players.entities[0]).position = test_position;
-
-			bool has_collision = PhysicsSystem::collides(registry.motions.get(registry.players.entities[0]),
-				terrain_motion, &terrain, terrain_entity);
-
-			// restore original position
-			registry.motions.get(registry.players.entities[0]).position = orig_pos;
-
-			if (has_collision)
-				return true;
-		}
-
-		return false;
-		};
-
-	if (moving_diagonally) {
-		// position as if we moved just horizontally
-		vec2 horizontal_pos = previous_position;
-		horizontal_pos.x = original_position.x;
-
-		// position as if we moved just vertically
-		vec2 vertical_pos = previous_position;
-		vertical_pos.y = original_position.y;
-
-		bool horizontal_collision = checkCollisions(horizontal_pos);
-		bool vertical_collision = checkCollisions(vertical_pos);
-		bool diagonal_collision = checkCollisions(original_position);
-
-		if (diagonal_collision) {
-			if (!horizontal_collision && !vertical_collision) {
-				player_motion.position = previous_position;
-			}
-			else if (!horizontal_collision) {
-				player_motion.position = horizontal_pos;
-			}
-			else if (!vertical_collision) {
-				player_motion.position = vertical_pos;
-			}
-			else {
-				player_motion.position = previous_position;
-			}
-		}
-		else {
-			// there's no collision with diagonal movement, allow player to move
-			player_motion.position = original_position;
-		}
-	}
-	else {
-		// For non-diagonal movement, just check if there's a collision
-		if (checkCollisions(original_position)) {
-			player_motion.position = previous_position;
+			world.projectiles.retire(ammo_entity);
 		}
 	}
 
-	// Clear collisions after processing
-	registry.collisions.clear();
+	// walk the player from where it was towards where it moved to, stopping at terrain and sliding along it
+	Motion previous_motion = player_motion;
+	previous_motion.position = previous_position;
+	vec4 player_box = get_bounding_box(previous_motion, 0.7f, 0.3f);
+	CollisionFilter* player_filter = registry.collisionFilters.find(player_entity);
+	unsigned int player_mask = player_filter ? player_filter->mask : 0;
+	player_motion.position = previous_position + world.collision.moveAndSlide(player_box, original_position - previous_position, player_mask);
 }
 
 // Should the game be over ?
@@ -686,7 +626,7 @@ void WorldSystem::on_key(int key, int scancode, int action, int mod)
 
 	if (action == GLFW_RELEASE && key == GLFW_KEY_P)
 	{
-		ItemSystem::saveGameState();
+		ItemSystem::saveGameState(world);
 	}
 
 	Entity player = registry.players.entities[0]; // Assume only one player entity
@@ -824,6 +764,14 @@ void WorldSystem::on_mouse_wheel(double xoffset, double yoffset)
 	}
 }
 
+void WorldSystem::on_char(unsigned int codepoint)
+{
+	// Pass typed text to the UI system if it's initialized
+	if (m_ui_system != nullptr) {
+		m_ui_system->handleTextInput(codepoint);
+	}
+}
+
 void WorldSystem::on_window_resize(int w, int h)
 {
 	int fbw, fbh;
@@ -996,7 +944,7 @@ bool WorldSystem::handle_item_pickup(Entity player, Entity item)
 		return false;
 
 	Item& item_info = registry.items.get(item);
-	if (!ItemSystem::addItemToInventory(player, item))
+	if (!ItemSystem::addItemToInventory(world, player, item))
 		return false;
 	SoundSystem::playCollectItemSound((int)SOUND_CHANNEL::GENERAL, 0);
 
@@ -1027,13 +975,13 @@ bool WorldSystem::handle_item_pickup(Entity player, Entity item)
 	}
 
 	if (item_info.canRespawn && item_info.isCollectable) {
-		RespawnSystem::getInstance().registerEntity(item, false);
+		world.respawns.registerEntity(item, false);
 
 		// Set a random respawn time (60-90 seconds)
 		float respawnTime = (rand() % 30000 + 60000);
 
 		if (!item_info.persistentID.empty()) {
-			RespawnSystem::getInstance().setRespawning(item_info.persistentID, respawnTime);
+			world.respawns.setRespawning(item_info.persistentID, respawnTime);
 		}
 	}
 
@@ -1042,6 +990,43 @@ bool WorldSystem::handle_item_pickup(Entity player, Entity item)
 	return true;
 }
 
+void WorldSystem::index_textboxes()
+{
+	ComponentContainer<Textbox>& textboxes = registry.textboxes;
+	if (!textboxes.remembers_removals_since(textboxes_indexed))
+	{
+		// too long ago to catch up from the logs
+		item_textboxes.clear();
+		textbox_items.clear();
+		textboxes_indexed = 0;
+		for (Entity textbox : textboxes.entities)
+		{
+			item_textboxes[textboxes.get(textbox).targetItem.id()] = textbox;
+			textbox_items[textbox.id()] = textboxes.get(textbox).targetItem;
+		}
+	}
+	else
+	{
+		for (Entity textbox : textboxes.removed_since(textboxes_indexed))
+		{
+			auto linked = textbox_items.find(textbox.id());
+			if (linked == textbox_items.end())
+				continue;
+			auto item = item_textboxes.find(linked->second.id());
+			if (item != item_textboxes.end() && item->second == textbox)
+				item_textboxes.erase(item);
+			textbox_items.erase(linked);
+		}
+		for (Entity textbox : textboxes.added_since(textboxes_indexed))
+		{
+			item_textboxes[textboxes.get(textbox).targetItem.id()] = textbox;
+			textbox_items[textbox.id()] = textboxes.get(textbox).targetItem;
+		}
+	}
+	// changes later in this frame are picked up next time
+	textboxes_indexed = registry.frame();
+}
+
 void WorldSystem::update_textbox_visibility()
 {
 	if (registry.players.entities.empty())
@@ -1053,46 +1038,48 @@ void WorldSystem::update_textbox_visibility()
 
 	Motion& player_motion = registry.motions.get(player);
 
+	index_textboxes();
+
 	for (Entity item : registry.items.entities)
 	{
 		if (!registry.items.has(item) || !registry.motions.has(item))
 			continue;
 
+		// Find the textbox linked to this item
+		auto linked = item_textboxes.find(item.id());
+		if (linked == item_textboxes.end())
+			continue;
+		Entity textboxEntity = linked->second;
+		if (!registry.textboxes.has(textboxEntity) || registry.textboxes.get(textboxEntity).targetItem != item)
+			continue;
+
 		Motion& item_motion = registry.motions.get(item);
 
 		float distance = glm::distance(player_motion.position, item_motion.position);
 
-		// Find the textbox linked to this item
-		for (Entity textboxEntity : registry.textboxes.entities)
-		{
-			if (registry.textboxes.get(textboxEntity).targetItem == item)
-			{
-				Textbox& textbox = registry.textboxes.get(textboxEntity);
-				bool shouldBeVisible = (distance < TEXTBOX_VISIBILITY_RADIUS);
+		Textbox& textbox = registry.textboxes.get(textboxEntity);
+		bool shouldBeVisible = (distance < TEXTBOX_VISIBILITY_RADIUS);
 
-				bool uiIsOpenForItem = false;
-				Item& item_info = registry.items.get(item);
-				if (registry.cauldrons.has(item) && m_ui_system->isCauldronOpen()) {
-					uiIsOpenForItem = true;
-				}
-				else if (registry.mortarAndPestles.has(item) && m_ui_system->isMortarPestleOpen()) {
-					uiIsOpenForItem = true;
-				}
-				else if (item_info.type == ItemType::RECIPE_BOOK && m_ui_system->isRecipeBookOpen()) {
-					uiIsOpenForItem = true;
-				}
-				else if (item_info.type == ItemType::CHEST && m_ui_system->isChestMenuOpen()) {
-					uiIsOpenForItem = true;
-				}
+		bool uiIsOpenForItem = false;
+		Item& item_info = registry.items.get(item);
+		if (registry.cauldrons.has(item) && m_ui_system->isCauldronOpen()) {
+			uiIsOpenForItem = true;
+		}
+		else if (registry.mortarAndPestles.has(item) && m_ui_system->isMortarPestleOpen()) {
+			uiIsOpenForItem = true;
+		}
+		else if (item_info.type == ItemType::RECIPE_BOOK && m_ui_system->isRecipeBookOpen()) {
+			uiIsOpenForItem = true;
+		}
+		else if (item_info.type == ItemType::CHEST && m_ui_system->isChestMenuOpen()) {
+			uiIsOpenForItem = true;
+		}
 
-				textbox.isVisible = shouldBeVisible && !uiIsOpenForItem;
+		textbox.isVisible = shouldBeVisible && !uiIsOpenForItem;
 
-				if (textbox.isVisible)
-				{
-					m_ui_system->textboxes[textboxEntity.id()] = textbox;
-				}
-				break;
-			}
+		if (textbox.isVisible)
+		{
+			m_ui_system->textboxes[textboxEntity.id()] = textbox;
 		}
 	}
 }
@@ -1110,13 +1097,13 @@ void WorldSystem::showTemporaryGuardianDialogue(Entity guardianEntity, const std
 		}
 	}
 
-	Entity temp = createTextbox(renderer, old_textbox_copy.pos, guardianEntity, message);
+	Entity temp = createTextbox(registry, renderer, old_textbox_copy.pos, guardianEntity, message);
 	if (m_ui_system) {
 		m_ui_system->textboxes[temp.id()] = registry.textboxes.get(temp);
 	}
 
 	// Recreate original textbox
-	Entity restored = Entity();
+	Entity restored = registry.create();
 	Textbox& new_tb = registry.textboxes.emplace(restored);
 	new_tb = old_textbox_copy;
 	new_tb.isVisible = false;
@@ -1141,7 +1128,7 @@ bool WorldSystem::handleGuardianUnlocking(Entity guardianEntity) {
 				// Remove potion from inventory
 				registry.items.get(itemEntity).amount -= 1;
 				if (registry.items.get(itemEntity).amount <= 0) {
-					ItemSystem::removeItemFromInventory(player, itemEntity);
+					ItemSystem::removeItemFromInventory(world, player, itemEntity);
 				}
 
 				ScreenState& screen = registry.screenStates.components[0];
@@ -1157,7 +1144,7 @@ bool WorldSystem::handleGuardianUnlocking(Entity guardianEntity) {
 					if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "mushroom") == screen.unlocked_biomes.end()) {
 						screen.unlocked_biomes.push_back("mushroom");
 					}
-					createForestToMushroom(renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, WINDOW_HEIGHT_PX - 40), "Mushroom Entrance");
+					createForestToMushroom(registry, renderer, vec2(GRID_CELL_WIDTH_PX * 2.1, WINDOW_HEIGHT_PX - 40), "Mushroom Entrance");
 				}
 				else if (registry.items.get(guardianEntity).type == ItemType::CRYSTAL_GUARDIAN)
 				{
@@ -1168,8 +1155,8 @@ bool WorldSystem::handleGuardianUnlocking(Entity guardianEntity) {
 					if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "crystal") == screen.unlocked_biomes.end()) {
 						screen.unlocked_biomes.push_back("crystal");
 					}
-					createForestExToCrystal(renderer, vec2(930, 665), "Forest Ex to Crystal");
-					createMushroomToCrystal(renderer, vec2(1220, 160), "Mushroom to Crystal");
+					createForestExToCrystal(registry, renderer, vec2(930, 665), "Forest Ex to Crystal");
+					createMushroomToCrystal(registry, renderer, vec2(1220, 160), "Mushroom to Crystal");
 
 				}
 				else if (registry.items.get(guardianEntity).type == ItemType::MASTER_POTION_PEDESTAL)
@@ -1178,10 +1165,10 @@ bool WorldSystem::handleGuardianUnlocking(Entity guardianEntity) {
 					if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "saved-grotto") == screen.unlocked_biomes.end()) {
 						screen.unlocked_biomes.push_back("saved-grotto");
 					}
-					createRejuvenationPotion(renderer);
+					createRejuvenationPotion(registry, renderer);
 					screen.play_ending = true; // initially play_ending (set to false later)
 					screen.saved_grotto = true; // this flag gets set so enemies don't spawn
-					createGlowEffect(renderer, false); // do initial grow at start
+					createGlowEffect(registry, renderer, false); // do initial grow at start
 				}
 
 				// remove textbox
@@ -1206,7 +1193,7 @@ bool WorldSystem::handleGuardianUnlocking(Entity guardianEntity) {
 				if (registry.items.has(guardianEntity)) {
 					Item& item = registry.items.get(guardianEntity);
 					if (item.type == ItemType::MASTER_POTION_PEDESTAL) {
-						createTextbox(renderer, vec2(558, 40), guardianEntity, "Congratulations, you've saved the grotto!");
+						createTextbox(registry, renderer, vec2(558, 40), guardianEntity, "Congratulations, you've saved the grotto!");
 					}
 				}
 
@@ -1295,10 +1282,7 @@ void WorldSystem::updatePlayerState(Entity& player, Motion& player_motion, float
 	// add any active speed boost
 	player_motion.velocity *= player_comp.speed_multiplier;
 
-	// move the character
-	player_motion.previous_position = player_motion.position;
-	float delta = elapsed_ms_since_last_update * TIME_UPDATE_FACTOR;
-	player_motion.position += delta * player_motion.velocity;
+	// the MotionSystem moves the character by this velocity
 
 	// update player's throwing cooldown
 	if (player_comp.cooldown > 0) {
@@ -1349,12 +1333,12 @@ bool WorldSystem::throwAmmo(vec2 target) {
 
 	Entity& item_entity = inventory.items[inventory.selection];
 
-	if (createFiredAmmo(renderer, target, item_entity, player_entity)) {
+	if (createFiredAmmo(world, renderer, target, item_entity, player_entity)) {
 		if (registry.items.has(item_entity)) {
 			Item& item = registry.items.get(item_entity);
 			item.amount -= 1;
 			if (item.amount == 0) {
-				ItemSystem::removeItemFromInventory(player_entity, item_entity);
+				ItemSystem::removeItemFromInventory(world, player_entity, item_entity);
 				if (inventory.selection + 1 > inventory.items.size()) inventory.selection = std::max(inventory.selection - 1, 0);
 			}
 		}
@@ -1369,25 +1353,6 @@ bool WorldSystem::throwAmmo(vec2 target) {
 
 }
 
-void WorldSystem::updateThrownAmmo(float elapsed_ms_since_last_update) {
-	for (auto& entity : registry.ammo.entities) {
-		if (!registry.motions.has(entity)) continue;
-
-		Ammo& ammo = registry.ammo.get(entity);
-		if (!ammo.is_fired) continue;
-
-		Motion& ammo_motion = registry.motions.get(entity);
-		ammo_motion.position += ammo_motion.velocity * elapsed_ms_since_last_update * THROW_UPDATE_FACTOR;
-		if (abs(ammo_motion.position.x - ammo.start_pos.x) > abs(ammo.target.x - ammo.start_pos.x)
-			|| abs(ammo_motion.position.y - ammo.start_pos.y) > abs(ammo.target.y - ammo.start_pos.y))
-			registry.remove_all_components_of(entity);
-
-		// make ammo rotate
-		ammo_motion.angle += 5.f;
-
-	}
-}
-
 void WorldSystem::updateFPS(float elapsed_ms)
 {
 	m_frame_time_sum -= m_frame_times[m_frame_time_index];
@@ -1472,14 +1437,14 @@ bool WorldSystem::consumePotion() {
 		}
 	}
 
-	Entity item_copy = ItemSystem::copyItem(selected_item);
+	Entity item_copy = ItemSystem::copyItem(registry, selected_item);
 
 	// decrement count in inventory
 	Item& item = registry.items.get(selected_item);
 	item.amount -= 1;
 	if (item.amount <= 0) {
-		ItemSystem::removeItemFromInventory(player_entity, selected_item);
-		ItemSystem::destroyItem(selected_item);
+		ItemSystem::removeItemFromInventory(world, player_entity, selected_item);
+		ItemSystem::destroyItem(registry, selected_item);
 	}
 
 	// add copy of item to player's active effects - health is instant so don't add to active_effects
@@ -1565,6 +1530,7 @@ void WorldSystem::removePotionEffect(Potion& potion, Entity player) {
 
 void WorldSystem::handleEnemyInjured(Entity enemy_entity, float damage = 0.f) {
 	if (registry.players.entities.size() == 0 || !enemy_entity) return;
+	if (registry.commands.is_destroyed(enemy_entity)) return; // already killed this frame
 	Player& player = registry.players.components[0];
 	ScreenState& screen = registry.screenStates.components[0];
 	Enemy& enemy = registry.enemies.get(enemy_entity);
@@ -1577,17 +1543,17 @@ void WorldSystem::handleEnemyInjured(Entity enemy_entity, float damage = 0.f) {
 		if (!enemy.persistentID.empty()) {
 			// Set a respawn timer between 120-180 seconds (longer than items)
 			float respawnTime = (rand() % 60000 + 120000);
-			RespawnSystem::getInstance().registerEntity(enemy_entity, false);
-			RespawnSystem::getInstance().setRespawning(enemy.persistentID, respawnTime);
+			world.respawns.registerEntity(enemy_entity, false);
+			world.respawns.setRespawning(enemy.persistentID, respawnTime);
 			std::cout << "Enemy " << enemy.name << " killed, will respawn in "
 				<< respawnTime / 1000.0f << " seconds" << std::endl;
 		}
 
 		if (enemy.name == "Ent") {
-			createCollectableIngredient(renderer, registry.motions.get(enemy_entity).position, ItemType::STORM_BARK, 1, false);
+			createCollectableIngredient(world, renderer, registry.motions.get(enemy_entity).position, ItemType::STORM_BARK, 1, false);
 		}
 		else if (enemy.name == "Mummy 1" || enemy.name == "Mummy 2") {
-			createCollectableIngredient(renderer, registry.motions.get(enemy_entity).position, ItemType::MUMMY_BANDAGES, 1, false);
+			createCollectableIngredient(world, renderer, registry.motions.get(enemy_entity).position, ItemType::MUMMY_BANDAGES, 1, false);
 		}
 
 		// add enemy name to killed_enemies for persistence
@@ -1595,7 +1561,7 @@ void WorldSystem::handleEnemyInjured(Entity enemy_entity, float damage = 0.f) {
 			screen.killed_enemies.push_back(enemy.name);
 		}
 
-		registry.remove_all_components_of(enemy_entity);
+		registry.commands.destroy(enemy_entity);
 	}
 	SoundSystem::playEnemyOuchSound((int)SOUND_CHANNEL::GENERAL, 0); // play enemy ouch sound
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 // stlib
 #include <vector>
 #include <random>
+#include <unordered_map>
 
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
@@ -21,7 +22,7 @@
 class WorldSystem
 {
 public:
-	WorldSystem();
+	explicit WorldSystem(World& world);
 
 	// creates main window
 	GLFWwindow* create_window();
@@ -62,8 +63,6 @@ public:
 
 	bool throwAmmo(vec2 target);
 
-	void updateThrownAmmo(float elapsed_ms_since_last_update);
-
 	void updateFPS(float elapsed_ms);
 
 	// Potion methods
@@ -82,10 +81,14 @@ private:
 	void on_mouse_button_pressed(int button, int action, int mods);
 	void on_mouse_wheel(double xoffset, double yoffset);
 	void on_window_resize(int w, int h);
+	void on_char(unsigned int codepoint);
 
 	// restart level
 	void restart_game(bool hard_reset);
 
+	World& world;
+	ECSRegistry& registry;
+
 	// OpenGL window handle
 	GLFWwindow* window;
 
@@ -102,6 +105,13 @@ private:
 	// user pressed keys
 	std::unordered_set<int> pressed_keys;
 
+	// The textbox of every item and the other way round, brought up to date from the textboxes added
+	// and removed since textboxes_indexed
+	std::unordered_map<unsigned int, Entity> item_textboxes;
+	std::unordered_map<unsigned int, Entity> textbox_items;
+	uint32_t textboxes_indexed = 0;
+	void index_textboxes();
+
 	// C++ random number generator
 	std::default_random_engine rng;
 	std::uniform_real_distribution<float> uniform_dist; // number between 0..1
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "tiny_ecs.hpp"
+
+// Records structural changes (adding/removing components, destroying entities) so systems can
+// request them while iterating containers, and applies them all at once in flush().
+// Flushing first removes components and destroys entities, visiting every affected container once,
+// then adds the recorded components. The result is the same as applying the commands in the order
+// they were recorded: removing a component cancels any emplace of it recorded before, and emplacing
+// onto an entity that has the component by then replaces it. Components recorded for an entity that
+// is destroyed in the same batch are dropped. Entities are created in and released to the pool given
+// on construction.
+class CommandBuffer
+{
+	EntityPool& pool;
+
+	struct PendingRemovals
+	{
+		ContainerInterface* container;
+		std::vector<Entity> entities;
+	};
+
+	std::vector<PendingRemovals> removals; // grouped by container, entries are kept to re-use their memory
+	std::vector<Entity> destroyed;
+	std::vector<Entity> destroy_marks; // by index, the destroyed entity holding it or null
+
+	struct PendingEmplacesBase
+	{
+		ContainerInterface* container;
+		explicit PendingEmplacesBase(ContainerInterface* container) : container(container) {}
+		virtual ~PendingEmplacesBase() = default;
+		virtual bool empty() const = 0;
+		virtual void cancel(Entity e) = 0;
+		virtual void apply(const EntityPool& pool) = 0;
+	};
+
+	// The components recorded for one container, kept by value in recording order
+	template <typename Component>
+	struct PendingEmplaces : PendingEmplacesBase
+	{
+		ComponentContainer<Component>& target;
+		std::vector<std::pair<Entity, Component>> entries;
+
+		explicit PendingEmplaces(ComponentContainer<Component>& target) : PendingEmplacesBase(&target), target(target) {}
+
+		bool empty() const override { return entries.empty(); }
+
+		void cancel(Entity e) override
+		{
+			entries.erase(std::remove_if(entries.begin(), entries.end(), [e](const std::pair<Entity, Component>& entry) {
+				return entry.first == e;
+			}), entries.end());
+		}
+
+		void apply(const EntityPool& pool) override
+		{
+			for (auto& [e, c] : entries)
+			{
+				if (!pool.is_alive(e))
+					continue;
+				if (Component* existing = target.find(e))
+				{
+					*existing = std::move(c);
+					if constexpr (!std::is_empty<Component>::value)
+						target.mark_modified(e);
+				}
+				else
+					target.insert(e, std::move(c));
+			}
+			entries.clear();
+		}
+	};
+
+	std::vector<std::unique_ptr<PendingEmplacesBase>> emplaces; // one per container, kept to re-use their memory
+
+	std::vector<Entity>& removals_for(ContainerInterface* container)
+	{
+		for (PendingRemovals& pending : removals)
+			if (pending.container == container)
+				return pending.entities;
+		removals.push_back({ container, {} });
+		return removals.back().entities;
+	}
+
+	PendingEmplacesBase* find_emplaces(ContainerInterface* container)
+	{
+		for (std::unique_ptr<PendingEmplacesBase>& pending : emplaces)
+			if (pending->container == container)
+				return pending.get();
+		return nullptr;
+	}
+
+public:
+	explicit CommandBuffer(EntityPool& pool) : pool(pool) {}
+
+	// A new entity handle, creating one does not touch any container so it happens right away.
+	// Its components can be added directly or through emplace()
+	Entity create() { return pool.create(); }
+
+	// Adds a Component constructed from args to e at the next flush, or replaces the one e has by then
+	template <typename Component, typename... Args>
+	void emplace(ComponentContainer<Component>& container, Entity e, Args&&... args)
+	{
+		PendingEmplacesBase* pending = find_emplaces(&container);
+		if (!pending)
+		{
+			emplaces.push_back(std::make_unique<PendingEmplaces<Component>>(container));
+			pending = emplaces.back().get();
+		}
+		static_cast<PendingEmplaces<Component>*>(pending)->entries.emplace_back(e, Component(std::forward<Args>(args)...));
+	}
+
+	// Removes the component of e from container at the next flush, including one emplace()d before
+	void remove(ContainerInterface& container, Entity e)
+	{
+		if (PendingEmplacesBase* pending = find_emplaces(&container))
+			pending->cancel(e);
+		removals_for(&container).push_back(e);
+	}
+
+	// Removes all components of e and recycles it at the next flush
+	void destroy(Entity e)
+	{
+		if (e == Entity::null() || is_destroyed(e))
+			return;
+		if (destroy_marks.size() <= e.index())
+			destroy_marks.resize(e.index() + 1, Entity::null());
+		destroy_marks[e.index()] = e;
+		destroyed.push_back(e);
+	}
+
+	// True if e is waiting to be destroyed, lets systems skip entities that are already gone for gameplay purposes
+	bool is_destroyed(Entity e) const
+	{
+		return e != Entity::null() && e.index() < destroy_marks.size() && destroy_marks[e.index()] == e;
+	}
+
+	bool empty() const
+	{
+		if (!destroyed.empty())
+			return false;
+		for (const PendingRemovals& pending : removals)
+			if (!pending.entities.empty())
+				return false;
+		for (const std::unique_ptr<PendingEmplacesBase>& pending : emplaces)
+			if (!pending->empty())
+				return false;
+		return true;
+	}
+
+	// Applies everything recorded so far. Destroying entities needs all_containers, indexed by signature bit,
+	// and the table those containers track signatures in (without one every container is asked with has()).
+	void flush(const std::vector<ContainerInterface*>& all_containers, const SignatureTable* signatures = nullptr)
+	{
+		for (Entity e : destroyed)
+		{
+			if (!signatures)
+			{
+				for (ContainerInterface* container : all_containers)
+					if (container->has(e))
+						removals_for(container).push_back(e);
+				continue;
+			}
+			if (!pool.is_alive(e))
+				continue; // the index may belong to another entity by now
+			for (Signature s = signatures->get(e); s != 0; s &= s - 1)
+				removals_for(all_containers[lowest_bit(s)]).push_back(e);
+		}
+
+		for (PendingRemovals& pending : removals)
+		{
+			if (pending.entities.empty())
+				continue;
+			pending.container->remove_batch(pending.entities);
+			pending.entities.clear();
+		}
+
+		for (Entity e : destroyed)
+		{
+			destroy_marks[e.index()] = Entity::null();
+			pool.release(e);
+		}
+		destroyed.clear();
+
+		for (std::unique_ptr<PendingEmplacesBase>& pending : emplaces)
+			pending->apply(pool);
+	}
+};
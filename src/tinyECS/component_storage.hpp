@@ -0,0 +1,184 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <assert.h>
+
+// Storage backends for the components of a ComponentContainer. Both keep the components in the
+// container's dense order, component i belongs to entities[i]. Besides indexing they provide the few
+// operations the container needs to keep that order in sync when removing and sorting:
+//   swap_remove(i)        - drop component i, the last component takes its position
+//   remove_if_index(drop) - drop every component i with drop(i), the others keep their order
+//   take(i), put(i, h), move_entry(to, from) - the moves of an in-place permutation
+
+// Components in one contiguous array, the fastest to iterate. Inserting can reallocate and removing
+// or sorting moves components, so references are only valid until the container changes.
+template <typename T>
+class DenseStorage : public std::vector<T>
+{
+public:
+	using Held = T;
+
+	void swap_remove(size_t i)
+	{
+		if (i != this->size() - 1)
+			(*this)[i] = std::move(this->back());
+		this->pop_back();
+	}
+
+	template <typename Drop>
+	void remove_if_index(Drop drop)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < this->size(); i++)
+		{
+			if (drop(i))
+				continue;
+			if (kept != i)
+				(*this)[kept] = std::move((*this)[i]);
+			kept++;
+		}
+		this->erase(this->begin() + kept, this->end());
+	}
+
+	Held take(size_t i) { return std::move((*this)[i]); }
+	void put(size_t i, Held&& held) { (*this)[i] = std::move(held); }
+	void move_entry(size_t to, size_t from) { (*this)[to] = std::move((*this)[from]); }
+};
+
+// Components in fixed-size chunks that are never moved or freed while the component lives: a
+// reference stays valid until that component is removed, whatever else is inserted, removed or sorted.
+// Freed slots go on a free list and are re-used by the next insert, chunks are kept until clear().
+// The dense order is a list of slots, so iterating costs one extra indirection per component.
+template <typename T, unsigned int CHUNK_SIZE = 256>
+class PagedStorage
+{
+public:
+	using value_type = T;
+	using Held = unsigned int; // the slot of a component, moving it around the dense order is free
+
+	PagedStorage() = default;
+	~PagedStorage() { clear(); }
+
+	// components are referenced by address, copies would silently break that
+	PagedStorage(const PagedStorage&) = delete;
+	PagedStorage& operator=(const PagedStorage&) = delete;
+
+	size_t size() const { return dense.size(); }
+	bool empty() const { return dense.empty(); }
+
+	T& operator[](size_t i) { return *slot(dense[i]); }
+	const T& operator[](size_t i) const { return *slot(dense[i]); }
+	T& front() { return (*this)[0]; }
+	T& back() { return (*this)[dense.size() - 1]; }
+
+	void push_back(T&& value)
+	{
+		if (free_slots.empty())
+			add_chunk();
+		unsigned int s = free_slots.back();
+		new (slot(s)) T(std::move(value));
+		free_slots.pop_back();
+		dense.push_back(s);
+	}
+
+	void swap_remove(size_t i)
+	{
+		release(dense[i]);
+		dense[i] = dense.back();
+		dense.pop_back();
+	}
+
+	template <typename Drop>
+	void remove_if_index(Drop drop)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < dense.size(); i++)
+		{
+			if (drop(i))
+				release(dense[i]);
+			else
+				dense[kept++] = dense[i];
+		}
+		dense.resize(kept);
+	}
+
+	Held take(size_t i) { return dense[i]; }
+	void put(size_t i, Held held) { dense[i] = held; }
+	void move_entry(size_t to, size_t from) { dense[to] = dense[from]; }
+
+	void clear()
+	{
+		for (unsigned int s : dense)
+			slot(s)->~T();
+		dense.clear();
+		free_slots.clear();
+		for (unsigned int c = (unsigned int)chunks.size(); c-- > 0;)
+			push_free_chunk(c);
+	}
+
+	// Iterates the components in dense order
+	template <typename Value, typename Storage>
+	class Iterator
+	{
+		Storage* storage;
+		size_t i;
+	public:
+		Iterator(Storage* storage, size_t i) : storage(storage), i(i) {}
+		Value& operator*() const { return (*storage)[i]; }
+		Value* operator->() const { return &(*storage)[i]; }
+		Iterator& operator++() { i++; return *this; }
+		bool operator==(const Iterator& other) const { return i == other.i; }
+		bool operator!=(const Iterator& other) const { return i != other.i; }
+	};
+	using iterator = Iterator<T, PagedStorage>;
+	using const_iterator = Iterator<const T, const PagedStorage>;
+
+	iterator begin() { return { this, 0 }; }
+	iterator end() { return { this, dense.size() }; }
+	const_iterator begin() const { return { this, 0 }; }
+	const_iterator end() const { return { this, dense.size() }; }
+
+private:
+	struct Chunk
+	{
+		alignas(T) unsigned char bytes[sizeof(T) * CHUNK_SIZE];
+	};
+
+	std::vector<std::unique_ptr<Chunk>> chunks;
+	std::vector<unsigned int> free_slots; // popped from the back, lowest slots first after a new chunk
+	std::vector<unsigned int> dense;      // slot of the i-th component
+
+	T* slot(unsigned int s) { return std::launder(reinterpret_cast<T*>(chunks[s / CHUNK_SIZE]->bytes) + s % CHUNK_SIZE); }
+	const T* slot(unsigned int s) const { return std::launder(reinterpret_cast<const T*>(chunks[s / CHUNK_SIZE]->bytes) + s % CHUNK_SIZE); }
+
+	void add_chunk()
+	{
+		chunks.emplace_back(new Chunk);
+		push_free_chunk((unsigned int)chunks.size() - 1);
+	}
+
+	void push_free_chunk(unsigned int c)
+	{
+		for (unsigned int s = (c + 1) * CHUNK_SIZE; s-- > c * CHUNK_SIZE;)
+			free_slots.push_back(s);
+	}
+
+	void release(unsigned int s)
+	{
+		slot(s)->~T();
+		free_slots.push_back(s);
+	}
+};
+
+// The storage backend of ComponentContainer<Component>. Specialize it to give a component type
+// stable addresses, e.g.
+//   template <> struct ComponentStorage<Item> { using type = PagedStorage<Item>; };
+// The specialization has to be visible before the container type is first used.
+template <typename Component>
+struct ComponentStorage
+{
+	using type = DenseStorage<Component>;
+};
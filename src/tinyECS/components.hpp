@@ -29,14 +29,6 @@ struct Motion
 	vec2 previous_position = { 0, 0 };
 };
 
-// Stucture to store collision information
-struct Collision
-{
-	// Note, the first object is stored in the ECS container.entities
-	Entity other; // the second object involved in the collision
-	Collision(Entity& other) { this->other = other; };
-};
-
 // Data structure for toggling debug mode
 struct Debug
 {
@@ -171,7 +163,7 @@ struct Cauldron
 	int colorElapsed = 0;             // Time in ms for color updates
 	int stirFlash = 0;                // Time remaining for stir flash
 	std::vector<Action> actions;      // Records player actions
-	Entity water;                     // We technically only need 1 of these globally but this was easier so whatever
+	Entity water = Entity::null();     // We technically only need 1 of these globally but this was easier so whatever
 	bool is_boiling = false;
 	int num_stirs = 0;
 	// If stir quality ever gets added, a penalty can be recorded here
@@ -204,6 +196,22 @@ struct Terrain
 	float height_ratio = 1.0f;
 };
 
+// The collision layers. An entity is on the layers in its CollisionFilter's layer bits and is tested
+// against the bodies on the layers in its mask bits.
+const unsigned int COLLISION_SOLID = 1u << 0;         // terrain that blocks walking
+const unsigned int COLLISION_AMMO_STOPPING = 1u << 1; // terrain thrown ammo stops at
+const unsigned int COLLISION_ENEMY = 1u << 2;         // enemies thrown ammo hits
+const unsigned int COLLISION_ENEMY_REACH = 1u << 3;   // the area around enemies that hurts the player
+const unsigned int COLLISION_PLAYER = 1u << 4;
+const unsigned int COLLISION_AMMO = 1u << 5;
+
+// Set by the factories in world_init.cpp, an entity without one collides with nothing
+struct CollisionFilter
+{
+	unsigned int layer = 0;
+	unsigned int mask = 0;
+};
+
 struct Entrance
 {
 	GLuint target_biome = 0;
@@ -211,7 +219,7 @@ struct Entrance
 
 struct Textbox
 {
-	Entity targetItem;		// The item this textbox belongs to
+	Entity targetItem = Entity::null(); // The item this textbox belongs to
 	bool isVisible = false; // Visibility of the textbox
 	std::string text;
 	vec2 pos;
@@ -250,11 +258,9 @@ struct Guardian {
 	bool received_potion = false;
 };
 
+// An item that can be thrown; once thrown, its flight is kept by the ProjectileSystem
 struct Ammo {
-	vec2 start_pos;
-	vec2 target; // mouse click direction at max of player's throwable radius
 	bool is_fired = false;
-	int damage = 0;
 };
 
 struct DecisionTreeNode {
@@ -1,36 +1,90 @@
 #pragma once
 
+#include <vector>
+#include <cstdint>
+#include <assert.h>
+
 // Unique identifier for all entities
+// A handle is 32 bits: the low INDEX_BITS are a slot index that gets recycled once the entity is
+// destroyed, the high bits are the generation of that slot. Destroying an entity bumps the
+// generation, so old copies of the handle no longer compare equal to the new occupant.
+// Handles are handed out by an EntityPool, a default constructed handle is null.
 class Entity
 {
+public:
+    static constexpr unsigned int INDEX_BITS = 20;
+    static constexpr unsigned int INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr unsigned int GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+private:
     unsigned int m_id;
-    static unsigned int id_count;   // defaults to 0 (invalid), need to init 1
+
+    constexpr explicit Entity(unsigned int id) : m_id(id) {}
+    friend class EntityPool;
 
 public:
 
-    Entity()
-    {
-        // ensure that each entity gets a unique ID
-        m_id = id_count++; // assign and increment
+    constexpr Entity() : m_id(0) {}
+
+    // The handle that never refers to an entity
+    static constexpr Entity null() { return Entity(0); }
+
+    constexpr operator unsigned int() const { return m_id; } // enables automatic casting to int
+
+    // Needed for persistence serialization
+    constexpr unsigned int id() const { return m_id; }
+
+    constexpr unsigned int index() const { return m_id & INDEX_MASK; }
+    constexpr unsigned int generation() const { return m_id >> INDEX_BITS; }
+
+    constexpr bool operator==(const Entity& other) const {
+        return m_id == other.m_id;
+    }
+    constexpr bool operator!=(const Entity& other) const {
+        return m_id != other.m_id;
     }
+};
 
-    /*
-    Entity(Entity& e)
+// Creates entities and recycles the indices of released ones. Every ECSRegistry has its own pool,
+// so registries used on different threads share nothing; a single pool is not thread safe.
+class EntityPool
+{
+    std::vector<uint16_t> generations = { 0 }; // current generation of every index handed out so far, index 0 is reserved for null
+    std::vector<unsigned int> free_list;       // indices of destroyed entities, ready for re-use
+
+public:
+    Entity create()
     {
-        m_id = e.m_id;
+        // re-use the slot of a destroyed entity if there is one, otherwise take a fresh index
+        unsigned int index;
+        if (!free_list.empty())
+        {
+            index = free_list.back();
+            free_list.pop_back();
+        }
+        else
+        {
+            index = (unsigned int)generations.size();
+            assert(index <= Entity::INDEX_MASK && "Out of entity indices, the index would run into the generation bits");
+            generations.push_back(0);
+        }
+        return Entity(index | ((unsigned int)generations[index] << Entity::INDEX_BITS));
     }
-    */
 
-    ~Entity()
+    // True if e is not null and has not been released since it was created
+    bool is_alive(Entity e) const
     {
+        unsigned int index = e.index();
+        return index != 0 && index < generations.size() && generations[index] == e.generation();
     }
 
-    operator unsigned int() { return m_id; } // enables automatic casting to int
-
-    // Needed for persistence serialization
-    unsigned int id() const { return m_id; }
-
-    bool operator==(const Entity& other) const {
-        return m_id == other.m_id;
+    // Marks e as destroyed and its index as re-usable. Releasing a stale or null handle does nothing.
+    void release(Entity e)
+    {
+        if (!is_alive(e))
+            return;
+        uint16_t& generation = generations[e.index()];
+        generation = (uint16_t)((generation + 1) & Entity::GENERATION_MASK);
+        free_list.push_back(e.index());
     }
-};
\ No newline at end of file
+};
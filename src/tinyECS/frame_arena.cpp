@@ -0,0 +1,112 @@
+// internal
+#include "frame_arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Offset of the first address at or after base + offset that is a multiple of alignment
+static size_t align_offset(const std::byte* base, size_t offset, size_t alignment)
+{
+	uintptr_t address = reinterpret_cast<uintptr_t>(base) + offset;
+	uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	return offset + (size_t)(aligned - address);
+}
+
+FrameArena::FrameArena(size_t capacity)
+	: block(new std::byte[capacity]), block_size(capacity)
+{
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+	size_t start = align_offset(block.get(), offset, alignment);
+	if (start + size <= block_size)
+	{
+		offset = start + size;
+		return block.get() + start;
+	}
+
+	// out of space for this frame, take from the overflow blocks until the next reset
+	size_t overflow_start = overflow_top ? align_offset(overflow_top, 0, alignment) : 0;
+	if (!overflow_top || overflow_start + size > overflow_left)
+	{
+		size_t overflow_size = std::max(block_size, size + alignment);
+		overflow.emplace_back(new std::byte[overflow_size]);
+		overflow_top = overflow.back().get();
+		overflow_left = overflow_size;
+		overflow_start = align_offset(overflow_top, 0, alignment);
+	}
+	void* p = overflow_top + overflow_start;
+	overflow_top += overflow_start + size;
+	overflow_left -= overflow_start + size;
+	overflow_used += overflow_start + size;
+	return p;
+}
+
+void FrameArena::deallocate(void* p, size_t size)
+{
+	// only the most recent allocation of the main block can be given back
+	std::byte* bytes = static_cast<std::byte*>(p);
+	if (bytes >= block.get() && bytes + size == block.get() + offset)
+		offset = bytes - block.get();
+}
+
+void FrameArena::reset()
+{
+	if (!overflow.empty())
+	{
+		// grow so the next frame like this one fits in the main block
+		block_size = std::max(block_size * 2, block_size + overflow_used);
+		block.reset(new std::byte[block_size]);
+		overflow.clear();
+		overflow_top = nullptr;
+		overflow_left = 0;
+		overflow_used = 0;
+	}
+	offset = 0;
+}
+
+FrameArena& frame_arena()
+{
+	static thread_local FrameArena arena;
+	return arena;
+}
+
+#ifdef COUNT_HEAP_ALLOCATIONS
+
+static thread_local size_t tls_heap_allocations = 0;
+
+// The array and nothrow forms of new and delete forward to these
+void* operator new(size_t size)
+{
+	tls_heap_allocations++;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+size_t heap_allocations()
+{
+	return tls_heap_allocations;
+}
+
+#else
+
+size_t heap_allocations()
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Linear allocator for data that only lives for one frame, e.g. the sorted draw list or the transformed
+// vertices of a collision test. Allocating bumps an offset into one block, freeing is a no-op (except
+// for the most recent allocation, so a growing vector re-uses its old space) and reset() drops
+// everything at once. When a frame needs more than the block, extra blocks are taken from the heap and
+// the next reset() replaces them with one block large enough for the whole frame, so after the first
+// few frames allocating from the arena never touches the heap.
+// Nothing allocated from the arena may be kept across reset(), and destructors are not run by reset().
+class FrameArena
+{
+public:
+	explicit FrameArena(size_t capacity = 64 * 1024);
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void* allocate(size_t size, size_t alignment);
+	void deallocate(void* p, size_t size);
+
+	// Frees everything allocated since the last reset
+	void reset();
+
+	size_t used() const { return offset + overflow_used; }
+	size_t capacity() const { return block_size; }
+
+private:
+	std::unique_ptr<std::byte[]> block;
+	size_t block_size;
+	size_t offset = 0;
+
+	// blocks taken when the main block ran out, merged into it by reset()
+	std::vector<std::unique_ptr<std::byte[]>> overflow;
+	std::byte* overflow_top = nullptr;
+	size_t overflow_left = 0;
+	size_t overflow_used = 0;
+};
+
+// The arena of the calling thread. The game loop resets the main thread's arena at the start of
+// every frame and has the JobSystem reset its workers' arenas; other threads have to reset theirs
+// themselves if they use it.
+FrameArena& frame_arena();
+
+// STL allocator handing out memory from a FrameArena, the calling thread's by default:
+//   FrameVector<Entity> entities;   // lives until the next frame_arena().reset()
+template <typename T>
+struct ArenaAllocator
+{
+	using value_type = T;
+
+	FrameArena* arena;
+
+	ArenaAllocator() : arena(&frame_arena()) {}
+	explicit ArenaAllocator(FrameArena& arena) : arena(&arena) {}
+	template <typename U> ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* p, size_t n) { arena->deallocate(p, n * sizeof(T)); }
+
+	template <typename U> bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+	template <typename U> bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+// Number of calls to the global operator new made by the calling thread so far. Only counted in builds
+// with COUNT_HEAP_ALLOCATIONS defined (the tests), always 0 otherwise. Compare two readings to check
+// that a piece of code does not allocate.
+size_t heap_allocations();
@@ -0,0 +1,127 @@
+// internal
+#include "job_system.hpp"
+#include "frame_arena.hpp"
+
+// Which JobSystem and queue the current thread works for, so nested submits go to the own queue
+static thread_local const JobSystem* tls_pool = nullptr;
+static thread_local unsigned int tls_queue = 0;
+// The reset_frame_arenas() count the current thread's frame arena was last reset for
+static thread_local unsigned int tls_arena_resets = 0;
+
+unsigned int JobSystem::default_worker_count()
+{
+	unsigned int hardware = std::thread::hardware_concurrency();
+	return hardware > 1 ? hardware - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned int worker_count)
+{
+	for (unsigned int i = 0; i < worker_count + 1; i++)
+		queues.push_back(std::make_unique<Queue>());
+	for (unsigned int i = 0; i < worker_count; i++)
+		workers.emplace_back(&JobSystem::worker_loop, this, i + 1);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		running = false;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+unsigned int JobSystem::own_queue() const
+{
+	return tls_pool == this ? tls_queue : 0;
+}
+
+void JobSystem::submit(Group& group, Job job)
+{
+	group.pending.fetch_add(1, std::memory_order_relaxed);
+	Queue& queue = *queues[own_queue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back({ std::move(job), &group });
+	}
+	queued.fetch_add(1, std::memory_order_release);
+	if (!workers.empty())
+	{
+		// taking the lock orders this with a worker that is about to sleep
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		wake.notify_one();
+	}
+}
+
+bool JobSystem::run_one(unsigned int self, bool between_jobs)
+{
+	Task task;
+	bool found = false;
+
+	// newest work from the own queue first, it is the most likely to be in cache
+	{
+		Queue& queue = *queues[self];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			found = true;
+		}
+	}
+	// then steal the oldest work of the others
+	for (unsigned int i = 1; !found && i < queues.size(); i++)
+	{
+		Queue& queue = *queues[(self + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			found = true;
+		}
+	}
+	if (!found)
+		return false;
+
+	queued.fetch_sub(1, std::memory_order_relaxed);
+	// checked once the task is taken, so a reset requested before the task was submitted is seen
+	unsigned int resets = arena_resets.load(std::memory_order_acquire);
+	if (between_jobs && resets != tls_arena_resets)
+	{
+		frame_arena().reset();
+		tls_arena_resets = resets;
+	}
+	task.job();
+	task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+	return true;
+}
+
+void JobSystem::wait(Group& group)
+{
+	unsigned int self = own_queue();
+	while (!group.done())
+	{
+		// help out instead of blocking, the remaining jobs may be running on other threads
+		if (!run_one(self))
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::worker_loop(unsigned int self)
+{
+	tls_pool = this;
+	tls_queue = self;
+	while (true)
+	{
+		if (run_one(self, true))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		wake.wait(lock, [this]() { return !running || queued.load(std::memory_order_acquire) > 0; });
+		if (!running)
+			return;
+	}
+}
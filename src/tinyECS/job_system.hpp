@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A pool of worker threads with one job queue per thread. A thread takes new work from the back of its
+// own queue and, when that is empty, steals from the front of the others. Threads waiting on a
+// JobGroup run queued jobs instead of blocking, so submitting from inside a job is fine.
+// With zero workers every job runs on the thread that waits for it.
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+
+	// Tracks a batch of jobs so their submitter can wait for all of them
+	class Group
+	{
+		std::atomic<unsigned int> pending{ 0 };
+		friend class JobSystem;
+	public:
+		bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	// Defaults to one worker per extra hardware thread, the thread creating the pool is the other one
+	explicit JobSystem(unsigned int worker_count = default_worker_count());
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	void submit(Group& group, Job job);
+
+	// Runs queued jobs until every job of group has finished
+	void wait(Group& group);
+
+	// Calls func(chunk_begin, chunk_end) over [begin, end) split into chunks of at least grain elements,
+	// returns once all chunks are done. Small ranges run directly on the calling thread.
+	template <typename Func>
+	void parallel_for(size_t begin, size_t end, size_t grain, Func func)
+	{
+		if (grain == 0) grain = 1;
+		size_t count = end > begin ? end - begin : 0;
+		if (workers.empty() || count <= grain)
+		{
+			if (count > 0) func(begin, end);
+			return;
+		}
+
+		// about four chunks per thread so stealing can even out uneven chunks
+		size_t chunks = std::min((count + grain - 1) / grain, (size_t)(workers.size() + 1) * 4);
+		size_t chunk_size = (count + chunks - 1) / chunks;
+		Group group;
+		for (size_t chunk_begin = begin + chunk_size; chunk_begin < end; chunk_begin += chunk_size)
+		{
+			size_t chunk_end = std::min(chunk_begin + chunk_size, end);
+			submit(group, [&func, chunk_begin, chunk_end]() { func(chunk_begin, chunk_end); });
+		}
+		func(begin, std::min(begin + chunk_size, end)); // the first chunk runs here
+		wait(group);
+	}
+
+	// Frees what the workers allocated from their frame arenas. A worker resets its arena before the
+	// next job it picks up, so call this at the frame boundary, when no job is running.
+	void reset_frame_arenas() { arena_resets.fetch_add(1, std::memory_order_release); }
+
+	unsigned int worker_count() const { return (unsigned int)workers.size(); }
+
+	static unsigned int default_worker_count();
+
+private:
+	struct Task
+	{
+		Job job;
+		Group* group;
+	};
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	// queues[0] is shared by all threads that are not workers, queues[i + 1] belongs to workers[i]
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+
+	std::atomic<bool> running{ true };
+	std::atomic<unsigned int> queued{ 0 }; // tasks sitting in any queue
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+	std::atomic<unsigned int> arena_resets{ 0 }; // reset_frame_arenas() calls so far
+
+	unsigned int own_queue() const;
+	// between_jobs: the thread holds nothing from an earlier job, so its frame arena may be reset
+	bool run_one(unsigned int self, bool between_jobs = false);
+	void worker_loop(unsigned int self);
+};
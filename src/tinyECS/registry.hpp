@@ -1,80 +1,183 @@
 #pragma once
 #include <vector>
+#include <tuple>
+#include <memory>
 
 #include "tiny_ecs.hpp"
+#include "command_buffer.hpp"
 #include "components.hpp"
 
+// Components that code keeps references to while inserting more of the same type (e.g. copying an
+// item, its ingredient, potion and ammo data) live in chunked pools with stable addresses.
+// They are small containers that are rarely iterated, so the extra indirection does not matter.
+template <> struct ComponentStorage<Item> { using type = PagedStorage<Item>; };
+template <> struct ComponentStorage<Ingredient> { using type = PagedStorage<Ingredient>; };
+template <> struct ComponentStorage<Potion> { using type = PagedStorage<Potion>; };
+template <> struct ComponentStorage<Inventory> { using type = PagedStorage<Inventory>; };
+template <> struct ComponentStorage<Player> { using type = PagedStorage<Player>; };
+template <> struct ComponentStorage<Enemy> { using type = PagedStorage<Enemy>; };
+
+// WorldSystem finds the textbox of an item through an index it keeps up to date from the textboxes
+// added and removed since it last looked.
+template <> struct TrackChanges<Textbox> : std::true_type {};
+
+// Every component type the game uses. A component's position in this list is its signature bit.
+using RegistryComponents = TypeList<
+	DeathTimer,
+	Motion,
+	Player,
+	Mesh*,
+	RenderRequest,
+	ScreenState,
+	DebugComponent,
+	vec3,
+	GridLine,
+	Potion,
+	Item,
+	Ingredient,
+	Inventory,
+	Cauldron,
+	Menu,
+	MortarAndPestle,
+	Terrain,
+	Entrance,
+	Textbox,
+	Animation,
+	Chest,
+	Enemy,
+	Guardian,
+	Ammo,
+	WelcomeScreen,
+	DamageFlash,
+	Regeneration,
+	TexturedEffect,
+	DelayedMovement,
+	CollisionFilter
+>;
+
 class ECSRegistry
 {
-	// callbacks to remove a particular or all entities in the system
+	// callbacks to remove a particular or all entities in the system, registry_list[i] owns signature bit i
 	std::vector<ContainerInterface*> registry_list;
 
+	// Hands out this registry's entities
+	EntityPool entity_pool;
+
+	// Which containers each entity is in
+	SignatureTable signatures;
+
+	// Current frame, advanced by the game loop through next_frame()
+	uint32_t frame_counter = 1;
+
+	// Storage for every container, looked up by component type through container<Component>()
+	ContainerTuple<RegistryComponents>::type containers;
+	static_assert(std::tuple_size<decltype(containers)>::value <= MAX_COMPONENT_TYPES, "Signature has too few bits for all component types");
+
 public:
-	ComponentContainer<DeathTimer> deathTimers;
-	ComponentContainer<Motion> motions;
-	ComponentContainer<Collision> collisions;
-	ComponentContainer<Player> players;
-	ComponentContainer<Mesh*> meshPtrs;
-	ComponentContainer<RenderRequest> renderRequests;
-	ComponentContainer<ScreenState> screenStates;
-	ComponentContainer<DebugComponent> debugComponents;
-	ComponentContainer<vec3> colors;
-	ComponentContainer<GridLine> gridLines;
+	ComponentContainer<DeathTimer>& deathTimers = container<DeathTimer>();
+	ComponentContainer<Motion>& motions = container<Motion>();
+	ComponentContainer<Player>& players = container<Player>();
+	ComponentContainer<Mesh*>& meshPtrs = container<Mesh*>();
+	ComponentContainer<RenderRequest>& renderRequests = container<RenderRequest>();
+	ComponentContainer<ScreenState>& screenStates = container<ScreenState>();
+	ComponentContainer<DebugComponent>& debugComponents = container<DebugComponent>();
+	ComponentContainer<vec3>& colors = container<vec3>();
+	ComponentContainer<GridLine>& gridLines = container<GridLine>();
 
 	// Enchanted Grotto CCs
-	ComponentContainer<Potion> potions;
-	ComponentContainer<Item> items;
-	ComponentContainer<Ingredient> ingredients;
-	ComponentContainer<Inventory> inventories;
-	ComponentContainer<Cauldron> cauldrons;
-	ComponentContainer<Menu> menus;
-	ComponentContainer<MortarAndPestle> mortarAndPestles;
-	ComponentContainer<Terrain> terrains;
-	ComponentContainer<Entrance> entrances;
-	ComponentContainer<Textbox> textboxes;
-	ComponentContainer<Animation> animations;
-	ComponentContainer<Chest> chests;
-	ComponentContainer<Enemy> enemies;
-	ComponentContainer<Guardian> guardians;
-	ComponentContainer<Ammo> ammo;
-	ComponentContainer<WelcomeScreen> welcomeScreens;
-	ComponentContainer<DamageFlash> damageFlashes;
-	ComponentContainer<Regeneration> regen;
-	ComponentContainer<TexturedEffect> texturedEffects;
-	ComponentContainer<DelayedMovement> delayedMovements;
-
-	// constructor that adds all containers for looping over them
+	ComponentContainer<Potion>& potions = container<Potion>();
+	ComponentContainer<Item>& items = container<Item>();
+	ComponentContainer<Ingredient>& ingredients = container<Ingredient>();
+	ComponentContainer<Inventory>& inventories = container<Inventory>();
+	ComponentContainer<Cauldron>& cauldrons = container<Cauldron>();
+	ComponentContainer<Menu>& menus = container<Menu>();
+	ComponentContainer<MortarAndPestle>& mortarAndPestles = container<MortarAndPestle>();
+	ComponentContainer<Terrain>& terrains = container<Terrain>();
+	ComponentContainer<Entrance>& entrances = container<Entrance>();
+	ComponentContainer<Textbox>& textboxes = container<Textbox>();
+	ComponentContainer<Animation>& animations = container<Animation>();
+	ComponentContainer<Chest>& chests = container<Chest>();
+	ComponentContainer<Enemy>& enemies = container<Enemy>();
+	ComponentContainer<Guardian>& guardians = container<Guardian>();
+	ComponentContainer<Ammo>& ammo = container<Ammo>();
+	ComponentContainer<WelcomeScreen>& welcomeScreens = container<WelcomeScreen>();
+	ComponentContainer<DamageFlash>& damageFlashes = container<DamageFlash>();
+	ComponentContainer<Regeneration>& regen = container<Regeneration>();
+	ComponentContainer<TexturedEffect>& texturedEffects = container<TexturedEffect>();
+	ComponentContainer<DelayedMovement>& delayedMovements = container<DelayedMovement>();
+	ComponentContainer<CollisionFilter>& collisionFilters = container<CollisionFilter>();
+
+	// Signature bit of a component type
+	template <typename Component>
+	static constexpr unsigned int component_bit() {
+		return TypeIndex<Component, RegistryComponents>::value;
+	}
+
+	// Signature with the bits of the listed component types set
+	template <typename... Components>
+	static constexpr Signature mask() {
+		return (Signature(0) | ... | (Signature(1) << component_bit<Components>()));
+	}
+
+	// Bitmask of the component types e has
+	Signature signature_of(Entity e) const {
+		return entity_pool.is_alive(e) ? signatures.get(e) : 0;
+	}
+
+	// Returns the container that stores components of type 'Component'
+	template <typename Component>
+	ComponentContainer<Component>& container() {
+		return std::get<ComponentContainer<Component>>(containers);
+	}
+
+	// Iterate all entities that have every listed component, optionally skipping those with others:
+	//   for (auto [entity, motion, terrain] : registry.view<Motion, Terrain>()) ...
+	//   registry.view<Motion>(exclude<Player>).each([](Entity entity, Motion& motion) { ... });
+	template <typename... Include, typename... Exclude>
+	View<TypeList<Include...>, TypeList<Exclude...>> view(TypeList<Exclude...> = {}) {
+		return View<TypeList<Include...>, TypeList<Exclude...>>(container<Include>()..., container<Exclude>()...);
+	}
+
+	// Iterate the members of the owning group of the listed component types, created on first use:
+	//   for (auto [entity, motion, render_request] : registry.group<Motion, RenderRequest>()) ...
+	// Owned types are packed in lockstep, observed types are looked up per member. A component type
+	// can be owned by one group only; the game's groups are created in the constructor.
+	template <typename... Owned, typename... Observed>
+	Group<TypeList<Owned...>, TypeList<Observed...>> group(TypeList<Observed...> = {}) {
+		return Group<TypeList<Owned...>, TypeList<Observed...>>(membership<TypeList<Owned...>, TypeList<Observed...>>(),
+			container<Owned>()..., container<Observed>()...);
+	}
+
+	// Structural changes requested while iterating, applied at the sync points of the game loop by flush_commands()
+	CommandBuffer commands{ entity_pool };
+
+	// A new entity without components. Entities belong to the registry that created them and are only
+	// valid in its containers.
+	Entity create() { return entity_pool.create(); }
+
+	// True if e was created by this registry and has not been destroyed since
+	bool is_alive(Entity e) const { return entity_pool.is_alive(e); }
+
+	// The frame changes to tracked containers are stamped with, starts at 1 so changed_since(0) sees everything
+	uint32_t frame() const { return frame_counter; }
+	void next_frame() { frame_counter++; }
+
+	// Avoid accidental copies, the named containers refer into this registry's storage
+	ECSRegistry(const ECSRegistry&) = delete;
+	ECSRegistry& operator=(const ECSRegistry&) = delete;
+
+	// constructor that adds all containers for looping over them, in the order of RegistryComponents
 	ECSRegistry()
 	{
-		registry_list.push_back(&deathTimers);
-		registry_list.push_back(&motions);
-		registry_list.push_back(&collisions);
-		registry_list.push_back(&players);
-		registry_list.push_back(&meshPtrs);
-		registry_list.push_back(&renderRequests);
-		registry_list.push_back(&screenStates);
-		registry_list.push_back(&debugComponents);
-		registry_list.push_back(&colors);
-		registry_list.push_back(&gridLines);
-		registry_list.push_back(&potions);
-		registry_list.push_back(&items);
-		registry_list.push_back(&ingredients);
-		registry_list.push_back(&inventories);
-		registry_list.push_back(&cauldrons);
-		registry_list.push_back(&menus);
-		registry_list.push_back(&mortarAndPestles);
-		registry_list.push_back(&terrains);
-		registry_list.push_back(&entrances);
-		registry_list.push_back(&textboxes);
-		registry_list.push_back(&animations);
-		registry_list.push_back(&chests);
-		registry_list.push_back(&enemies);
-		registry_list.push_back(&guardians);
-		registry_list.push_back(&ammo);
-		registry_list.push_back(&welcomeScreens);
-		registry_list.push_back(&damageFlashes);
-		registry_list.push_back(&regen);
-		registry_list.push_back(&texturedEffects);
+		std::apply([this](auto&... container) {
+			(register_container(container), ...);
+		}, containers);
+
+		// drawn entities: the renderer walks every motion with a render request
+		group<Motion, RenderRequest>();
+		// terrain with its motion, for building the terrain tree. Motion is packed for the renderer above, so
+		// this group owns Terrain only
+		group<Terrain>(observe<Motion>);
 	}
 
 	void clear_all_components() {
@@ -91,15 +194,60 @@ public:
 
 	void list_all_components_of(Entity e) {
 		printf("Debug info on components of entity %u:\n", (unsigned int)e);
-		for (ContainerInterface* reg : registry_list)
-			if (reg->has(e))
-				printf("type %s\n", typeid(*reg).name());
+		for (Signature s = signature_of(e); s != 0; s &= s - 1)
+			printf("type %s\n", typeid(*registry_list[lowest_bit(s)]).name());
 	}
 
+	void flush_commands() {
+		commands.flush(registry_list, &signatures);
+	}
+
+	// Destroys e: removes every component and recycles its index, copies of e become stale.
+	// Only the containers in e's signature are touched.
 	void remove_all_components_of(Entity e) {
-		for (ContainerInterface* reg : registry_list)
-			reg->remove(e);
+		for (Signature s = signature_of(e); s != 0; s &= s - 1)
+			registry_list[lowest_bit(s)]->remove(e);
+		entity_pool.release(e);
 	}
-};
 
-extern ECSRegistry registry;
\ No newline at end of file
+private:
+	// Membership of every group created so far by the mask of its owned types, kept at fixed addresses for
+	// the containers that report to them
+	std::vector<std::pair<Signature, std::unique_ptr<GroupMembership>>> groups;
+
+	template <typename OwnedList, typename ObservedList>
+	GroupMembership& membership() {
+		return membership_of(OwnedList{}, ObservedList{});
+	}
+
+	template <typename... Owned, typename... Observed>
+	GroupMembership& membership_of(TypeList<Owned...>, TypeList<Observed...>) {
+		constexpr Signature owned = mask<Owned...>();
+		constexpr Signature required = owned | mask<Observed...>();
+		for (auto& [owned_mask, group] : groups)
+			if (owned_mask == owned)
+			{
+				assert(group->mask() == required && "The owned types already belong to a group with other observed types");
+				return *group;
+			}
+
+		groups.emplace_back(owned, std::make_unique<GroupMembership>(required, std::vector<ContainerInterface*>{ &container<Owned>()... }, &signatures));
+		GroupMembership& group = *groups.back().second;
+		(container<Owned>().join_group(&group, true), ...);
+		(container<Observed>().join_group(&group, false), ...);
+
+		// pack the entities that are already complete, swaps only touch positions that were visited
+		using First = std::tuple_element_t<0, std::tuple<Owned...>>;
+		std::vector<Entity>& candidates = container<First>().entities;
+		for (size_t i = 0; i < candidates.size(); i++)
+			group.entered(candidates[i]);
+		return group;
+	}
+
+	void register_container(ContainerInterface& container) {
+		container.track_signatures(&signatures, (unsigned int)registry_list.size());
+		container.track_frame(&frame_counter);
+		container.track_entities(&entity_pool);
+		registry_list.push_back(&container);
+	}
+};
@@ -0,0 +1,53 @@
+// internal
+#include "scheduler.hpp"
+
+void SystemScheduler::add(std::string name, SystemAccess access, std::function<void()> run)
+{
+	systems.push_back({ std::move(name), access, std::move(run) });
+	stage_of.clear();
+}
+
+void SystemScheduler::sync(std::string name, std::function<void()> run)
+{
+	SystemAccess access;
+	access.exclusive = true;
+	add(std::move(name), access, std::move(run));
+}
+
+void SystemScheduler::build_stages()
+{
+	// a system goes one stage after the latest earlier system it conflicts with
+	stage_of.assign(systems.size(), 0);
+	stage_systems.clear();
+	for (size_t i = 0; i < systems.size(); i++)
+	{
+		for (size_t earlier = 0; earlier < i; earlier++)
+			if (systems[earlier].access.conflicts_with(systems[i].access))
+				stage_of[i] = std::max(stage_of[i], stage_of[earlier] + 1);
+
+		if (stage_systems.size() <= stage_of[i])
+			stage_systems.resize(stage_of[i] + 1);
+		stage_systems[stage_of[i]].push_back(i);
+	}
+}
+
+const std::vector<unsigned int>& SystemScheduler::stages()
+{
+	if (stage_of.size() != systems.size())
+		build_stages();
+	return stage_of;
+}
+
+void SystemScheduler::run_frame()
+{
+	stages();
+	for (const std::vector<size_t>& stage : stage_systems)
+	{
+		// exclusive systems always have a stage to themselves, they run right here
+		JobSystem::Group group;
+		for (size_t i = 1; i < stage.size(); i++)
+			jobs.submit(group, systems[stage[i]].run);
+		systems[stage[0]].run();
+		jobs.wait(group);
+	}
+}
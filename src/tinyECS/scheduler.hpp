@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "tiny_ecs.hpp"
+#include "job_system.hpp"
+
+// What a system touches: component containers by signature bit, plus whether it uses anything
+// outside of the registry that any system may use (UI, rendering, sound, the console, the command
+// buffer, ...). State outside the registry that no other non-exclusive system touches, e.g. the
+// system's own members, needs no declaration.
+struct SystemAccess
+{
+	Signature reads = 0;
+	Signature writes = 0;
+	bool exclusive = false; // runs on the main thread and never alongside another system
+
+	// True if the two systems can not run at the same time or in swapped order
+	bool conflicts_with(const SystemAccess& other) const
+	{
+		return exclusive || other.exclusive
+			|| (writes & (other.reads | other.writes)) != 0
+			|| (other.writes & reads) != 0;
+	}
+};
+
+// Runs the systems of a frame in the order they were added, but lets systems whose accesses do not
+// conflict run at the same time. A system only starts once every earlier system it conflicts with
+// has finished, so each frame gives the same result as running everything one after another.
+class SystemScheduler
+{
+public:
+	explicit SystemScheduler(JobSystem& jobs) : jobs(jobs) {}
+
+	void add(std::string name, SystemAccess access, std::function<void()> run);
+
+	// A point where everything before has finished and run() is called alone on the main thread,
+	// e.g. to flush deferred registry changes
+	void sync(std::string name, std::function<void()> run);
+
+	// Runs every system once
+	void run_frame();
+
+	// Stage of every system in the order they were added, systems in the same stage run concurrently
+	const std::vector<unsigned int>& stages();
+	const std::string& name(size_t system) const { return systems[system].name; }
+
+private:
+	struct System
+	{
+		std::string name;
+		SystemAccess access;
+		std::function<void()> run;
+	};
+
+	JobSystem& jobs;
+	std::vector<System> systems;
+	std::vector<unsigned int> stage_of;             // rebuilt lazily when systems change
+	std::vector<std::vector<size_t>> stage_systems; // systems of each stage
+
+	void build_stages();
+};
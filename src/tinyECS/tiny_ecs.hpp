@@ -3,14 +3,115 @@
 #include <algorithm>
 #include <vector>
 #include <unordered_map>
+#include <memory>
+#include <limits>
 #include <set>
+#include <tuple>
 #include <functional>
+#include <type_traits>
 #include <typeindex>
 #include <assert.h>
 #include <iostream>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #include "entity.hpp"
+#include "component_storage.hpp"
+#include "frame_arena.hpp"
 
+// Maps entity indices to indices into a dense array (the "sparse" half of a sparse set).
+// The id space is split into fixed-size pages that are only allocated once an id in
+// that range is used, so lookups are a shift, a mask and two loads - no hashing.
+class SparseIndex
+{
+public:
+	static constexpr unsigned int PAGE_SIZE = 4096; // entries per page, must be a power of two
+	static constexpr unsigned int NONE = std::numeric_limits<unsigned int>::max();
+
+	// Returns the dense index stored for id, or NONE
+	unsigned int find(unsigned int id) const
+	{
+		unsigned int page = id / PAGE_SIZE;
+		if (page >= pages.size() || !pages[page])
+			return NONE;
+		return pages[page][id & (PAGE_SIZE - 1)];
+	}
+
+	void set(unsigned int id, unsigned int index)
+	{
+		unsigned int page = id / PAGE_SIZE;
+		if (page >= pages.size())
+			pages.resize(page + 1);
+		if (!pages[page])
+		{
+			pages[page].reset(new unsigned int[PAGE_SIZE]);
+			std::fill_n(pages[page].get(), PAGE_SIZE, NONE);
+		}
+		pages[page][id & (PAGE_SIZE - 1)] = index;
+	}
+
+	void reset(unsigned int id)
+	{
+		unsigned int page = id / PAGE_SIZE;
+		if (page < pages.size() && pages[page])
+			pages[page][id & (PAGE_SIZE - 1)] = NONE;
+	}
+
+	void clear()
+	{
+		pages.clear();
+	}
+
+private:
+	std::vector<std::unique_ptr<unsigned int[]>> pages;
+};
+
+// Bitmask of the component types an entity has, bit i stands for the i-th container of the registry
+using Signature = uint64_t;
+constexpr unsigned int MAX_COMPONENT_TYPES = 64;
+
+// Position of the lowest set bit, s must not be 0
+inline unsigned int lowest_bit(Signature s)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, s);
+	return (unsigned int)index;
+#else
+	return (unsigned int)__builtin_ctzll(s);
+#endif
+}
+
+// The signature of every entity, indexed by entity index. Containers keep their bit up to date,
+// so a destroyed entity always leaves a zero signature behind for the next entity re-using the index.
+class SignatureTable
+{
+public:
+	Signature get(Entity e) const
+	{
+		return e.index() < signatures.size() ? signatures[e.index()] : 0;
+	}
+
+	void add(Entity e, Signature bits)
+	{
+		if (e.index() >= signatures.size())
+			signatures.resize(e.index() + 1, 0);
+		signatures[e.index()] |= bits;
+	}
+
+	void remove(Entity e, Signature bits)
+	{
+		if (e.index() < signatures.size())
+			signatures[e.index()] &= ~bits;
+	}
+
+private:
+	std::vector<Signature> signatures;
+};
+
+class GroupMembership;
 
 // Common interface to refer to all containers in the ECS registry
 struct ContainerInterface
@@ -18,20 +119,257 @@ struct ContainerInterface
 	virtual void clear() = 0;
 	virtual size_t size() = 0;
 	virtual void remove(Entity e) = 0;
+	virtual void remove_batch(const std::vector<Entity>& batch) = 0;
 	virtual bool has(Entity entity) = 0;
+
+	// Dense position of e or SparseIndex::NONE, and swapping two dense positions; groups pack their members with these
+	virtual unsigned int dense_index(Entity e) = 0;
+	virtual void swap_dense(unsigned int a, unsigned int b) = 0;
+
+	// Makes the container report inserts and removals to group, done by the registry.
+	// An owning group reorders the container, so a container can have only one owner.
+	void join_group(GroupMembership* group, bool owning)
+	{
+		assert(!(owning && owner) && "A component type can only be owned by one group");
+		if (owning) owner = group;
+		groups.push_back(group);
+	}
+
+	// Makes the container mirror its contents into bit 'bit' of the entity signatures, done by the registry
+	void track_signatures(SignatureTable* table, unsigned int bit)
+	{
+		assert(bit < MAX_COMPONENT_TYPES && "Too many component types for a Signature");
+		signatures = table;
+		signature_bit = Signature(1) << bit;
+	}
+
+	// Points the container at the frame counter its changes are stamped with, done by the registry
+	void track_frame(const uint32_t* counter)
+	{
+		frame = counter;
+	}
+
+	// Points the container at the pool its entities come from, so inserts can check them, done by the registry
+	void track_entities(const EntityPool* pool)
+	{
+		entity_pool = pool;
+	}
+
+protected:
+	SignatureTable* signatures = nullptr; // not tracked for containers outside of a registry
+	Signature signature_bit = 0;
+	const uint32_t* frame = nullptr;      // changes are stamped with frame 0 outside of a registry
+	std::vector<GroupMembership*> groups; // groups that include this component type, none outside of a registry
+	GroupMembership* owner = nullptr;     // the group that decides the order of the first components, if any
+	const EntityPool* entity_pool = nullptr; // only null is rejected outside of a registry
+
+	uint32_t current_frame() const { return frame ? *frame : 0; }
+	bool is_alive(Entity e) const { return entity_pool ? entity_pool->is_alive(e) : e != Entity::null(); }
+
+	// Called after e was added to and before e is removed from this container
+	void groups_entered(Entity e);
+	void groups_leaving(Entity e);
+	void groups_reset();
 };
 
-// A container that stores components of type 'Component' and associated entities
+// Which entities belong to an owning group. An entity is a member once it has every component
+// type of the group; the components of the members are kept at the front of each owned container
+// in the same order, so the i-th member has its components at position i of every owned container
+// and a loop over the group walks the owned arrays in lockstep without any lookups.
+// Membership is kept up to date by the containers on insert and remove, with a couple of swaps per
+// owned container. See ECSRegistry::group().
+class GroupMembership
+{
+public:
+	GroupMembership(Signature required, std::vector<ContainerInterface*> owned, const SignatureTable* signatures)
+		: required(required), owned(std::move(owned)), signatures(signatures) {}
+
+	Signature mask() const { return required; }
+	size_t size() const { return count; }
+
+	// Moves e into the group if it now has every component of it
+	void entered(Entity e)
+	{
+		if ((signatures->get(e) & required) != required || contains(e))
+			return;
+		for (ContainerInterface* container : owned)
+			container->swap_dense(container->dense_index(e), count);
+		count++;
+	}
+
+	// Moves e out of the group, the last member takes its place
+	void leaving(Entity e)
+	{
+		if (!contains(e))
+			return;
+		count--;
+		for (ContainerInterface* container : owned)
+			container->swap_dense(container->dense_index(e), count);
+	}
+
+	// One of the group's containers was cleared, nobody is a member any more
+	void reset() { count = 0; }
+
+private:
+	Signature required; // every component type of the group, owned or not
+	std::vector<ContainerInterface*> owned;
+	const SignatureTable* signatures;
+	unsigned int count = 0;
+
+	bool contains(Entity e) const
+	{
+		unsigned int position = owned.front()->dense_index(e);
+		return position != SparseIndex::NONE && position < count;
+	}
+};
+
+inline void ContainerInterface::groups_entered(Entity e)
+{
+	for (GroupMembership* group : groups)
+		group->entered(e);
+}
+
+inline void ContainerInterface::groups_leaving(Entity e)
+{
+	for (GroupMembership* group : groups)
+		group->leaving(e);
+}
+
+inline void ContainerInterface::groups_reset()
+{
+	for (GroupMembership* group : groups)
+		group->reset();
+}
+
+// Opt-in change tracking for a component type, e.g.
+//   template <> struct TrackChanges<Inventory> : std::true_type {};
+// A tracked container stamps every insert and every modify()/mark_modified() with the current frame
+// and logs removals, so a system can ask what changed since the frame it last ran instead of
+// re-checking every component. Untracked containers store and do nothing extra.
+template <typename Component>
+struct TrackChanges : std::false_type {};
+
+// How many frames of changes a tracked container keeps in its logs, queries reaching further back
+// fall back to looking at every component, and miss removals
+constexpr uint32_t CHANGE_HISTORY_FRAMES = 64;
+
+// One kind of change of a tracked container: the frame of the last change of every entity index,
+// indexed like the signatures so they never have to follow components around when the container is
+// re-packed, and a log of the changes in the order they happened. An entity is logged once per
+// frame, and only its latest entry counts, so the changes since a recent frame are read off the end
+// of the log without looking at the entities that did not change.
+struct StampLog
+{
+	struct Entry
+	{
+		Entity entity;
+		uint32_t frame;
+	};
+
+	static constexpr size_t NOT_LOGGED = ~size_t(0);
+
+	std::vector<uint32_t> frames; // frame of the last change, by entity index
+	std::vector<size_t> latest;   // position of the last change in the log, by entity index
+	std::vector<Entry> log;       // oldest first, sorted by frame
+	size_t dropped = 0;           // entries dropped from the front of the log, positions count them too
+
+	void stamp(Entity e, uint32_t frame)
+	{
+		unsigned int index = e.index();
+		if (index >= frames.size())
+		{
+			frames.resize(index + 1, 0);
+			latest.resize(index + 1, NOT_LOGGED);
+		}
+		size_t last = latest[index];
+		if (last != NOT_LOGGED && last >= dropped && log[last - dropped].entity == e && log[last - dropped].frame == frame)
+			return; // already changed this frame
+
+		// drop what is too old to be asked for before growing the log
+		if (!log.empty() && log.front().frame + CHANGE_HISTORY_FRAMES < frame)
+		{
+			auto first_kept = std::find_if(log.begin(), log.end(), [frame](const Entry& entry) {
+				return entry.frame + CHANGE_HISTORY_FRAMES >= frame;
+			});
+			dropped += first_kept - log.begin();
+			log.erase(log.begin(), first_kept);
+		}
+		frames[index] = frame;
+		latest[index] = dropped + log.size();
+		log.push_back({ e, frame });
+	}
+
+	// Calls func(entity) for the entities last changed in 'frame' or later, in the order of those
+	// changes. The entities may have lost the component since.
+	template <typename Func>
+	void each_since(uint32_t frame, Func func) const
+	{
+		auto first = std::lower_bound(log.begin(), log.end(), frame, [](const Entry& entry, uint32_t f) { return entry.frame < f; });
+		for (auto it = first; it != log.end(); ++it)
+			if (latest[it->entity.index()] == dropped + (it - log.begin()))
+				func(it->entity);
+	}
+
+	bool stamped_since(Entity e, uint32_t frame) const
+	{
+		return e.index() < frames.size() && frames[e.index()] >= frame;
+	}
+};
+
+// What changed in a tracked container
+struct ChangeLog
+{
+	StampLog added;    // inserts
+	StampLog modified; // inserts and modifications
+	std::vector<std::pair<Entity, uint32_t>> removed; // removals of the last CHANGE_HISTORY_FRAMES frames, oldest first
+
+	void log_removal(Entity e, uint32_t frame)
+	{
+		// drop what is too old to be asked for before growing the log
+		if (!removed.empty() && removed.front().second + CHANGE_HISTORY_FRAMES < frame)
+		{
+			auto first_kept = std::find_if(removed.begin(), removed.end(), [frame](const std::pair<Entity, uint32_t>& r) {
+				return r.second + CHANGE_HISTORY_FRAMES >= frame;
+			});
+			removed.erase(removed.begin(), first_kept);
+		}
+		removed.push_back({ e, frame });
+	}
+};
+
+// Stands in for the ChangeLog of untracked containers
+struct NoChangeLog {};
+
+// A container that stores components of type 'Component' and associated entities.
+// Components are kept in a dense order, the storage backend is picked with ComponentStorage<Component>.
+// Empty component types (tags) automatically get a TagContainer instead, see below.
+template <typename Component, bool IsTag = std::is_empty<Component>::value>
+class ComponentContainer;
+
 template <typename Component> // A component can be any class
-class ComponentContainer : public ContainerInterface
+class ComponentContainer<Component, false> : public ContainerInterface
 {
 private:
-	// The hash map from Entity -> array index.
-	std::unordered_map<unsigned int, unsigned int> map_entity_componentID; // the entity is cast to uint to be hashable.
+	// Entity index -> index into components/entities
+	SparseIndex sparse;
 	bool registered = false;
+
+	// Dense index of e's component or NONE, also NONE if e is an older generation of the stored entity
+	unsigned int index_of(Entity e) const {
+		unsigned int cID = sparse.find(e.index());
+		return (cID != SparseIndex::NONE && entities[cID] == e) ? cID : SparseIndex::NONE;
+	}
+
+	static constexpr bool tracked = TrackChanges<Component>::value;
+	std::conditional_t<tracked, ChangeLog, NoChangeLog> changes;
+
+	void log_removal(Entity e) {
+		if constexpr (tracked)
+			changes.log_removal(e, current_frame());
+	}
 public:
 	// Container of all components of type 'Component'
-	std::vector<Component> components;
+	typename ComponentStorage<Component>::type components;
 
 	// The corresponding entities
 	std::vector<Entity> entities;
@@ -46,10 +384,22 @@ public:
 	{
 		// Usually, every entity should only have one instance of each component type
 		assert(!(check_for_duplicates && has(e)) && "Entity already contained in ECS registry");
+		assert(is_alive(e) && "Adding a component to a destroyed or null entity");
 
-		map_entity_componentID[e] = (unsigned int)components.size();
+		sparse.set(e.index(), (unsigned int)components.size());
+		if (signatures) signatures->add(e, signature_bit);
+		if constexpr (tracked)
+		{
+			changes.added.stamp(e, current_frame());
+			changes.modified.stamp(e, current_frame());
+		}
 		components.push_back(std::move(c)); // the move enforces move instead of copy constructor
 		entities.push_back(e);
+		if (!groups.empty())
+		{
+			groups_entered(e); // may move the new component to the front
+			return components[sparse.find(e.index())];
+		}
 		return components.back();
 	};
 
@@ -65,42 +415,146 @@ public:
 
 	// A wrapper to return the component of an entity
 	Component& get(Entity e) {
-		if (!has(e)) std::cout << "Entity " << e.id() << " not in registry" << std::endl;
-		assert(has(e) && "Entity not contained in ECS registry");
-		return components[map_entity_componentID[e]];
+		unsigned int cID = index_of(e);
+		if (cID == SparseIndex::NONE) std::cout << "Entity " << e.index() << " (generation " << e.generation() << ") not in registry" << std::endl;
+		assert(cID != SparseIndex::NONE && "Entity not contained in ECS registry");
+		return components[cID];
+	}
+
+	// Returns the component of an entity or nullptr, a single lookup instead of has() followed by get()
+	Component* find(Entity e) {
+		unsigned int cID = index_of(e);
+		return cID == SparseIndex::NONE ? nullptr : &components[cID];
 	}
 
-	// Check if entity has a component of type 'Component'
+	// Check if entity has a component of type 'Component', stale handles to a recycled index never match
 	bool has(Entity entity) {
-		return map_entity_componentID.count(entity) > 0;
+		return index_of(entity) != SparseIndex::NONE;
+	}
+
+	// get() for writing: tracked containers record the change, untracked ones just return the component
+	Component& modify(Entity e) {
+		mark_modified(e);
+		return get(e);
+	}
+
+	// Records that e's component was changed in the current frame, for writes through get() or components
+	void mark_modified(Entity e) {
+		if constexpr (tracked)
+			if (has(e)) changes.modified.stamp(e, current_frame());
+	}
+
+	// Entities whose component was inserted or modified in 'frame' or later. A system passing the frame
+	// it last ran in sees every change since, plus possibly changes it already saw during that frame.
+	// Only the changes are looked at and come oldest first, unless 'frame' is more than
+	// CHANGE_HISTORY_FRAMES back: then every component is and they come in dense order.
+	// The list lives in the frame arena.
+	FrameVector<Entity> changed_since(uint32_t frame) const {
+		return stamped_since(frame, changes.modified);
+	}
+
+	// Entities whose component was inserted in 'frame' or later, like changed_since()
+	FrameVector<Entity> added_since(uint32_t frame) const {
+		return stamped_since(frame, changes.added);
+	}
+
+	// Entities that lost their component in 'frame' or later (and may have been given a new one since),
+	// oldest first. Only complete if remembers_removals_since(frame).
+	FrameVector<Entity> removed_since(uint32_t frame) const {
+		static_assert(tracked, "Change queries need TrackChanges<Component> to be specialized");
+		FrameVector<Entity> result;
+		auto first = std::lower_bound(changes.removed.begin(), changes.removed.end(), frame, [](const std::pair<Entity, uint32_t>& r, uint32_t f) {
+			return r.second < f;
+		});
+		for (auto it = first; it != changes.removed.end(); ++it)
+			result.push_back(it->first);
+		return result;
+	}
+
+	// False once 'frame' is more than CHANGE_HISTORY_FRAMES back, then removals may have been forgotten
+	bool remembers_removals_since(uint32_t frame) const {
+		return frame + CHANGE_HISTORY_FRAMES >= current_frame();
 	}
 
 	// Remove an component and pack the container to re-use the empty space
 	void remove(Entity e)
 	{
-		if (has(e))
-		{
-			// Get the current position
-			int cID = map_entity_componentID[e];
+		if (!groups.empty() && has(e))
+			groups_leaving(e);
 
-			// Move the last element to position cID using the move operator
-			// Note, components[cID] = components.back() would trigger the copy instead of move operator
-			components[cID] = std::move(components.back());
-			entities[cID] = entities.back(); // the entity is only a single index, copy it.
-			map_entity_componentID[entities.back()] = cID;
+		// Get the current position
+		unsigned int cID = index_of(e);
+		if (cID == SparseIndex::NONE)
+			return;
 
-			// Erase the old component and free its memory
-			map_entity_componentID.erase(e);
-			components.pop_back();
-			entities.pop_back();
-			// Note, one could mark the id for re-use
+		// Move the last element to position cID
+		if (cID != entities.size() - 1)
+		{
+			entities[cID] = entities.back(); // the entity is only a single index, copy it.
+			sparse.set(entities[cID].index(), cID);
 		}
+
+		// Erase the old component and free its memory
+		sparse.reset(e.index());
+		if (signatures) signatures->remove(e, signature_bit);
+		log_removal(e);
+		components.swap_remove(cID);
+		entities.pop_back();
 	};
 
+	// Remove the components of every entity in batch, compacting the container in a single pass.
+	// Unlike remove() the remaining components keep their relative order.
+	void remove_batch(const std::vector<Entity>& batch)
+	{
+		if (batch.size() == 1)
+			return remove(batch[0]);
+
+		// mark the slots to drop with the null entity, it is never stored otherwise
+		// group members are moved out of the group first, compacting keeps the remaining members in front
+		bool any_removed = false;
+		for (Entity e : batch)
+		{
+			if (!groups.empty() && has(e))
+				groups_leaving(e);
+			unsigned int cID = index_of(e);
+			if (cID == SparseIndex::NONE)
+				continue;
+			sparse.reset(e.index());
+			if (signatures) signatures->remove(e, signature_bit);
+			log_removal(e);
+			entities[cID] = Entity::null();
+			any_removed = true;
+		}
+		if (!any_removed)
+			return;
+
+		components.remove_if_index([this](size_t i) { return entities[i] == Entity::null(); });
+		unsigned int kept = 0;
+		for (unsigned int i = 0; i < entities.size(); i++)
+		{
+			if (entities[i] == Entity::null())
+				continue;
+			if (kept != i)
+			{
+				entities[kept] = entities[i];
+				sparse.set(entities[kept].index(), kept);
+			}
+			kept++;
+		}
+		entities.erase(entities.begin() + kept, entities.end());
+	}
+
 	// Remove all components of type 'Component'
 	void clear()
 	{
-		map_entity_componentID.clear();
+		if (signatures)
+			for (Entity e : entities)
+				signatures->remove(e, signature_bit);
+		if constexpr (tracked)
+			for (Entity e : entities)
+				log_removal(e);
+		groups_reset();
+		sparse.clear();
 		components.clear();
 		entities.clear();
 	}
@@ -111,18 +565,394 @@ public:
 		return components.size();
 	}
 
-	// Sort the components and associated entity assignment structures by the comparisonFunction, see std::sort
+	unsigned int dense_index(Entity e)
+	{
+		return index_of(e);
+	}
+
+	void swap_dense(unsigned int a, unsigned int b)
+	{
+		if (a == b)
+			return;
+		auto held = components.take(a);
+		components.move_entry(a, b);
+		components.put(b, std::move(held));
+		std::swap(entities[a], entities[b]);
+		sparse.set(entities[a].index(), a);
+		sparse.set(entities[b].index(), b);
+	}
+
+	// Sort the components and associated entity assignment structures by the comparisonFunction, see std::sort.
+	// The comparison receives entities and may call get(), the container is only rearranged once the order is known.
 	template <class Compare>
 	void sort(Compare comparisonFunction)
 	{
-		// First sort the entity list as desired
-		std::sort(entities.begin(), entities.end(), comparisonFunction);
-		// Now re-arrange the components (Note, creates a new vector, which may be slow! Not sure if in-place could be faster: https://stackoverflow.com/questions/63703637/how-to-efficiently-permute-an-array-in-place-using-stdswap)
-		std::vector<Component> components_new; components_new.reserve(components.size());
-		std::transform(entities.begin(), entities.end(), std::back_inserter(components_new), [&](Entity e) { return std::move(get(e)); }); // note, the get still uses the old hash map (on purpose!)
-		components = std::move(components_new); // note, we use move operations to not create unneccesary copies of objects, but memory is still allocated for the new vector
-		// Fill the new hashmap
+		assert(!owner && "Sorting would break the order of the owning group");
+		reset_order();
+		std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+			return comparisonFunction(entities[a], entities[b]);
+		});
+		apply_order();
+	}
+
+	// Sort by keys[i], the key of the i-th component (e.g. a depth or a spatial cell computed beforehand).
+	// Equal keys keep their current relative order.
+	template <typename Key>
+	void sort_by_key(const std::vector<Key>& keys)
+	{
+		assert(keys.size() == components.size() && "One key per component is needed");
+		assert(!owner && "Sorting would break the order of the owning group");
+		reset_order();
+		std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+			return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b);
+		});
+		apply_order();
+	}
+
+private:
+	FrameVector<Entity> stamped_since(uint32_t frame, const StampLog& stamps) const {
+		static_assert(tracked, "Change queries need TrackChanges<Component> to be specialized");
+		FrameVector<Entity> result;
+		// the log may have dropped changes that old, every component has to be looked at
+		if (frame + CHANGE_HISTORY_FRAMES < current_frame())
+		{
+			for (Entity e : entities)
+				if (stamps.stamped_since(e, frame))
+					result.push_back(e);
+			return result;
+		}
+		stamps.each_since(frame, [&](Entity e) {
+			if (index_of(e) != SparseIndex::NONE)
+				result.push_back(e);
+		});
+		return result;
+	}
+
+	// Scratch space for sorting, kept between calls so sorting every frame does not allocate
+	std::vector<unsigned int> order;
+
+	void reset_order()
+	{
+		order.resize(components.size());
+		for (unsigned int i = 0; i < order.size(); i++)
+			order[i] = i;
+	}
+
+	// Moves the component at order[i] to position i by following the cycles of the permutation,
+	// each element is moved once and only one component is held outside the container at a time
+	void apply_order()
+	{
+		for (unsigned int start = 0; start < order.size(); start++)
+		{
+			if (order[start] == start)
+				continue;
+			auto held = components.take(start);
+			Entity held_entity = entities[start];
+			unsigned int hole = start;
+			while (order[hole] != start)
+			{
+				unsigned int next = order[hole];
+				components.move_entry(hole, next);
+				entities[hole] = entities[next];
+				order[hole] = hole; // done
+				hole = next;
+			}
+			components.put(hole, std::move(held));
+			entities[hole] = held_entity;
+			order[hole] = hole;
+		}
+		// Point the sparse index at the new positions
 		for (unsigned int i = 0; i < entities.size(); i++)
-			map_entity_componentID[entities[i]] = i;
+			sparse.set(entities[i].index(), i);
+	}
+};
+
+// Membership of entities in an empty component type, e.g. Chest or DebugComponent. A tag has no
+// data, so instead of storing one component per entity this keeps a bit per entity index plus the
+// packed list of tagged entities for iteration. has() is a bit test (plus a handle compare when the
+// bit is set), insert and remove are O(1) and nothing is allocated per entity.
+// The tagged entities are not kept in insertion order, removing swaps the last one into the gap.
+template <typename Tag>
+class TagContainer : public ContainerInterface
+{
+	static_assert(std::is_empty<Tag>::value, "Only empty types can be stored as tags");
+
+	std::vector<uint64_t> bits;          // bit i is set if the entity with index i is tagged
+	std::vector<unsigned int> positions; // position in entities of a tagged entity index
+	Tag tag;                             // what get() hands out, tags have no per-entity state
+
+	bool test(unsigned int index) const {
+		return index / 64 < bits.size() && (bits[index / 64] >> (index % 64) & 1);
+	}
+
+public:
+	// The tagged entities
+	std::vector<Entity> entities;
+
+	Tag& insert(Entity e, Tag = {}, bool check_for_duplicates = true)
+	{
+		assert(!(check_for_duplicates && has(e)) && "Entity already contained in ECS registry");
+		assert(is_alive(e) && "Adding a component to a destroyed or null entity");
+		if (has(e))
+			return tag;
+
+		unsigned int index = e.index();
+		if (index / 64 >= bits.size())
+			bits.resize(index / 64 + 1, 0);
+		if (index >= positions.size())
+			positions.resize(index + 1);
+		bits[index / 64] |= uint64_t(1) << (index % 64);
+		positions[index] = (unsigned int)entities.size();
+		entities.push_back(e);
+		if (signatures) signatures->add(e, signature_bit);
+		groups_entered(e);
+		return tag;
+	}
+
+	template<typename... Args>
+	Tag& emplace(Entity e, Args&&...) { return insert(e); }
+	template<typename... Args>
+	Tag& emplace_with_duplicates(Entity e, Args&&...) { return insert(e, {}, false); }
+
+	Tag& get(Entity e) {
+		assert(has(e) && "Entity not contained in ECS registry");
+		return tag;
+	}
+
+	Tag* find(Entity e) { return has(e) ? &tag : nullptr; }
+
+	// The bit answers for the entity index, comparing the stored handle rejects stale generations
+	bool has(Entity e) { return test(e.index()) && entities[positions[e.index()]] == e; }
+
+	void remove(Entity e)
+	{
+		if (!has(e))
+			return;
+		groups_leaving(e);
+		unsigned int index = e.index();
+		unsigned int position = positions[index];
+		entities[position] = entities.back();
+		positions[entities[position].index()] = position;
+		entities.pop_back();
+		bits[index / 64] &= ~(uint64_t(1) << (index % 64));
+		if (signatures) signatures->remove(e, signature_bit);
+	}
+
+	void remove_batch(const std::vector<Entity>& batch)
+	{
+		for (Entity e : batch)
+			remove(e);
+	}
+
+	void clear()
+	{
+		if (signatures)
+			for (Entity e : entities)
+				signatures->remove(e, signature_bit);
+		groups_reset();
+		bits.clear();
+		positions.clear();
+		entities.clear();
+	}
+
+	size_t size() { return entities.size(); }
+
+	unsigned int dense_index(Entity e) { return has(e) ? positions[e.index()] : SparseIndex::NONE; }
+
+	void swap_dense(unsigned int a, unsigned int b)
+	{
+		std::swap(entities[a], entities[b]);
+		positions[entities[a].index()] = a;
+		positions[entities[b].index()] = b;
+	}
+};
+
+template <typename Tag>
+class ComponentContainer<Tag, true> : public TagContainer<Tag> {};
+
+// A compile-time list of component types
+template <typename... Components>
+struct TypeList {};
+
+// Position of T in a TypeList, e.g. TypeIndex<Motion, TypeList<Player, Motion>>::value == 1
+template <typename T, typename List>
+struct TypeIndex;
+
+template <typename T, typename... Rest>
+struct TypeIndex<T, TypeList<T, Rest...>> : std::integral_constant<unsigned int, 0> {};
+
+template <typename T, typename First, typename... Rest>
+struct TypeIndex<T, TypeList<First, Rest...>> : std::integral_constant<unsigned int, 1 + TypeIndex<T, TypeList<Rest...>>::value> {};
+
+// std::tuple<ComponentContainer<Components>...> for a TypeList of components
+template <typename List>
+struct ContainerTuple;
+
+template <typename... Components>
+struct ContainerTuple<TypeList<Components...>>
+{
+	using type = std::tuple<ComponentContainer<Components>...>;
+};
+
+// Components a view should skip, e.g. registry.view<Motion>(exclude<Player>)
+template <typename... Components>
+inline constexpr TypeList<Components...> exclude{};
+
+template <typename Include, typename Exclude>
+class View;
+
+// Iterates all entities that have every 'Include' component and none of the 'Exclude' components,
+// handing out references to the included components directly.
+// The entities of the smallest included container are walked in their dense order (ties go to the
+// first listed type), so iteration order is deterministic. Adding or removing any of the viewed
+// component types while iterating is not supported.
+template <typename... Include, typename... Exclude>
+class View<TypeList<Include...>, TypeList<Exclude...>>
+{
+	static_assert(sizeof...(Include) > 0, "A view needs at least one component type to iterate");
+
+	std::tuple<ComponentContainer<Include>*...> included;
+	std::tuple<ComponentContainer<Exclude>*...> excluded;
+	const std::vector<Entity>* candidates = nullptr;
+
+	// Looks up every included component of e, stops at the first one that is missing
+	bool fetch(Entity e, std::tuple<Include*...>& out) const
+	{
+		return ((std::get<Include*>(out) = std::get<ComponentContainer<Include>*>(included)->find(e)) && ...)
+			&& !(std::get<ComponentContainer<Exclude>*>(excluded)->has(e) || ...);
+	}
+
+public:
+	View(ComponentContainer<Include>&... include, ComponentContainer<Exclude>&... exclude)
+		: included(&include...), excluded(&exclude...)
+	{
+		// drive the iteration with the smallest container
+		((candidates = (!candidates || include.entities.size() < candidates->size()) ? &include.entities : candidates), ...);
+	}
+
+	class iterator
+	{
+		const View* view;
+		size_t index;
+		std::tuple<Include*...> current;
+
+		void skip_mismatches()
+		{
+			while (index < view->candidates->size() && !view->fetch((*view->candidates)[index], current))
+				index++;
+		}
+
+	public:
+		iterator(const View* view, size_t index) : view(view), index(index) { skip_mismatches(); }
+
+		// Structured binding friendly: for (auto [entity, motion, terrain] : registry.view<Motion, Terrain>())
+		std::tuple<Entity, Include&...> operator*() const
+		{
+			return std::tuple<Entity, Include&...>((*view->candidates)[index], *std::get<Include*>(current)...);
+		}
+
+		iterator& operator++()
+		{
+			index++;
+			skip_mismatches();
+			return *this;
+		}
+
+		bool operator==(const iterator& other) const { return index == other.index; }
+		bool operator!=(const iterator& other) const { return index != other.index; }
+	};
+
+	iterator begin() const { return iterator(this, 0); }
+	iterator end() const { return iterator(this, candidates->size()); }
+
+	// Calls func(entity, include_components&...) for every matching entity
+	template <typename Func>
+	void each(Func func) const
+	{
+		std::tuple<Include*...> current;
+		for (size_t i = 0; i < candidates->size(); i++)
+		{
+			Entity e = (*candidates)[i];
+			if (fetch(e, current))
+				func(e, *std::get<Include*>(current)...);
+		}
+	}
+
+	// Upper bound on the number of matching entities
+	size_t size_hint() const { return candidates->size(); }
+};
+
+// Component types a group looks up instead of owning, e.g. registry.group<Terrain>(observe<Motion>)
+template <typename... Components>
+inline constexpr TypeList<Components...> observe{};
+
+template <typename Owned, typename Observed>
+class Group;
+
+// Iterates the members of an owning group, see GroupMembership. The owned components of the i-th
+// member are at position i of their containers, observed components are looked up by entity.
+// Members are walked in the order of the owned containers. Adding or removing any of the group's
+// component types while iterating is not supported.
+template <typename... Owned, typename... Observed>
+class Group<TypeList<Owned...>, TypeList<Observed...>>
+{
+	static_assert(sizeof...(Owned) > 0, "A group needs at least one owned component type");
+	static_assert(!(std::is_empty<Owned>::value || ...), "Tags have no components to pack, observe them instead");
+
+	using First = std::tuple_element_t<0, std::tuple<Owned...>>;
+
+	std::tuple<ComponentContainer<Owned>*...> owned;
+	std::tuple<ComponentContainer<Observed>*...> observed;
+	const GroupMembership* membership;
+
+public:
+	Group(const GroupMembership& membership, ComponentContainer<Owned>&... own, ComponentContainer<Observed>&... obs)
+		: owned(&own...), observed(&obs...), membership(&membership) {}
+
+	size_t size() const { return membership->size(); }
+
+	// The i-th member
+	Entity entity(size_t i) const { return std::get<ComponentContainer<First>*>(owned)->entities[i]; }
+
+	class iterator
+	{
+		const Group* group;
+		size_t index;
+
+	public:
+		iterator(const Group* group, size_t index) : group(group), index(index) {}
+
+		// Structured binding friendly: for (auto [entity, terrain, motion] : registry.group<Terrain>(observe<Motion>))
+		std::tuple<Entity, Owned&..., Observed&...> operator*() const
+		{
+			Entity e = group->entity(index);
+			return std::tuple<Entity, Owned&..., Observed&...>(e,
+				std::get<ComponentContainer<Owned>*>(group->owned)->components[index]...,
+				std::get<ComponentContainer<Observed>*>(group->observed)->get(e)...);
+		}
+
+		iterator& operator++()
+		{
+			index++;
+			return *this;
+		}
+
+		bool operator==(const iterator& other) const { return index == other.index; }
+		bool operator!=(const iterator& other) const { return index != other.index; }
+	};
+
+	iterator begin() const { return iterator(this, 0); }
+	iterator end() const { return iterator(this, size()); }
+
+	// Calls func(entity, owned_components&..., observed_components&...) for every member
+	template <typename Func>
+	void each(Func func) const
+	{
+		for (size_t i = 0; i < size(); i++)
+		{
+			Entity e = entity(i);
+			func(e, std::get<ComponentContainer<Owned>*>(owned)->components[i]...,
+				std::get<ComponentContainer<Observed>*>(observed)->get(e)...);
+		}
 	}
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "tinyECS/registry.hpp"
+#include "systems/respawn_system.hpp"
+#include "systems/collision_world.hpp"
+#include "systems/contact_manager.hpp"
+#include "systems/projectile_system.hpp"
+
+class UISystem;
+
+// Everything one simulated world owns: its entities and components, and the world state that lives
+// outside of the registry. Systems and factories are handed the world (or just its registry) they
+// work on. Worlds share no state, entity ids included, so each can be simulated on its own thread
+// with its own systems. The renderer, UI and sound are process-wide and only drive the world shown
+// in the window.
+struct World
+{
+	ECSRegistry registry;
+	RespawnSystem respawns;
+	// collision queries against the current biome's terrain and the enemies
+	CollisionWorld collision;
+	// the contacts the physics step found, with what changed since the step before
+	ContactManager contacts;
+	// thrown ammo in flight, and the entities of landed throws kept for the next ones
+	ProjectileSystem projectiles;
+
+	// UI showing this world, null for worlds simulated without a window
+	UISystem* ui = nullptr;
+
+	World() : respawns(*this), projectiles(registry, contacts) {}
+
+	World(const World&) = delete;
+	World& operator=(const World&) = delete;
+};
@@ -1,13 +1,14 @@
 #include "world_init.hpp"
+#include "world.hpp"
 #include "tinyECS/registry.hpp"
 #include "systems/item_system.hpp"
 #include "systems/ui_system.hpp"
 #include <iostream>
 
 
-Entity createGridLine(vec2 start_pos, vec2 end_pos)
+Entity createGridLine(ECSRegistry& registry, vec2 start_pos, vec2 end_pos)
 {
-	Entity entity = Entity();
+	Entity entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " gridline" << std::endl;
 
 	GridLine& gridLine = registry.gridLines.emplace(entity);
@@ -30,13 +31,14 @@ Entity createGridLine(vec2 start_pos, vec2 end_pos)
 	return entity;
 }
 
-Entity createBoundaryLine(RenderSystem* renderer, vec2 position, vec2 scale)
+Entity createBoundaryLine(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " boundary line" << std::endl;
 
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 1.0f; // cannot walk past boundaries
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -58,9 +60,9 @@ Entity createBoundaryLine(RenderSystem* renderer, vec2 position, vec2 scale)
 	return entity;
 }
 
-Entity createWelcomeScreen(RenderSystem* renderer, vec2 position)
+Entity createWelcomeScreen(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " welcome screen" << std::endl;
 	registry.welcomeScreens.emplace(entity);
 
@@ -85,12 +87,12 @@ Entity createWelcomeScreen(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createPlayer(RenderSystem* renderer, vec2 position)
+Entity createPlayer(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
 	// create player in grotto
 
 	// reserve an entity
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " player" << std::endl;
 	Player& player = registry.players.emplace(entity);
 	player.name = "Madoka";
@@ -106,6 +108,8 @@ Entity createPlayer(RenderSystem* renderer, vec2 position)
 
 	motion.scale = { PLAYER_BB_WIDTH * PlAYER_BB_GROTTO_SIZE_FACTOR, PLAYER_BB_HEIGHT * PlAYER_BB_GROTTO_SIZE_FACTOR };
 
+	registry.collisionFilters.insert(entity, { COLLISION_PLAYER, COLLISION_SOLID | COLLISION_ENEMY_REACH });
+
 	auto& inventory = registry.inventories.emplace(entity);
 	inventory.capacity = 10;
 	inventory.isFull = false;
@@ -134,7 +138,8 @@ Entity createPlayer(RenderSystem* renderer, vec2 position)
 	Collectable items and interaction textbox
 ============================================================================================================== */
 
-Entity createCollectableIngredient(RenderSystem* renderer, vec2 position, ItemType type, int amount, bool canRespawn) {
+Entity createCollectableIngredient(World& world, RenderSystem* renderer, vec2 position, ItemType type, int amount, bool canRespawn) {
+	ECSRegistry& registry = world.registry;
 	// Persistent ID based on biome, type, and position
 	std::string itemName;
 	auto it = ITEM_INFO.find(type);
@@ -145,23 +150,23 @@ Entity createCollectableIngredient(RenderSystem* renderer, vec2 position, ItemTy
 		itemName = "Unknown_" + std::to_string(static_cast<int>(type));
 	}
 
-	std::string persistentID = RespawnSystem::getInstance().generatePersistentID(
+	std::string persistentID = world.respawns.generatePersistentID(
 		static_cast<BIOME>(registry.screenStates.components[0].biome),
 		itemName,
 		position
 	);
 
 	// Check if this item should be spawned based on respawn state
-	if (!RespawnSystem::getInstance().shouldEntitySpawn(persistentID)) {
-		return Entity();
+	if (!world.respawns.shouldEntitySpawn(persistentID)) {
+		return Entity::null();
 	}
 
-	Entity entity = ItemSystem::createCollectableIngredient(position, type, amount, canRespawn);
+	Entity entity = ItemSystem::createCollectableIngredient(registry, position, type, amount, canRespawn);
 
 	if (registry.items.has(entity)) {
 		registry.items.get(entity).persistentID = persistentID;
 
-		RespawnSystem::getInstance().registerEntity(entity, true);
+		world.respawns.registerEntity(entity, true);
 	}
 
 	// store a reference to the potentially re-used mesh object
@@ -201,14 +206,14 @@ Entity createCollectableIngredient(RenderSystem* renderer, vec2 position, ItemTy
 
 	// Textbox for item
 	std::string itemDisplayName = itemName;
-	createTextbox(renderer, vec2(position.x, position.y - 25), entity, "[F] Pick up " + itemDisplayName);
+	createTextbox(registry, renderer, vec2(position.x, position.y - 25), entity, "[F] Pick up " + itemDisplayName);
 
 	return entity;
 }
 
-Entity createTextbox(RenderSystem* renderer, vec2 position, Entity itemEntity, std::string text)
+Entity createTextbox(ECSRegistry& registry, RenderSystem* renderer, vec2 position, Entity itemEntity, std::string text)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Create a Textbox component
 	Textbox& textbox = registry.textboxes.emplace(entity);
@@ -235,14 +240,16 @@ Entity createTextbox(RenderSystem* renderer, vec2 position, Entity itemEntity, s
 	Forest Creation
 ============================================================================================================== */
 
-Entity createBush(RenderSystem* renderer, vec2 position)
+Entity createBush(World& world, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	ECSRegistry& registry = world.registry;
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " bush" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.35f;
 	terrain.width_ratio = 0.55f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -263,21 +270,23 @@ Entity createBush(RenderSystem* renderer, vec2 position)
 		 RENDER_LAYER::TERRAIN });
 
 	// create coffee beans on bush
-	createCollectableIngredient(renderer, vec2(position.x - 30, position.y - 12), ItemType::COFFEE_BEANS, 1, true);
-	createCollectableIngredient(renderer, vec2(position.x + 38, position.y - 10), ItemType::COFFEE_BEANS, 1, true);
-	createCollectableIngredient(renderer, vec2(position.x + 10, position.y + 25), ItemType::COFFEE_BEANS, 1, true);
+	createCollectableIngredient(world, renderer, vec2(position.x - 30, position.y - 12), ItemType::COFFEE_BEANS, 1, true);
+	createCollectableIngredient(world, renderer, vec2(position.x + 38, position.y - 10), ItemType::COFFEE_BEANS, 1, true);
+	createCollectableIngredient(world, renderer, vec2(position.x + 10, position.y + 25), ItemType::COFFEE_BEANS, 1, true);
 
 	return entity;
 }
 
-Entity createTree(RenderSystem* renderer, vec2 position)
+Entity createTree(World& world, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	ECSRegistry& registry = world.registry;
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " tree" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.1f;
 	terrain.width_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -298,19 +307,20 @@ Entity createTree(RenderSystem* renderer, vec2 position)
 		 RENDER_LAYER::TERRAIN });
 
 	// create magical fruit that spawns on tree
-	createCollectableIngredient(renderer, vec2(position.x, position.y - 30), ItemType::GALEFRUIT, 1, true);
+	createCollectableIngredient(world, renderer, vec2(position.x, position.y - 30), ItemType::GALEFRUIT, 1, true);
 
 	return entity;
 }
 
-Entity createTreeNoFruit(RenderSystem* renderer, vec2 position)
+Entity createTreeNoFruit(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " tree" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.1f;
 	terrain.width_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -333,9 +343,9 @@ Entity createTreeNoFruit(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createForestBridge(RenderSystem* renderer, vec2 position)
+Entity createForestBridge(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
 
@@ -359,12 +369,13 @@ Entity createForestBridge(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createForestBridgeTop(RenderSystem* renderer, vec2 position)
+Entity createForestBridgeTop(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " forest bridge top" << std::endl;
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 3.0f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::BRIDGE_TOP);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -389,12 +400,13 @@ Entity createForestBridgeTop(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createForestBridgeBottom(RenderSystem* renderer, vec2 position)
+Entity createForestBridgeBottom(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " forest bridge bottom" << std::endl;
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 3.0f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::BRIDGE_BOTTOM);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -419,17 +431,19 @@ Entity createForestBridgeBottom(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createForestRiver(RenderSystem* renderer, vec2 position)
+Entity createForestRiver(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
 	// top half of river texture
-	auto entity1 = Entity();
+	auto entity1 = registry.create();
 	auto& terrain1 = registry.terrains.emplace(entity1);
 	terrain1.collision_setting = 1.0f;
+	registry.collisionFilters.insert(entity1, { COLLISION_SOLID, 0 });
 
 	// bottom half of river texture
-	auto entity2 = Entity();
+	auto entity2 = registry.create();
 	auto& terrain2 = registry.terrains.emplace(entity2);
 	terrain2.collision_setting = 1.0f;
+	registry.collisionFilters.insert(entity2, { COLLISION_SOLID, 0 });
 
 	// std::cout << "Entity " << entity1.id() << " river" << std::endl;
 	// std::cout << "Entity " << entity2.id() << " river" << std::endl;
@@ -477,14 +491,17 @@ Entity createForestRiver(RenderSystem* renderer, vec2 position)
 	Grotto Creation
 ============================================================================================================== */
 
-Entity createGrottoStaticEntities(RenderSystem* renderer, vec2 position, vec2 scale, float angle, GLuint texture_asset_id, float can_collide)
+Entity createGrottoStaticEntities(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, float angle, GLuint texture_asset_id, float can_collide)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " static grotto entity" << std::endl;
 	if (can_collide == 1)
 	{
 		auto& terrain = registry.terrains.emplace(entity);
 		terrain.collision_setting = can_collide;
+		// the bookshelves stop thrown ammo
+		bool bookshelf = texture_asset_id == (GLuint)TEXTURE_ASSET_ID::GROTTO_RIGHT_BOOKSHELF || texture_asset_id == (GLuint)TEXTURE_ASSET_ID::GROTTO_TOP_BOOKSHELF;
+		registry.collisionFilters.insert(entity, { bookshelf ? COLLISION_SOLID | COLLISION_AMMO_STOPPING : COLLISION_SOLID, 0 });
 	}
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -509,11 +526,12 @@ Entity createGrottoStaticEntities(RenderSystem* renderer, vec2 position, vec2 sc
 	return entity;
 }
 
-Entity createGrottoPoolMesh(RenderSystem* renderer, vec2 position)
+Entity createGrottoPoolMesh(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 3.0f; // using mesh for collision
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::GROTTO_POOL);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -538,10 +556,10 @@ Entity createGrottoPoolMesh(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createCauldron(RenderSystem* renderer, vec2 position, vec2 scale, std::string name, bool create_textbox = false)
+Entity createCauldron(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name, bool create_textbox = false)
 {
 	// Create simple cauldron water entity
-	auto waterEntity = Entity();
+	auto waterEntity = registry.create();
 	auto& waterMotion = registry.motions.emplace(waterEntity);
 	waterMotion.angle = 180.f;
 	waterMotion.velocity = { 0, 0 };
@@ -561,13 +579,14 @@ Entity createCauldron(RenderSystem* renderer, vec2 position, vec2 scale, std::st
 		});
 
 	// The actual cauldron entity
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " cauldron" << std::endl;
 
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.80f;
 	terrain.height_ratio = 0.30f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Item& item = registry.items.emplace(entity);
 	item.type = ItemType::CAULDRON;
@@ -590,7 +609,7 @@ Entity createCauldron(RenderSystem* renderer, vec2 position, vec2 scale, std::st
 	cauldron.water = waterEntity;
 
 	// note: we are also creating textbox in biome_system, so any updates to this should be updated there too
-	if (create_textbox) createTextbox(renderer, vec2(position.x + 50, position.y - 50), entity, "[F] Use Cauldron");
+	if (create_textbox) createTextbox(registry, renderer, vec2(position.x + 50, position.y - 50), entity, "[F] Use Cauldron");
 
 	// Give cauldron an inventory
 	auto& inv = registry.inventories.emplace(entity);
@@ -608,9 +627,9 @@ Entity createCauldron(RenderSystem* renderer, vec2 position, vec2 scale, std::st
 	return entity;
 }
 
-Entity createMortarPestle(RenderSystem* renderer, vec2 position, vec2 scale, std::string name)
+Entity createMortarPestle(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " mortar and pestle" << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -632,7 +651,7 @@ Entity createMortarPestle(RenderSystem* renderer, vec2 position, vec2 scale, std
 
 	// Create mortar pestle
 	registry.mortarAndPestles.emplace(entity);
-	createTextbox(renderer, { GRID_CELL_WIDTH_PX * 7.2, GRID_CELL_HEIGHT_PX * 3 }, entity, "[F] Mortar & Pestle");
+	createTextbox(registry, renderer, { GRID_CELL_WIDTH_PX * 7.2, GRID_CELL_HEIGHT_PX * 3 }, entity, "[F] Mortar & Pestle");
 
 	// Give mortar an inventory
 	auto& inv = registry.inventories.emplace(entity);
@@ -650,9 +669,9 @@ Entity createMortarPestle(RenderSystem* renderer, vec2 position, vec2 scale, std
 	return entity;
 }
 
-Entity createChest(RenderSystem* renderer, vec2 position, vec2 scale, std::string name)
+Entity createChest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " chest" << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -677,7 +696,7 @@ Entity createChest(RenderSystem* renderer, vec2 position, vec2 scale, std::strin
 	auto& inv = registry.inventories.emplace(entity);
 	inv.capacity = 30;
 
-	Entity textbox = createTextbox(renderer, vec2(position.x, position.y - 50), entity, "[F] Open Chest");
+	createTextbox(registry, renderer, vec2(position.x, position.y - 50), entity, "[F] Open Chest");
 
 	registry.renderRequests.insert(
 		entity,
@@ -691,9 +710,9 @@ Entity createChest(RenderSystem* renderer, vec2 position, vec2 scale, std::strin
 	return entity;
 }
 
-Entity createRecipeBook(RenderSystem* renderer, vec2 position, vec2 scale, std::string name)
+Entity createRecipeBook(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " recipe book" << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -713,7 +732,7 @@ Entity createRecipeBook(RenderSystem* renderer, vec2 position, vec2 scale, std::
 	motion.position = position;
 	motion.scale = scale;
 
-	Entity textbox = createTextbox(renderer, vec2(position.x - 50, position.y - 120), entity, "[F] Recipe Book");
+	createTextbox(registry, renderer, vec2(position.x - 50, position.y - 120), entity, "[F] Recipe Book");
 
 	registry.renderRequests.insert(
 		entity,
@@ -731,14 +750,15 @@ Entity createRecipeBook(RenderSystem* renderer, vec2 position, vec2 scale, std::
 	Desert Creation
 ============================================================================================================== */
 
-Entity createDesertTree(RenderSystem* renderer, vec2 position)
+Entity createDesertTree(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " desert tree" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.1f;
 	terrain.width_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -761,14 +781,16 @@ Entity createDesertTree(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createDesertCactus(RenderSystem* renderer, vec2 position)
+Entity createDesertCactus(World& world, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	ECSRegistry& registry = world.registry;
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " desert catcus" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.1f;
 	terrain.width_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -781,8 +803,8 @@ Entity createDesertCactus(RenderSystem* renderer, vec2 position)
 
 	motion.scale = vec2({ DESERT_CACTUS_WIDTH, DESERT_CACTUS_HEIGHT });
 
-	createCollectableIngredient(renderer, { position.x, position.y }, ItemType::CACTUS_PULP, 1, true);
-	createCollectableIngredient(renderer, { position.x + 40.0f, position.y - 30.0f }, ItemType::CACTUS_PULP, 1, true);
+	createCollectableIngredient(world, renderer, { position.x, position.y }, ItemType::CACTUS_PULP, 1, true);
+	createCollectableIngredient(world, renderer, { position.x + 40.0f, position.y - 30.0f }, ItemType::CACTUS_PULP, 1, true);
 
 	registry.renderRequests.insert(
 		entity,
@@ -795,12 +817,13 @@ Entity createDesertCactus(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createDesertRiver(RenderSystem* renderer, vec2 position)
+Entity createDesertRiver(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " desert river" << std::endl;
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 1.0f; // rivers are not walkable
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -824,11 +847,12 @@ Entity createDesertRiver(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createDesertSandPile(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createDesertSandPile(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " desert sand pile" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -852,13 +876,14 @@ Entity createDesertSandPile(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createDesertPage(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createDesertPage(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " desert page" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 1.f;
 	terrain.width_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -882,13 +907,15 @@ Entity createDesertPage(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createDesertSkull(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createDesertSkull(World& world, RenderSystem* renderer, vec2 position) {
+	ECSRegistry& registry = world.registry;
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " desert skull" << std::endl;
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.3f;
 	terrain.width_ratio = 0.8f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -901,7 +928,7 @@ Entity createDesertSkull(RenderSystem* renderer, vec2 position) {
 
 	motion.scale = vec2({ DESERT_SKULL_WIDTH, DESERT_SKULL_HEIGHT });
 
-	createCollectableIngredient(renderer, { position.x - 100.0f, position.y + 10.0f }, ItemType::PETRIFIED_BONE, 2, true);
+	createCollectableIngredient(world, renderer, { position.x - 100.0f, position.y + 10.0f }, ItemType::PETRIFIED_BONE, 2, true);
 
 	registry.renderRequests.insert(
 		entity,
@@ -918,8 +945,8 @@ Entity createDesertSkull(RenderSystem* renderer, vec2 position) {
 	Mushroom Biome Creation
 ============================================================================================================== */
 
-Entity createMushroomAcidLake(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createMushroomAcidLake(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 2.0f; // 2 as we're using a mesh for collisions
@@ -946,11 +973,12 @@ Entity createMushroomAcidLake(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createMushroomAcidLakeMesh(RenderSystem* renderer, vec2 position)
+Entity createMushroomAcidLakeMesh(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	auto& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 3.0f; // using mesh for collision
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::MUSHROOM_ACID_LAKE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -975,13 +1003,14 @@ Entity createMushroomAcidLakeMesh(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
-Entity createMushroomBlue(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createMushroomBlue(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.2f;
 	terrain.height_ratio = 0.1f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1004,13 +1033,14 @@ Entity createMushroomBlue(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createMushroomPink(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createMushroomPink(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.2f;
 	terrain.height_ratio = 0.1f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1033,13 +1063,14 @@ Entity createMushroomPink(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createMushroomPurple(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createMushroomPurple(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.2f;
 	terrain.height_ratio = 0.1f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1062,13 +1093,14 @@ Entity createMushroomPurple(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createMushroomTallBlue(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createMushroomTallBlue(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.1f;
 	terrain.height_ratio = 0.1f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1091,13 +1123,14 @@ Entity createMushroomTallBlue(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createMushRoomTallPink(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createMushRoomTallPink(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.1f;
 	terrain.height_ratio = 0.1f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1124,13 +1157,14 @@ Entity createMushRoomTallPink(RenderSystem* renderer, vec2 position) {
 	Crystal Biome Creation
 ============================================================================================================== */
 
-Entity createCrystal1(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createCrystal1(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.4f;
 	terrain.height_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1153,13 +1187,14 @@ Entity createCrystal1(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createCrystal2(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createCrystal2(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.65f;
 	terrain.height_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1182,13 +1217,14 @@ Entity createCrystal2(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createCrystal3(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createCrystal3(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.4f;
 	terrain.height_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1211,13 +1247,14 @@ Entity createCrystal3(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createCrystal4(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createCrystal4(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.4f;
 	terrain.height_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1240,14 +1277,15 @@ Entity createCrystal4(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createCrystalMinecart(RenderSystem* renderer, vec2 position) {
+Entity createCrystalMinecart(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
 
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.9f;
 	terrain.height_ratio = 0.5f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1269,8 +1307,8 @@ Entity createCrystalMinecart(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createCrystalPage(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createCrystalPage(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 2.0f;
@@ -1297,13 +1335,14 @@ Entity createCrystalPage(RenderSystem* renderer, vec2 position) {
 	return entity;
 }
 
-Entity createCrystalRock(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+Entity createCrystalRock(ECSRegistry& registry, RenderSystem* renderer, vec2 position) {
+	auto entity = registry.create();
 
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.8f;
 	terrain.height_ratio = 0.2f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1330,9 +1369,9 @@ Entity createCrystalRock(RenderSystem* renderer, vec2 position) {
 	Entering and transition between biomes
 ============================================================================================================== */
 
-Entity createForestToGrotto(RenderSystem* renderer, vec2 position, std::string name)
+Entity createForestToGrotto(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::GROTTO;
@@ -1354,7 +1393,7 @@ Entity createForestToGrotto(RenderSystem* renderer, vec2 position, std::string n
 
 	motion.scale = vec2({ GROTTO_ENTRANCE_WIDTH, GROTTO_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 40, position.y + 30 }), entity, "[F] Enter Grotto");
+	createTextbox(registry, renderer, vec2({ position.x + 40, position.y + 30 }), entity, "[F] Enter Grotto");
 
 	// m_ui_system->createRmlUITextbox(1, "[F] Enter Grotto", vec2(position.x, position.y + 20));
 
@@ -1369,9 +1408,9 @@ Entity createForestToGrotto(RenderSystem* renderer, vec2 position, std::string n
 	return entity;
 }
 
-Entity createGrottoToForest(RenderSystem* renderer, vec2 position, std::string name)
+Entity createGrottoToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::FOREST;
@@ -1393,7 +1432,7 @@ Entity createGrottoToForest(RenderSystem* renderer, vec2 position, std::string n
 
 	motion.scale = vec2(190, BOUNDARY_LINE_THICKNESS);
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 60, position.y - 40 }), entity, "[F] Exit Grotto");
+	createTextbox(registry, renderer, vec2({ position.x + 60, position.y - 40 }), entity, "[F] Exit Grotto");
 
 	// registry.renderRequests.insert(
 	// 	entity,
@@ -1406,9 +1445,9 @@ Entity createGrottoToForest(RenderSystem* renderer, vec2 position, std::string n
 	return entity;
 }
 
-Entity createForestToDesert(RenderSystem* renderer, vec2 position, std::string name)
+Entity createForestToDesert(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::DESERT;
@@ -1430,7 +1469,7 @@ Entity createForestToDesert(RenderSystem* renderer, vec2 position, std::string n
 
 	motion.scale = vec2(DESERT_FOREST_TRANSITION_WIDTH, DESERT_FOREST_TRANSITION_HEIGHT);
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 60, position.y - 20 }), entity, "[F] Enter Desert");
+	createTextbox(registry, renderer, vec2({ position.x + 60, position.y - 20 }), entity, "[F] Enter Desert");
 
 	registry.renderRequests.insert(
 		entity,
@@ -1443,9 +1482,9 @@ Entity createForestToDesert(RenderSystem* renderer, vec2 position, std::string n
 	return entity;
 }
 
-Entity createDesertToForest(RenderSystem* renderer, vec2 position, std::string name)
+Entity createDesertToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::FOREST;
@@ -1467,7 +1506,7 @@ Entity createDesertToForest(RenderSystem* renderer, vec2 position, std::string n
 
 	motion.scale = vec2(DESERT_FOREST_TRANSITION_WIDTH, DESERT_FOREST_TRANSITION_HEIGHT);
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 40, position.y - 10 }), entity, "[F] Enter Forest");
+	createTextbox(registry, renderer, vec2({ position.x + 40, position.y - 10 }), entity, "[F] Enter Forest");
 
 	registry.renderRequests.insert(
 		entity,
@@ -1480,9 +1519,9 @@ Entity createDesertToForest(RenderSystem* renderer, vec2 position, std::string n
 	return entity;
 }
 
-Entity createForestToForestEx(RenderSystem* renderer, vec2 position, std::string name)
+Entity createForestToForestEx(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::FOREST_EX;
@@ -1503,14 +1542,14 @@ Entity createForestToForestEx(RenderSystem* renderer, vec2 position, std::string
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x - 210, position.y - 80 }), entity, "[F] Enter Deep Forest");
+	createTextbox(registry, renderer, vec2({ position.x - 210, position.y - 80 }), entity, "[F] Enter Deep Forest");
 
 	return entity;
 }
 
-Entity createForestExToForest(RenderSystem* renderer, vec2 position, std::string name)
+Entity createForestExToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::FOREST;
@@ -1531,14 +1570,14 @@ Entity createForestExToForest(RenderSystem* renderer, vec2 position, std::string
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x, position.y - 100 }), entity, "[F] Enter Forest");
+	createTextbox(registry, renderer, vec2({ position.x, position.y - 100 }), entity, "[F] Enter Forest");
 
 	return entity;
 }
 
-Entity createForestToMushroom(RenderSystem* renderer, vec2 position, std::string name)
+Entity createForestToMushroom(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::MUSHROOM;
@@ -1560,7 +1599,7 @@ Entity createForestToMushroom(RenderSystem* renderer, vec2 position, std::string
 
 	motion.scale = vec2({ FOREST_TO_MUSHROOM_WIDTH, FOREST_TO_MUSHROOM_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 70, position.y - 20 }), entity, "[F] Enter Shroomlands");
+	createTextbox(registry, renderer, vec2({ position.x + 70, position.y - 20 }), entity, "[F] Enter Shroomlands");
 
 	registry.renderRequests.insert(
 		entity,
@@ -1573,9 +1612,9 @@ Entity createForestToMushroom(RenderSystem* renderer, vec2 position, std::string
 	return entity;
 }
 
-Entity createMushroomToForest(RenderSystem* renderer, vec2 position, std::string name)
+Entity createMushroomToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::FOREST;
@@ -1596,14 +1635,14 @@ Entity createMushroomToForest(RenderSystem* renderer, vec2 position, std::string
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 100, position.y - 20 }), entity, "[F] Enter Forest");
+	createTextbox(registry, renderer, vec2({ position.x + 100, position.y - 20 }), entity, "[F] Enter Forest");
 
 	return entity;
 }
 
-Entity createMushroomToCrystal(RenderSystem* renderer, vec2 position, std::string name)
+Entity createMushroomToCrystal(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::CRYSTAL;
@@ -1624,14 +1663,14 @@ Entity createMushroomToCrystal(RenderSystem* renderer, vec2 position, std::strin
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x - 180, position.y - 80 }), entity, "[F] Enter Crystal Caves");
+	createTextbox(registry, renderer, vec2({ position.x - 180, position.y - 80 }), entity, "[F] Enter Crystal Caves");
 
 	return entity;
 }
 
-Entity createCrystalToMushroom(RenderSystem* renderer, vec2 position, std::string name)
+Entity createCrystalToMushroom(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::MUSHROOM;
@@ -1652,14 +1691,14 @@ Entity createCrystalToMushroom(RenderSystem* renderer, vec2 position, std::strin
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x - 10, position.y - 100 }), entity, "[F] Enter Shroomlands");
+	createTextbox(registry, renderer, vec2({ position.x - 10, position.y - 100 }), entity, "[F] Enter Shroomlands");
 
 	return entity;
 }
 
-Entity createCrystalToForestEx(RenderSystem* renderer, vec2 position, std::string name)
+Entity createCrystalToForestEx(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::FOREST_EX;
@@ -1680,14 +1719,14 @@ Entity createCrystalToForestEx(RenderSystem* renderer, vec2 position, std::strin
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 100, position.y }), entity, "[F] Enter Deep Forest");
+	createTextbox(registry, renderer, vec2({ position.x + 100, position.y }), entity, "[F] Enter Deep Forest");
 
 	return entity;
 }
 
-Entity createForestExToCrystal(RenderSystem* renderer, vec2 position, std::string name)
+Entity createForestExToCrystal(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Entrance& entrance = registry.entrances.emplace(entity);
 	entrance.target_biome = (GLuint)BIOME::CRYSTAL;
@@ -1708,7 +1747,7 @@ Entity createForestExToCrystal(RenderSystem* renderer, vec2 position, std::strin
 
 	motion.scale = vec2({ GENERIC_ENTRANCE_WIDTH, GENERIC_ENTRANCE_HEIGHT });
 
-	Entity textbox = createTextbox(renderer, vec2({ position.x + 20, position.y - 40 }), entity, "[F] Enter Crystal Caves");
+	createTextbox(registry, renderer, vec2({ position.x + 20, position.y - 40 }), entity, "[F] Enter Crystal Caves");
 
 	return entity;
 }
@@ -1717,20 +1756,21 @@ Entity createForestExToCrystal(RenderSystem* renderer, vec2 position, std::strin
 	Combat Creation
 ============================================================================================================== */
 
-Entity createEnt(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createEnt(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name) {
+	ECSRegistry& registry = world.registry;
 	// Persistent ID based on biome, type, and position
-	std::string persistentID = RespawnSystem::getInstance().generatePersistentID(
+	std::string persistentID = world.respawns.generatePersistentID(
 		static_cast<BIOME>(registry.screenStates.components[0].biome),
 		name,
 		position
 	);
 
 	// Check if this entity should spawn according to the respawn system
-	if (!RespawnSystem::getInstance().shouldEntitySpawn(persistentID)) {
-		return Entity(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
+	if (!world.respawns.shouldEntitySpawn(persistentID)) {
+		return Entity::null(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
 	}
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " ent" << std::endl;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
@@ -1745,11 +1785,14 @@ Entity createEnt(RenderSystem* renderer, vec2 position, int movable, std::string
 	enemy.persistentID = persistentID;
 
 	// Register with the respawn system
-	RespawnSystem::getInstance().registerEntity(entity, true);
+	world.respawns.registerEntity(entity, true);
 
 	// auto& terrain = registry.terrains.emplace(entity);
 	// terrain.collision_setting = 1.0f; // cannot walk past guardian
 
+	// hit by thrown ammo and hurts the player in reach, walks around solid terrain
+	registry.collisionFilters.insert(entity, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
+
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1772,20 +1815,21 @@ Entity createEnt(RenderSystem* renderer, vec2 position, int movable, std::string
 	return entity;
 }
 
-Entity createMummy(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createMummy(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name) {
+	ECSRegistry& registry = world.registry;
 	// Persistent ID based on biome, type, and position
-	std::string persistentID = RespawnSystem::getInstance().generatePersistentID(
+	std::string persistentID = world.respawns.generatePersistentID(
 		static_cast<BIOME>(registry.screenStates.components[0].biome),
 		name,
 		position
 	);
 
 	// Check if this entity should spawn according to the respawn system
-	if (!RespawnSystem::getInstance().shouldEntitySpawn(persistentID)) {
-		return Entity(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
+	if (!world.respawns.shouldEntitySpawn(persistentID)) {
+		return Entity::null(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
 	}
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " mummy" << std::endl;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
@@ -1800,11 +1844,13 @@ Entity createMummy(RenderSystem* renderer, vec2 position, int movable, std::stri
 	enemy.persistentID = persistentID;
 
 	// Register with the respawn system
-	RespawnSystem::getInstance().registerEntity(entity, true);
+	world.respawns.registerEntity(entity, true);
 
 	// auto& terrain = registry.terrains.emplace(entity);
 	// terrain.collision_setting = 1.0f; // cannot walk past guardian
 
+	registry.collisionFilters.insert(entity, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
+
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1827,20 +1873,21 @@ Entity createMummy(RenderSystem* renderer, vec2 position, int movable, std::stri
 	return entity;
 }
 
-Entity createEvilMushroom(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createEvilMushroom(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name) {
+	ECSRegistry& registry = world.registry;
 	// Persistent ID based on biome, type, and position
-	std::string persistentID = RespawnSystem::getInstance().generatePersistentID(
+	std::string persistentID = world.respawns.generatePersistentID(
 		static_cast<BIOME>(registry.screenStates.components[0].biome),
 		name,
 		position
 	);
 
 	// Check if this entity should spawn according to the respawn system
-	if (!RespawnSystem::getInstance().shouldEntitySpawn(persistentID)) {
-		return Entity(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
+	if (!world.respawns.shouldEntitySpawn(persistentID)) {
+		return Entity::null(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
 	}
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " evil mushroom" << std::endl;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
@@ -1854,11 +1901,13 @@ Entity createEvilMushroom(RenderSystem* renderer, vec2 position, int movable, st
 	enemy.persistentID = persistentID;
 
 	// Register with the respawn system
-	RespawnSystem::getInstance().registerEntity(entity, true);
+	world.respawns.registerEntity(entity, true);
 
 	// auto& terrain = registry.terrains.emplace(entity);
 	// terrain.collision_setting = 1.0f; // cannot walk past guardian
 
+	registry.collisionFilters.insert(entity, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
+
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1881,9 +1930,9 @@ Entity createEvilMushroom(RenderSystem* renderer, vec2 position, int movable, st
 	return entity;
 }
 
-Entity createGuardianDesert(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createGuardianDesert(ECSRegistry& registry, RenderSystem* renderer, vec2 position, int movable, std::string name) {
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " ent" << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -1904,6 +1953,7 @@ Entity createGuardianDesert(RenderSystem* renderer, vec2 position, int movable,
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 1.0f;
 	terrain.height_ratio = 0.7f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1915,7 +1965,7 @@ Entity createGuardianDesert(RenderSystem* renderer, vec2 position, int movable,
 	motion.position = position;
 	motion.scale = vec2({ DESERT_GUARDIAN_WIDTH, DESERT_GUARDIAN_WIDTH });
 
-	createTextbox(renderer, vec2(position.x + 80, position.y), entity, guardian.hint_dialogue);
+	createTextbox(registry, renderer, vec2(position.x + 80, position.y), entity, guardian.hint_dialogue);
 
 	registry.renderRequests.insert(
 		entity,
@@ -1929,9 +1979,9 @@ Entity createGuardianDesert(RenderSystem* renderer, vec2 position, int movable,
 	return entity;
 }
 
-Entity createGuardianMushroom(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createGuardianMushroom(ECSRegistry& registry, RenderSystem* renderer, vec2 position, int movable, std::string name) {
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " ent" << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -1952,6 +2002,7 @@ Entity createGuardianMushroom(RenderSystem* renderer, vec2 position, int movable
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 1.0f;
 	terrain.height_ratio = 0.7f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1963,7 +2014,7 @@ Entity createGuardianMushroom(RenderSystem* renderer, vec2 position, int movable
 	motion.position = position;
 	motion.scale = vec2({ MUSHROOM_GUARDIAN_WIDTH, MUSHROOM_GUARDIAN_HEIGHT });
 
-	createTextbox(renderer, vec2(position.x + 80, position.y - 100), entity, guardian.hint_dialogue);
+	createTextbox(registry, renderer, vec2(position.x + 80, position.y - 100), entity, guardian.hint_dialogue);
 
 	std::cout << "CREATED GUARDIAN MUSHROOM AT " << position.x << " and " << position.y << std::endl;
 	registry.renderRequests.insert(
@@ -1978,9 +2029,9 @@ Entity createGuardianMushroom(RenderSystem* renderer, vec2 position, int movable
 	return entity;
 }
 
-Entity createGuardianCrystal(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createGuardianCrystal(ECSRegistry& registry, RenderSystem* renderer, vec2 position, int movable, std::string name) {
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " ent" << std::endl;
 
 	Item& item = registry.items.emplace(entity);
@@ -2001,6 +2052,7 @@ Entity createGuardianCrystal(RenderSystem* renderer, vec2 position, int movable,
 	terrain.collision_setting = 0.0f;
 	terrain.width_ratio = 0.8f;
 	terrain.height_ratio = 0.8f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -2012,7 +2064,7 @@ Entity createGuardianCrystal(RenderSystem* renderer, vec2 position, int movable,
 	motion.position = position;
 	motion.scale = vec2({ CRYSTAL_GUARDIAN_WIDTH, CRYSTAL_GUARDIAN_HEIGHT });
 
-	createTextbox(renderer, vec2(position.x - 180, position.y - 90), entity, guardian.hint_dialogue);
+	createTextbox(registry, renderer, vec2(position.x - 180, position.y - 90), entity, guardian.hint_dialogue);
 
 	registry.renderRequests.insert(
 		entity,
@@ -2027,13 +2079,14 @@ Entity createGuardianCrystal(RenderSystem* renderer, vec2 position, int movable,
 }
 
 
-Entity createMasterPotionPedestal(RenderSystem* renderer, vec2 position)
+Entity createMasterPotionPedestal(ECSRegistry& registry, RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 0.0f;
 	terrain.height_ratio = 0.3f;
 	terrain.width_ratio = 0.3f;
+	registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
 
 	Item& item = registry.items.emplace(entity);
 	item.type = ItemType::MASTER_POTION_PEDESTAL;
@@ -2068,26 +2121,28 @@ Entity createMasterPotionPedestal(RenderSystem* renderer, vec2 position)
 
 	ScreenState& screen = registry.screenStates.components[0];
 	if (std::find(screen.unlocked_biomes.begin(), screen.unlocked_biomes.end(), "saved-grotto") == screen.unlocked_biomes.end()) {
-		createTextbox(renderer, vec2(position.x - 120, position.y - 110), entity, "Something's missing from this pedestal, perhaps a potion to restore life to this place.");
+		createTextbox(registry, renderer, vec2(position.x - 120, position.y - 110), entity, "Something's missing from this pedestal, perhaps a potion to restore life to this place.");
 	}
 
 	return entity;
 }
 
-bool createFiredAmmo(RenderSystem* renderer, vec2 target, Entity& item_entity, Entity& player_entity) {
-
-	auto entity = Entity();
-	// std::cout << "Entity " << entity.id() << " fired ammo" << std::endl;
+bool createFiredAmmo(World& world, RenderSystem* renderer, vec2 target, Entity& item_entity, Entity& player_entity) {
+	ECSRegistry& registry = world.registry;
 
 	if (!registry.ammo.has(item_entity)) std::cout << "Cannot throw this item" << std::endl;
 	if (!registry.motions.has(player_entity) || !registry.ammo.has(item_entity)) return false;
 
-	Ammo& ammo = registry.ammo.emplace(entity);
+	// a projectile that landed earlier is thrown again if there is one, it still has the components of that throw
+	Entity entity = world.projectiles.acquire();
+	// std::cout << "Entity " << entity.id() << " fired ammo" << std::endl;
 
 	// If it's a potion add colour to it and copy its attributes
+	registry.potions.remove(entity);
+	registry.colors.remove(entity);
 	if (registry.potions.has(item_entity)) {
 		registry.colors.insert(entity, registry.potions.get(item_entity).color / 255.f);
-		Potion& old_potion = registry.potions.get(item_entity);
+		Potion& old_potion = registry.potions.get(item_entity); // potions are paged, the emplace below keeps it in place
 		Potion& potion = registry.potions.emplace(entity);
 		potion.color = old_potion.color;
 		potion.duration = old_potion.duration;
@@ -2096,45 +2151,36 @@ bool createFiredAmmo(RenderSystem* renderer, vec2 target, Entity& item_entity, E
 		potion.quality = old_potion.quality;
 	}
 
-	Motion& player_motion = registry.motions.get(player_entity);
-	vec2 player_pos = player_motion.position;
+	vec2 player_pos = registry.motions.get(player_entity).position;
 
 	float delta_x = target.x - player_pos.x;
 	float delta_y = target.y - player_pos.y;
 	float angle = atan2f(delta_y, delta_x);
 
-	auto& motion = registry.motions.emplace(entity);
-	motion.angle = 0.f;
-	motion.velocity = { cosf(angle), sinf(angle) };
-	motion.position = player_pos;
+	Motion& motion = registry.motions.get(entity);
+	motion = Motion();
 	motion.scale = vec2({ 50, 50 });
 
-	ammo.is_fired = true;
-	ammo.start_pos = player_motion.position;
-	if (registry.potions.has(item_entity)) {
-		ammo.damage = registry.potions.get(item_entity).effectValue;
-	}
-	else {
-		ammo.damage = 50;
-	}
+	registry.collisionFilters.get(entity) = { COLLISION_AMMO, COLLISION_AMMO_STOPPING | COLLISION_ENEMY };
+	int damage = registry.potions.has(item_entity) ? (int)registry.potions.get(item_entity).effectValue : 50;
 
-	ammo.target = { player_pos.x + THROW_DISTANCE * cosf(angle), player_pos.y + THROW_DISTANCE * sinf(angle) };
+	registry.renderRequests.get(entity) = {
+		ITEM_INFO.at(registry.items.get(item_entity).type).texture,
+		EFFECT_ASSET_ID::TEXTURED,
+		GEOMETRY_BUFFER_ID::SPRITE,
+		RENDER_LAYER::ITEM,
+	};
 
-	registry.renderRequests.insert(
-		entity,
-		{
-			ITEM_INFO.at(registry.items.get(item_entity).type).texture,
-			EFFECT_ASSET_ID::TEXTURED,
-			GEOMETRY_BUFFER_ID::SPRITE,
-			RENDER_LAYER::ITEM,
-		});
+	// flies at THROW_UPDATE_FACTOR px per ms up to the max of the player's throwable radius
+	vec2 ammo_target = { player_pos.x + THROW_DISTANCE * cosf(angle), player_pos.y + THROW_DISTANCE * sinf(angle) };
+	world.projectiles.launch(entity, player_pos, ammo_target, THROW_UPDATE_FACTOR, damage);
 
 	return true;
 }
 
-Entity createRejuvenationPotion(RenderSystem* renderer)
+Entity createRejuvenationPotion(ECSRegistry& registry, RenderSystem* renderer)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	Terrain& terrain = registry.terrains.emplace(entity);
 	terrain.collision_setting = 2.0f; // no collision
 
@@ -2162,9 +2208,9 @@ Entity createRejuvenationPotion(RenderSystem* renderer)
 }
 
 
-Entity createGlowEffect(RenderSystem* renderer, bool done_growing)
+Entity createGlowEffect(ECSRegistry& registry, RenderSystem* renderer, bool done_growing)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 	TexturedEffect& texturedEffect = registry.texturedEffects.emplace(entity);
 	texturedEffect.done_growing = done_growing;
 
@@ -2191,20 +2237,21 @@ Entity createGlowEffect(RenderSystem* renderer, bool done_growing)
 	return entity;
 }
 
-Entity createCrystalBug(RenderSystem* renderer, vec2 position, int movable, std::string name) {
+Entity createCrystalBug(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name) {
+	ECSRegistry& registry = world.registry;
 	// Persistent ID based on biome, type, and position
-	std::string persistentID = RespawnSystem::getInstance().generatePersistentID(
+	std::string persistentID = world.respawns.generatePersistentID(
 		static_cast<BIOME>(registry.screenStates.components[0].biome),
 		name,
 		position
 	);
 
 	// Check if this entity should spawn according to the respawn system
-	if (!RespawnSystem::getInstance().shouldEntitySpawn(persistentID)) {
-		return Entity(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
+	if (!world.respawns.shouldEntitySpawn(persistentID)) {
+		return Entity::null(); // Return invalid entity if it shouldn't spawn (e.g., on cooldown)
 	}
 
-	auto entity = Entity();
+	auto entity = registry.create();
 	// std::cout << "Entity " << entity.id() << " crystal bug" << std::endl;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
@@ -2218,7 +2265,9 @@ Entity createCrystalBug(RenderSystem* renderer, vec2 position, int movable, std:
 	enemy.persistentID = persistentID;
 
 	// Register with the respawn system
-	RespawnSystem::getInstance().registerEntity(entity, true);
+	world.respawns.registerEntity(entity, true);
+
+	registry.collisionFilters.insert(entity, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
 
 	// store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
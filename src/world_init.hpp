@@ -5,90 +5,92 @@
 #include "systems/render_system.hpp"
 #include "systems/respawn_system.hpp"
 
-Entity createGridLine(vec2 start_pos, vec2 end_pos);
-Entity createBoundaryLine(RenderSystem* renderer, vec2 position, vec2 scale);
+struct World;
 
-Entity createWelcomeScreen(RenderSystem* renderer, vec2 position);
+Entity createGridLine(ECSRegistry& registry, vec2 start_pos, vec2 end_pos);
+Entity createBoundaryLine(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale);
 
-Entity createPlayer(RenderSystem* renderer, vec2 position);
+Entity createWelcomeScreen(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+
+Entity createPlayer(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
 
 // Collectable items and interaction textbox
-Entity createCollectableIngredient(RenderSystem* renderer, vec2 position, ItemType type, int amount, bool canRespawn);
-Entity createTextbox(RenderSystem* renderer, vec2 position, Entity itemEntity, std::string text = "N/A Text Not Set");
+Entity createCollectableIngredient(World& world, RenderSystem* renderer, vec2 position, ItemType type, int amount, bool canRespawn);
+Entity createTextbox(ECSRegistry& registry, RenderSystem* renderer, vec2 position, Entity itemEntity, std::string text = "N/A Text Not Set");
 
 // forest
-Entity createBush(RenderSystem* renderer, vec2 position);
-Entity createTree(RenderSystem* renderer, vec2 position);
-Entity createTreeNoFruit(RenderSystem* renderer, vec2 position);
-Entity createForestBridge(RenderSystem* renderer, vec2 position);
+Entity createBush(World& world, RenderSystem* renderer, vec2 position);
+Entity createTree(World& world, RenderSystem* renderer, vec2 position);
+Entity createTreeNoFruit(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createForestBridge(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
 // the bridge top and bottom are for the mesh part of the forest bridge
-Entity createForestBridgeTop(RenderSystem* renderer, vec2 position);
-Entity createForestBridgeBottom(RenderSystem* renderer, vec2 position);
-Entity createForestRiver(RenderSystem* renderer, vec2 position);
+Entity createForestBridgeTop(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createForestBridgeBottom(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createForestRiver(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
 
 // grotto
-Entity createGrottoStaticEntities(RenderSystem* renderer, vec2 position, vec2 scale, float angle, GLuint texture_asset_id, float can_collide);
-Entity createGrottoPoolMesh(RenderSystem* renderer, vec2 position);
-Entity createCauldron(RenderSystem* renderer, vec2 position, vec2 scale, std::string name, bool create_textbox);
-Entity createMortarPestle(RenderSystem* renderer, vec2 position, vec2 scale, std::string name);
-Entity createChest(RenderSystem* renderer, vec2 position, vec2 scale, std::string name);
-Entity createRecipeBook(RenderSystem* renderer, vec2 position, vec2 scale, std::string name);
+Entity createGrottoStaticEntities(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, float angle, GLuint texture_asset_id, float can_collide);
+Entity createGrottoPoolMesh(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCauldron(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name, bool create_textbox);
+Entity createMortarPestle(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name);
+Entity createChest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name);
+Entity createRecipeBook(ECSRegistry& registry, RenderSystem* renderer, vec2 position, vec2 scale, std::string name);
 
 // desert
-Entity createDesertTree(RenderSystem* renderer, vec2 position);
-Entity createDesertCactus(RenderSystem* renderer, vec2 position);
-Entity createDesertRiver(RenderSystem* renderer, vec2 position);
-Entity createDesertSandPile(RenderSystem* renderer, vec2 position);
-Entity createDesertPage(RenderSystem* renderer, vec2 position);
-Entity createDesertSkull(RenderSystem* renderer, vec2 position);
+Entity createDesertTree(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createDesertCactus(World& world, RenderSystem* renderer, vec2 position);
+Entity createDesertRiver(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createDesertSandPile(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createDesertPage(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createDesertSkull(World& world, RenderSystem* renderer, vec2 position);
 
 // mushroom
-Entity createMushroomAcidLake(RenderSystem* renderer, vec2 position);
-Entity createMushroomAcidLakeMesh(RenderSystem* renderer, vec2 position);
-Entity createMushroomBlue(RenderSystem* renderer, vec2 position);
-Entity createMushroomPink(RenderSystem* renderer, vec2 position);
-Entity createMushroomPurple(RenderSystem* renderer, vec2 position);
-Entity createMushroomTallBlue(RenderSystem* renderer, vec2 position);
-Entity createMushRoomTallPink(RenderSystem* renderer, vec2 position);
+Entity createMushroomAcidLake(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createMushroomAcidLakeMesh(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createMushroomBlue(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createMushroomPink(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createMushroomPurple(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createMushroomTallBlue(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createMushRoomTallPink(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
 
 // crystal
-Entity createCrystal1(RenderSystem* renderer, vec2 position);
-Entity createCrystal2(RenderSystem* renderer, vec2 position);
-Entity createCrystal3(RenderSystem* renderer, vec2 position);
-Entity createCrystal4(RenderSystem* renderer, vec2 position);
-Entity createCrystalMinecart(RenderSystem* renderer, vec2 position);
-Entity createCrystalPage(RenderSystem* renderer, vec2 position);
-Entity createCrystalRock(RenderSystem* renderer, vec2 position);
+Entity createCrystal1(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCrystal2(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCrystal3(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCrystal4(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCrystalMinecart(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCrystalPage(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+Entity createCrystalRock(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
 
 // Entering between biomes
-Entity createForestToGrotto(RenderSystem* renderer, vec2 position, std::string name);
-Entity createGrottoToForest(RenderSystem* renderer, vec2 position, std::string name);
+Entity createForestToGrotto(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
+Entity createGrottoToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
 
-Entity createForestToDesert(RenderSystem* renderer, vec2 position, std::string name);
-Entity createDesertToForest(RenderSystem* renderer, vec2 position, std::string name);
+Entity createForestToDesert(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
+Entity createDesertToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
 
-Entity createForestToForestEx(RenderSystem* renderer, vec2 position, std::string name);
-Entity createForestExToForest(RenderSystem* renderer, vec2 position, std::string name);
+Entity createForestToForestEx(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
+Entity createForestExToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
 
-Entity createForestToMushroom(RenderSystem* renderer, vec2 position, std::string name);
-Entity createMushroomToForest(RenderSystem* renderer, vec2 position, std::string name);
+Entity createForestToMushroom(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
+Entity createMushroomToForest(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
 
-Entity createMushroomToCrystal(RenderSystem* renderer, vec2 position, std::string name);
-Entity createCrystalToMushroom(RenderSystem* renderer, vec2 position, std::string name);
+Entity createMushroomToCrystal(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
+Entity createCrystalToMushroom(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
 
-Entity createCrystalToForestEx(RenderSystem* renderer, vec2 position, std::string name);
-Entity createForestExToCrystal(RenderSystem* renderer, vec2 position, std::string name);
+Entity createCrystalToForestEx(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
+Entity createForestExToCrystal(ECSRegistry& registry, RenderSystem* renderer, vec2 position, std::string name);
 
 // combat
-Entity createEnt(RenderSystem* renderer, vec2 position, int movable, std::string name);
-Entity createMummy(RenderSystem* renderer, vec2 position, int movable, std::string name);
-Entity createEvilMushroom(RenderSystem* renderer, vec2 position, int movable, std::string name);
-Entity createCrystalBug(RenderSystem* renderer, vec2 position, int movable, std::string name);
-Entity createGuardianDesert(RenderSystem* renderer, vec2 position, int movable, std::string name);
-Entity createGuardianMushroom(RenderSystem* renderer, vec2 position, int movable, std::string name);
-Entity createGuardianCrystal(RenderSystem* renderer, vec2 position, int movable, std::string name);
-
-Entity createMasterPotionPedestal(RenderSystem* renderer, vec2 position);
-bool createFiredAmmo(RenderSystem* renderer, vec2 target, Entity& item_entity, Entity& player_entity);
-Entity createRejuvenationPotion(RenderSystem* renderer);
-Entity createGlowEffect(RenderSystem* renderer, bool done_growing);
\ No newline at end of file
+Entity createEnt(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name);
+Entity createMummy(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name);
+Entity createEvilMushroom(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name);
+Entity createCrystalBug(World& world, RenderSystem* renderer, vec2 position, int movable, std::string name);
+Entity createGuardianDesert(ECSRegistry& registry, RenderSystem* renderer, vec2 position, int movable, std::string name);
+Entity createGuardianMushroom(ECSRegistry& registry, RenderSystem* renderer, vec2 position, int movable, std::string name);
+Entity createGuardianCrystal(ECSRegistry& registry, RenderSystem* renderer, vec2 position, int movable, std::string name);
+
+Entity createMasterPotionPedestal(ECSRegistry& registry, RenderSystem* renderer, vec2 position);
+bool createFiredAmmo(World& world, RenderSystem* renderer, vec2 target, Entity& item_entity, Entity& player_entity);
+Entity createRejuvenationPotion(ECSRegistry& registry, RenderSystem* renderer);
+Entity createGlowEffect(ECSRegistry& registry, RenderSystem* renderer, bool done_growing);
\ No newline at end of file
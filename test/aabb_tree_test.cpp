@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../src/systems/aabb_tree.hpp"
+
+// Box and point queries find exactly the boxes a scan over all of them finds
+TEST(AABBTreeTest, QueriesMatchLinearScan) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(0.f, 1000.f);
+    std::uniform_real_distribution<float> size(1.f, 80.f);
+    std::vector<vec4> boxes;
+    AABBTree tree;
+    for (unsigned int i = 0; i < 200; i++) {
+        boxes.push_back({ position(random), position(random), size(random), size(random) });
+        tree.add(i, boxes.back());
+    }
+    tree.build();
+
+    for (int q = 0; q < 50; q++) {
+        vec4 box = { position(random), position(random), size(random), size(random) };
+        std::vector<unsigned int> expected, found;
+        for (unsigned int i = 0; i < boxes.size(); i++) {
+            const vec4& b = boxes[i];
+            if (b.x <= box.x + box.z && b.x + b.z >= box.x && b.y <= box.y + box.w && b.y + b.w >= box.y)
+                expected.push_back(i);
+        }
+        tree.query(box, [&](unsigned int id) { found.push_back(id); });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+
+    std::vector<unsigned int> found;
+    tree.query_point({ boxes[7].x + 0.5f, boxes[7].y + 0.5f }, [&](unsigned int id) { found.push_back(id); });
+    EXPECT_NE(std::find(found.begin(), found.end(), 7u), found.end());
+}
+
+// A ray reports where it enters each box it reaches, and stops at its length
+TEST(AABBTreeTest, RayQuery) {
+    AABBTree tree;
+    tree.add(0, { 10.f, -5.f, 10.f, 10.f });
+    tree.add(1, { 30.f, -5.f, 10.f, 10.f });
+    tree.add(2, { 10.f, 20.f, 10.f, 10.f });
+    tree.build();
+
+    std::vector<std::pair<unsigned int, float>> hits;
+    tree.query_ray({ 0.f, 0.f }, { 1.f, 0.f }, 35.f, [&](unsigned int id, float t) { hits.push_back({ id, t }); });
+    std::sort(hits.begin(), hits.end());
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].first, 0u);
+    EXPECT_FLOAT_EQ(hits[0].second, 10.f);
+    EXPECT_EQ(hits[1].first, 1u);
+    EXPECT_FLOAT_EQ(hits[1].second, 30.f);
+
+    hits.clear();
+    tree.query_ray({ 0.f, 0.f }, { 1.f, 0.f }, 25.f, [&](unsigned int id, float t) { hits.push_back({ id, t }); });
+    EXPECT_EQ(hits.size(), 1u);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../src/common.hpp"
+#include "../src/systems/collision_world.hpp"
+#include "../src/tinyECS/registry.hpp"
+
+class CollisionWorldTest : public ::testing::Test {
+protected:
+    ECSRegistry registry;
+    CollisionWorld collision;
+    Mesh triangle;
+
+    void SetUp() override {
+        registry.clear_all_components();
+        // the corners of a right triangle, its right angle at the origin
+        triangle.vertices = { { { 0.f, 0.f, 0.f }, {} }, { { 100.f, 0.f, 0.f }, {} }, { { 0.f, 100.f, 0.f }, {} } };
+        triangle.vertex_indices = { 0, 1, 2 };
+    }
+
+    // A solid whose collision box is the whole of (x, y, width, height)
+    Entity add_box(float x, float y, float width, float height) {
+        Entity entity = registry.create();
+        Motion& motion = registry.motions.emplace(entity);
+        motion.position = { x + width / 2, y + height / 2 };
+        motion.scale = { width, height };
+        registry.terrains.emplace(entity).collision_setting = 1.f;
+        registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
+        return entity;
+    }
+
+    // A solid colliding with the triangle, its right angle at position
+    Entity add_triangle(vec2 position) {
+        Entity entity = registry.create();
+        Motion& motion = registry.motions.emplace(entity);
+        motion.position = position;
+        motion.scale = { 1.f, 1.f };
+        registry.terrains.emplace(entity).collision_setting = 3.f;
+        registry.meshPtrs.insert(entity, &triangle);
+        registry.collisionFilters.insert(entity, { COLLISION_SOLID, 0 });
+        return entity;
+    }
+
+    bool blocked(vec4 box, vec2 moved) const {
+        return collision.overlapsAny({ box.x + moved.x, box.y + moved.y, box.z, box.w }, COLLISION_SOLID);
+    }
+};
+
+// A box running into a wall stops flush against it, other masks and empty moves pass
+TEST_F(CollisionWorldTest, StopsFlushAgainstBox) {
+    add_box(100.f, 0.f, 20.f, 100.f);
+    collision.build_terrain(registry);
+
+    vec4 box = { 50.f, 40.f, 10.f, 10.f };
+    vec2 moved = collision.moveAndSlide(box, { 100.f, 0.f }, COLLISION_SOLID);
+    EXPECT_NEAR(moved.x, 40.f, 0.05f);
+    EXPECT_FLOAT_EQ(moved.y, 0.f);
+    EXPECT_FALSE(blocked(box, moved));
+
+    EXPECT_EQ(collision.moveAndSlide(box, { 100.f, 0.f }, COLLISION_PLAYER), vec2(100.f, 0.f));
+    EXPECT_EQ(collision.moveAndSlide(box, { 0.f, 0.f }, COLLISION_SOLID), vec2(0.f, 0.f));
+    EXPECT_EQ(collision.moveAndSlide(box, { -30.f, 20.f }, COLLISION_SOLID), vec2(-30.f, 20.f));
+}
+
+// A diagonal move into a wall keeps going along it
+TEST_F(CollisionWorldTest, SlidesAlongWall) {
+    add_box(100.f, 0.f, 20.f, 100.f);
+    collision.build_terrain(registry);
+
+    vec4 box = { 50.f, 40.f, 10.f, 10.f };
+    vec2 moved = collision.moveAndSlide(box, { 100.f, 30.f }, COLLISION_SOLID);
+    EXPECT_NEAR(moved.x, 40.f, 0.05f);
+    EXPECT_NEAR(moved.y, 30.f, 0.05f);
+    EXPECT_FALSE(blocked(box, moved));
+}
+
+// A move into an inside corner stops at both walls, one onto an outside corner slides past it
+TEST_F(CollisionWorldTest, Corners) {
+    add_box(100.f, 0.f, 20.f, 120.f);
+    add_box(0.f, 100.f, 100.f, 20.f);
+    add_box(200.f, 200.f, 20.f, 20.f);
+    collision.build_terrain(registry);
+
+    vec4 box = { 50.f, 50.f, 10.f, 10.f };
+    vec2 moved = collision.moveAndSlide(box, { 100.f, 100.f }, COLLISION_SOLID);
+    EXPECT_NEAR(moved.x, 40.f, 0.05f);
+    EXPECT_NEAR(moved.y, 40.f, 0.05f);
+    EXPECT_FALSE(blocked(box, moved));
+
+    // the bottom right corner of the box runs exactly onto the top left corner of the solid
+    box = { 130.f, 130.f, 10.f, 10.f };
+    moved = collision.moveAndSlide(box, { 80.f, 80.f }, COLLISION_SOLID);
+    EXPECT_FALSE(blocked(box, moved));
+    EXPECT_TRUE(std::abs(moved.x - 60.f) < 0.05f || std::abs(moved.y - 60.f) < 0.05f);
+    EXPECT_GT(moved.x + moved.y, 120.f);
+}
+
+// Meshes stop a box at their triangles, not at their bounds
+TEST_F(CollisionWorldTest, SweepsAgainstMesh) {
+    add_triangle({ 200.f, 0.f });
+    collision.build_terrain(registry);
+
+    vec4 box = { 150.f, 20.f, 10.f, 10.f };
+    vec2 moved = collision.moveAndSlide(box, { 100.f, 0.f }, COLLISION_SOLID);
+    EXPECT_NEAR(moved.x, 40.f, 0.1f);
+    EXPECT_FLOAT_EQ(moved.y, 0.f);
+    EXPECT_FALSE(blocked(box, moved));
+
+    // from the right, the box stops at the long side, inside the mesh's bounds
+    box = { 300.f, 50.f, 10.f, 10.f };
+    moved = collision.moveAndSlide(box, { -100.f, 0.f }, COLLISION_SOLID);
+    EXPECT_NEAR(moved.x, -50.f, 0.1f);
+    EXPECT_FALSE(blocked(box, moved));
+
+    // past the corner nothing is in the way
+    box = { 310.f, 120.f, 10.f, 10.f };
+    EXPECT_EQ(collision.moveAndSlide(box, { -200.f, 0.f }, COLLISION_SOLID), vec2(-200.f, 0.f));
+}
+
+// A box that starts inside a solid can walk out of it and along it, but not any deeper into it
+TEST_F(CollisionWorldTest, AlreadyOverlapping) {
+    add_box(100.f, 0.f, 200.f, 100.f);
+    add_box(60.f, 0.f, 10.f, 100.f);
+    collision.build_terrain(registry);
+
+    vec4 box = { 102.f, 40.f, 10.f, 10.f };
+    EXPECT_EQ(collision.moveAndSlide(box, { 20.f, 0.f }, COLLISION_SOLID), vec2(0.f, 0.f));
+    EXPECT_EQ(collision.moveAndSlide(box, { 0.f, 5.f }, COLLISION_SOLID), vec2(0.f, 5.f));
+    // only the part of a diagonal move that does not go deeper is made
+    EXPECT_EQ(collision.moveAndSlide(box, { 20.f, 5.f }, COLLISION_SOLID), vec2(0.f, 5.f));
+
+    // on the way out it is stopped by the other solids
+    vec2 moved = collision.moveAndSlide(box, { -60.f, 0.f }, COLLISION_SOLID);
+    EXPECT_NEAR(moved.x, -32.f, 0.05f);
+    EXPECT_FLOAT_EQ(moved.y, 0.f);
+}
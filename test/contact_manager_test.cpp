@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/systems/contact_manager.hpp"
+
+static std::vector<ContactState> states_of(const ContactManager& contacts, Entity entity, Entity other) {
+    std::vector<ContactState> states;
+    for (const ContactEvent& event : contacts.events())
+        if (event.entity == entity && event.other == other)
+            states.push_back(event.state);
+    return states;
+}
+
+// A pair begins, stays while it is found again and ends the first step it is not, duplicates count once
+TEST(ContactManagerTest, ReportsBeginStayEnd) {
+    EntityPool pool;
+    Entity player = pool.create(), enemy = pool.create(), tree = pool.create();
+    ContactManager contacts;
+
+    contacts.begin_step();
+    contacts.add(player, enemy);
+    contacts.add(player, enemy);
+    contacts.add(player, tree);
+    contacts.end_step();
+    EXPECT_EQ(contacts.contacts().size(), 2u);
+    EXPECT_EQ(states_of(contacts, player, enemy), std::vector<ContactState>{ ContactState::BEGIN });
+    EXPECT_EQ(states_of(contacts, player, tree), std::vector<ContactState>{ ContactState::BEGIN });
+
+    contacts.begin_step();
+    contacts.add(player, tree);
+    contacts.end_step();
+    EXPECT_EQ(contacts.contacts().size(), 1u);
+    EXPECT_EQ(states_of(contacts, player, enemy), std::vector<ContactState>{ ContactState::END });
+    EXPECT_EQ(states_of(contacts, player, tree), std::vector<ContactState>{ ContactState::STAY });
+
+    // the other way round is another pair
+    contacts.begin_step();
+    contacts.add(tree, player);
+    contacts.end_step();
+    EXPECT_EQ(states_of(contacts, tree, player), std::vector<ContactState>{ ContactState::BEGIN });
+    EXPECT_EQ(states_of(contacts, player, tree), std::vector<ContactState>{ ContactState::END });
+    EXPECT_EQ(contacts.events().size(), 2u);
+
+    // cleared contacts do not end, they begin again when found
+    contacts.clear();
+    EXPECT_TRUE(contacts.events().empty());
+    contacts.begin_step();
+    contacts.add(tree, player);
+    contacts.end_step();
+    EXPECT_EQ(states_of(contacts, tree, player), std::vector<ContactState>{ ContactState::BEGIN });
+}
+
+// Forgotten contacts do not end, they begin again the next time they are found, other pairs carry on
+TEST(ContactManagerTest, Forget) {
+    EntityPool pool;
+    Entity ammo = pool.create(), enemy = pool.create(), tree = pool.create(), player = pool.create();
+    ContactManager contacts;
+
+    contacts.begin_step();
+    contacts.add(ammo, enemy);
+    contacts.add(ammo, tree);
+    contacts.add(player, enemy);
+    contacts.add(tree, ammo);
+    contacts.end_step();
+
+    contacts.forget(ammo);
+    EXPECT_EQ(contacts.contacts().size(), 2u);
+
+    contacts.begin_step();
+    contacts.add(ammo, enemy);
+    contacts.add(player, enemy);
+    contacts.end_step();
+    EXPECT_EQ(states_of(contacts, ammo, enemy), std::vector<ContactState>{ ContactState::BEGIN });
+    EXPECT_TRUE(states_of(contacts, ammo, tree).empty());
+    EXPECT_EQ(states_of(contacts, player, enemy), std::vector<ContactState>{ ContactState::STAY });
+    EXPECT_EQ(states_of(contacts, tree, ammo), std::vector<ContactState>{ ContactState::END });
+
+    // forgetting an entity without contacts changes nothing
+    contacts.forget(tree);
+    contacts.forget(Entity::null());
+    EXPECT_EQ(contacts.contacts().size(), 2u);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "../src/tinyECS/frame_arena.hpp"
+
+// Allocations are aligned, freed all at once by reset, and a frame larger than the arena makes it grow
+TEST(FrameArenaTest, AllocateAndReset) {
+    FrameArena arena(256);
+    void* a = arena.allocate(10, 1);
+    void* b = arena.allocate(16, 16);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 16, 0u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.allocate(10, 1), a);
+
+    // overflowing blocks keep earlier allocations valid until the next reset
+    int* first = static_cast<int*>(arena.allocate(sizeof(int), alignof(int)));
+    *first = 42;
+    arena.allocate(1000, 8);
+    EXPECT_EQ(*first, 42);
+    EXPECT_GE(arena.used(), 1000u);
+
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 1000u + 256u);
+}
+
+// Once the arena has grown to fit a frame, later frames like it do not touch the heap
+TEST(FrameArenaTest, SteadyStateDoesNotAllocate) {
+    FrameArena arena(64);
+    size_t allocations = 0;
+    for (int frame = 0; frame < 3; frame++) {
+        arena.reset();
+        size_t before = heap_allocations();
+        FrameVector<int> values{ ArenaAllocator<int>(arena) };
+        for (int i = 0; i < 1000; i++)
+            values.push_back(i);
+        EXPECT_EQ(values[999], 999);
+        allocations = heap_allocations() - before;
+    }
+    EXPECT_EQ(allocations, 0u);
+}
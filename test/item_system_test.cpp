@@ -2,11 +2,14 @@
 #include "../src/common.hpp"
 #include "../src/systems/item_system.hpp"
 #include "../src/tinyECS/registry.hpp"
+#include "../src/world.hpp"
 
 // Based on googletest docs: http://google.github.io/googletest/reference/testing.html
 class ItemSystemTest : public ::testing::Test {
 protected:
-    ItemSystem item_system;
+    World world;
+    ECSRegistry& registry = world.registry;
+    ItemSystem item_system{ world };
 
     void SetUp() override {
         // Reset the registry before each test
@@ -17,7 +20,7 @@ protected:
 // Test item creation and initialization
 TEST_F(ItemSystemTest, ItemCreation) {
     // Test basic item
-    Entity basic = ItemSystem::createItem(ItemType::COFFEE_BEANS, 5);
+    Entity basic = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 5);
     ASSERT_TRUE(registry.items.has(basic));
     Item& item = registry.items.get(basic);
     EXPECT_EQ(item.type, ItemType::COFFEE_BEANS);
@@ -25,13 +28,13 @@ TEST_F(ItemSystemTest, ItemCreation) {
     EXPECT_FALSE(item.isCollectable);
     
     // Test basic item with explicit isCollectable = true
-    Entity collectible = ItemSystem::createItem(ItemType::COFFEE_BEANS, 1, true);
+    Entity collectible = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 1, true);
     ASSERT_TRUE(registry.items.has(collectible));
     Item& coll_item = registry.items.get(collectible);
     EXPECT_TRUE(coll_item.isCollectable);
     
     // Test ingredient
-    Entity ingredient = ItemSystem::createIngredient(ItemType::MAGICAL_FRUIT, 3);
+    Entity ingredient = ItemSystem::createIngredient(registry, ItemType::MAGICAL_FRUIT, 3);
     ASSERT_TRUE(registry.items.has(ingredient));
     ASSERT_TRUE(registry.ingredients.has(ingredient));
     Ingredient& ing = registry.ingredients.get(ingredient);
@@ -39,7 +42,7 @@ TEST_F(ItemSystemTest, ItemCreation) {
     EXPECT_FALSE(registry.items.get(ingredient).isCollectable);
     
     // Test potion
-    Entity potion = ItemSystem::createPotion(PotionEffect::SPEED, 30, vec3(1,0,0), 0.8f, 3.0f, 1);
+    Entity potion = ItemSystem::createPotion(registry, PotionEffect::SPEED, 30, vec3(1,0,0), 0.8f, 3.0f, 1);
     ASSERT_TRUE(registry.items.has(potion));
     ASSERT_TRUE(registry.potions.has(potion));
     Potion& pot = registry.potions.get(potion);
@@ -53,30 +56,30 @@ TEST_F(ItemSystemTest, ItemCreation) {
 // Test inventory operations
 TEST_F(ItemSystemTest, InventoryOperations) {
     // Create test inventory
-    Entity inv = Entity();
+    Entity inv = registry.create();
     Inventory& inventory = registry.inventories.emplace(inv);
     inventory.capacity = 5;
     
     // Test adding items
-    Entity item1 = ItemSystem::createItem(ItemType::COFFEE_BEANS, 1);
-    Entity item2 = ItemSystem::createItem(ItemType::MAGICAL_FRUIT, 1);
+    Entity item1 = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 1);
+    Entity item2 = ItemSystem::createItem(registry, ItemType::MAGICAL_FRUIT, 1);
     
-    EXPECT_TRUE(item_system.addItemToInventory(inv, item1));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, item1));
     EXPECT_EQ(inventory.items.size(), 1);
-    EXPECT_TRUE(item_system.addItemToInventory(inv, item2));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, item2));
     EXPECT_EQ(inventory.items.size(), 2);
     
     // Test removing items
-    EXPECT_TRUE(item_system.removeItemFromInventory(inv, item1));
+    EXPECT_TRUE(item_system.removeItemFromInventory(world, inv, item1));
     EXPECT_EQ(inventory.items.size(), 1);
-    EXPECT_FALSE(item_system.removeItemFromInventory(inv, item1)); // Already removed
+    EXPECT_FALSE(item_system.removeItemFromInventory(world, inv, item1)); // Already removed
     
     // Test stacking
-    Entity stackable1 = ItemSystem::createItem(ItemType::COFFEE_BEANS, 5);
-    Entity stackable2 = ItemSystem::createItem(ItemType::COFFEE_BEANS, 3);
+    Entity stackable1 = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 5);
+    Entity stackable2 = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 3);
     
-    EXPECT_TRUE(item_system.addItemToInventory(inv, stackable1));
-    EXPECT_TRUE(item_system.addItemToInventory(inv, stackable2));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, stackable1));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, stackable2));
     
     // Should have merged into one stack of 8
     bool found_stack = false;
@@ -95,26 +98,26 @@ TEST_F(ItemSystemTest, InventoryOperations) {
 // Test serialization and persistence
 TEST_F(ItemSystemTest, Serialization) {
     // Create test data
-    Entity inv = Entity();
+    Entity inv = registry.create();
     Inventory& inventory = registry.inventories.emplace(inv);
     inventory.capacity = 10;
     
-    Entity item = ItemSystem::createItem(ItemType::COFFEE_BEANS, 5);
-    Entity potion = ItemSystem::createPotion(PotionEffect::SPEED, 30, vec3(1,0,0), 0.9f, 3.0f, 1);
-    Entity ingredient = ItemSystem::createIngredient(ItemType::MAGICAL_FRUIT, 2);
+    Entity item = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 5);
+    Entity potion = ItemSystem::createPotion(registry, PotionEffect::SPEED, 30, vec3(1,0,0), 0.9f, 3.0f, 1);
+    Entity ingredient = ItemSystem::createIngredient(registry, ItemType::MAGICAL_FRUIT, 2);
     
-    EXPECT_TRUE(item_system.addItemToInventory(inv, item));
-    EXPECT_TRUE(item_system.addItemToInventory(inv, potion));
-    EXPECT_TRUE(item_system.addItemToInventory(inv, ingredient));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, item));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, potion));
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, ingredient));
     
     // Save state
-    EXPECT_TRUE(item_system.saveGameState());
+    EXPECT_TRUE(item_system.saveGameState(world));
     
     // Clear everything
     registry.clear_all_components();
     
     // Load state
-    EXPECT_TRUE(item_system.loadGameState());
+    EXPECT_TRUE(item_system.loadGameState(world));
     
     // Verify loaded data
     bool found_inventory = false;
@@ -155,41 +158,41 @@ TEST_F(ItemSystemTest, Serialization) {
 // Test error handling
 TEST_F(ItemSystemTest, ErrorHandling) {
     // Test invalid inventory operations
-    Entity invalid_inv = Entity();
-    Entity invalid_item = Entity();
-    EXPECT_FALSE(item_system.addItemToInventory(invalid_inv, invalid_item));
-    EXPECT_FALSE(item_system.removeItemFromInventory(invalid_inv, invalid_item));
+    Entity invalid_inv = registry.create();
+    Entity invalid_item = registry.create();
+    EXPECT_FALSE(item_system.addItemToInventory(world, invalid_inv, invalid_item));
+    EXPECT_FALSE(item_system.removeItemFromInventory(world, invalid_inv, invalid_item));
     
     // Test inventory capacity limits
-    Entity inv = Entity();
+    Entity inv = registry.create();
     Inventory& inventory = registry.inventories.emplace(inv);
     inventory.capacity = 1;
     
-    Entity item1 = ItemSystem::createItem(ItemType::COFFEE_BEANS, 1);
-    Entity item2 = ItemSystem::createItem(ItemType::MAGICAL_FRUIT, 1);
+    Entity item1 = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 1);
+    Entity item2 = ItemSystem::createItem(registry, ItemType::MAGICAL_FRUIT, 1);
     
-    EXPECT_TRUE(item_system.addItemToInventory(inv, item1));
-    EXPECT_FALSE(item_system.addItemToInventory(inv, item2)); // Should fail, inventory full
+    EXPECT_TRUE(item_system.addItemToInventory(world, inv, item1));
+    EXPECT_FALSE(item_system.addItemToInventory(world, inv, item2)); // Should fail, inventory full
     
     // Test invalid serialization operations
-    EXPECT_FALSE(item_system.loadGameState());
+    EXPECT_FALSE(item_system.loadGameState(world));
 }
 
 // Test entity ID continuity
 TEST_F(ItemSystemTest, EntityIDContinuity) {
     // Create and save an item
-    Entity item1 = ItemSystem::createItem(ItemType::COFFEE_BEANS, 1);
+    Entity item1 = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 1);
     unsigned int first_id = item1.id();
     
     // Save state
-    EXPECT_TRUE(item_system.saveGameState());
+    EXPECT_TRUE(item_system.saveGameState(world));
     
     // Clear everything
     registry.clear_all_components();
     
     // Load state and create a new item
-    EXPECT_TRUE(item_system.loadGameState());
-    Entity item2 = ItemSystem::createItem(ItemType::MAGICAL_FRUIT, 1);
+    EXPECT_TRUE(item_system.loadGameState(world));
+    Entity item2 = ItemSystem::createItem(registry, ItemType::MAGICAL_FRUIT, 1);
     
     // The new item should have a new unique ID
     EXPECT_NE(item2.id(), first_id);
@@ -198,36 +201,36 @@ TEST_F(ItemSystemTest, EntityIDContinuity) {
 // Test different inventory types serialization
 TEST_F(ItemSystemTest, DifferentInventoryTypes) {
     // Create player inventory
-    Entity player_inv = Entity();
+    Entity player_inv = registry.create();
     Inventory& player_inventory = registry.inventories.emplace(player_inv);
     player_inventory.capacity = 10;
-    Entity player_item = ItemSystem::createItem(ItemType::COFFEE_BEANS, 5);
-    EXPECT_TRUE(item_system.addItemToInventory(player_inv, player_item));
+    Entity player_item = ItemSystem::createItem(registry, ItemType::COFFEE_BEANS, 5);
+    EXPECT_TRUE(item_system.addItemToInventory(world, player_inv, player_item));
     
     // Create cauldron inventory
-    Entity cauldron_inv = Entity();
+    Entity cauldron_inv = registry.create();
     Inventory& cauldron_inventory = registry.inventories.emplace(cauldron_inv);
     registry.cauldrons.emplace(cauldron_inv);  // Add cauldron component
     cauldron_inventory.capacity = 5;
-    Entity cauldron_item = ItemSystem::createIngredient(ItemType::MAGICAL_FRUIT, 2);
-    EXPECT_TRUE(item_system.addItemToInventory(cauldron_inv, cauldron_item));
+    Entity cauldron_item = ItemSystem::createIngredient(registry, ItemType::MAGICAL_FRUIT, 2);
+    EXPECT_TRUE(item_system.addItemToInventory(world, cauldron_inv, cauldron_item));
     
     // Create chest inventory
-    Entity chest_inv = Entity();
+    Entity chest_inv = registry.create();
     Inventory& chest_inventory = registry.inventories.emplace(chest_inv);
     registry.chests.emplace(chest_inv);  // Add chest component
     chest_inventory.capacity = 15;
-    Entity chest_item = ItemSystem::createPotion(PotionEffect::SPEED, 30, vec3(1,0,0), 0.8f, 3.0f, 1);
-    EXPECT_TRUE(item_system.addItemToInventory(chest_inv, chest_item));
+    Entity chest_item = ItemSystem::createPotion(registry, PotionEffect::SPEED, 30, vec3(1,0,0), 0.8f, 3.0f, 1);
+    EXPECT_TRUE(item_system.addItemToInventory(world, chest_inv, chest_item));
     
     // Save state
-    EXPECT_TRUE(item_system.saveGameState());
+    EXPECT_TRUE(item_system.saveGameState(world));
     
     // Clear everything
     registry.clear_all_components();
     
     // Load state
-    EXPECT_TRUE(item_system.loadGameState());
+    EXPECT_TRUE(item_system.loadGameState(world));
     
     // Verify all inventory types were restored correctly
     bool found_player = false, found_cauldron = false, found_chest = false;
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include "../src/tinyECS/job_system.hpp"
+#include "../src/tinyECS/frame_arena.hpp"
+
+// Every index is visited exactly once, whatever thread runs the chunk
+TEST(JobSystemTest, ParallelForCoversRange) {
+    JobSystem jobs(3);
+    std::vector<int> hits(100000, 0);
+    jobs.parallel_for(0, hits.size(), 1000, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) hits[i]++;
+    });
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), (int)hits.size());
+    EXPECT_EQ(*std::min_element(hits.begin(), hits.end()), 1);
+}
+
+// Jobs may submit and wait for more jobs, and a pool without workers runs everything inline
+TEST(JobSystemTest, NestedJobs) {
+    for (unsigned int workers : { 0u, 2u }) {
+        JobSystem jobs(workers);
+        std::atomic<int> count{ 0 };
+        JobSystem::Group outer;
+        for (int i = 0; i < 8; i++) {
+            jobs.submit(outer, [&]() {
+                JobSystem::Group inner;
+                for (int j = 0; j < 8; j++)
+                    jobs.submit(inner, [&]() { count++; });
+                jobs.wait(inner);
+            });
+        }
+        jobs.wait(outer);
+        EXPECT_EQ(count.load(), 64);
+    }
+}
+
+// Workers drop what they took from their frame arenas once a new frame begins, so the arenas do not
+// fill up over the frames
+TEST(JobSystemTest, ResetsWorkerFrameArenas) {
+    JobSystem jobs(2);
+    std::atomic<size_t> most_used{ 0 };
+    for (int frame = 0; frame < 50; frame++) {
+        frame_arena().reset();
+        jobs.reset_frame_arenas();
+        jobs.parallel_for(0, 64, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                frame_arena().allocate(1024, 8);
+            size_t used = frame_arena().used();
+            size_t seen = most_used.load();
+            while (used > seen && !most_used.compare_exchange_weak(seen, used)) {}
+        });
+    }
+    // at most every chunk of one frame on the same thread
+    EXPECT_LE(most_used.load(), 64u * 1024u + 64u * 8u);
+}
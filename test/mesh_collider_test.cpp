@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../src/systems/mesh_collider.hpp"
+#include "../src/systems/physics_system.hpp"
+
+// The triangle tree finds exactly the overlaps a test of the box against every triangle finds
+TEST(MeshColliderTest, OverlapsMatchBruteForce) {
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> coordinate(-1.f, 1.f);
+    std::uniform_real_distribution<float> position(0.f, 500.f);
+    std::uniform_real_distribution<float> angle(0.f, 6.3f);
+    std::uniform_real_distribution<float> scale(20.f, 200.f);
+    std::uniform_real_distribution<float> size(0.5f, 60.f);
+
+    int overlapping = 0;
+    for (int m = 0; m < 20; m++) {
+        Mesh mesh;
+        std::uniform_int_distribution<int> vertex_count(3, 40);
+        int vertices = vertex_count(random);
+        for (int i = 0; i < vertices; i++)
+            mesh.vertices.push_back({ { coordinate(random), coordinate(random), 0.f }, {} });
+        std::uniform_int_distribution<int> vertex(0, vertices - 1);
+        for (int i = 0; i < 3 * vertices; i++)
+            mesh.vertex_indices.push_back((uint16_t)vertex(random));
+
+        Motion motion;
+        motion.position = { position(random), position(random) };
+        motion.angle = angle(random);
+        motion.scale = { scale(random), scale(random) };
+        MeshCollider collider;
+        collider.build(mesh, motion);
+        EXPECT_TRUE(collider.built_for(mesh, motion));
+
+        FrameVector<vec2> corners = PhysicsSystem::get_transformed_vertices(mesh, motion);
+        for (int q = 0; q < 200; q++) {
+            vec4 box = { position(random) - 30.f, position(random) - 30.f, size(random), size(random) };
+            bool expected = false;
+            for (size_t i = 0; i + 2 < mesh.vertex_indices.size(); i += 3)
+                expected = expected || triangleBoxOverlap(corners[mesh.vertex_indices[i]], corners[mesh.vertex_indices[i + 1]], corners[mesh.vertex_indices[i + 2]], box);
+            EXPECT_EQ(collider.overlaps(box), expected);
+            overlapping += expected;
+        }
+
+        // moving the entity makes the collider stale
+        motion.position.x += 1.f;
+        EXPECT_FALSE(collider.built_for(mesh, motion));
+    }
+    // the boxes both hit and miss often enough for the comparison to mean something
+    EXPECT_GT(overlapping, 200);
+    EXPECT_LT(overlapping, 3800);
+}
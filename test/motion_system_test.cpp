@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "../src/common.hpp"
+#include "../src/systems/motion_system.hpp"
+#include "../src/tinyECS/registry.hpp"
+
+class MotionSystemTest : public ::testing::Test {
+protected:
+    ECSRegistry registry;
+    MotionSystem motion_system{ registry };
+
+    void SetUp() override {
+        registry.clear_all_components();
+        registry.screenStates.emplace(registry.create());
+    }
+};
+
+// The vector kernel matches the scalar update, including the padded tail
+TEST_F(MotionSystemTest, IntegrateMatchesScalar) {
+    MotionSoA soa;
+    std::vector<Motion> motions(11);
+    soa.reset(motions.size());
+    for (size_t i = 0; i < motions.size(); i++) {
+        motions[i].position = { (float)i, -(float)i };
+        motions[i].velocity = { 2.f * i, 0.5f };
+        soa.add(motions[i], 0.25f);
+    }
+    soa.pad();
+    ASSERT_EQ(soa.padded_size() % MotionSoA::LANES, 0);
+
+    MotionSystem::integrate(soa);
+    for (size_t i = 0; i < motions.size(); i++) {
+        EXPECT_FLOAT_EQ(soa.previous_x[i], motions[i].position.x);
+        EXPECT_FLOAT_EQ(soa.previous_y[i], motions[i].position.y);
+        EXPECT_FLOAT_EQ(soa.x[i], motions[i].position.x + motions[i].velocity.x * 0.25f);
+        EXPECT_FLOAT_EQ(soa.y[i], motions[i].position.y + motions[i].velocity.y * 0.25f);
+    }
+    for (size_t i = motions.size(); i < soa.padded_size(); i++)
+        EXPECT_EQ(soa.x[i], 0.f);
+
+    soa.scatter();
+    EXPECT_FLOAT_EQ(motions[3].previous_position.x, 3.f);
+    EXPECT_FLOAT_EQ(motions[3].position.x, 3.f + 6.f * 0.25f);
+}
+
+// Stepping through the SoA path moves the same entities to the same places as the in-place update
+TEST_F(MotionSystemTest, SoAStepMatchesInPlace) {
+    ECSRegistry other;
+    other.screenStates.emplace(other.create());
+    MotionSystem soa_system(other);
+    soa_system.use_soa = true;
+
+    for (ECSRegistry* r : { &registry, &other }) {
+        for (int i = 0; i < 20; i++) {
+            Entity e = r->create();
+            Motion& motion = r->motions.emplace(e);
+            motion.position = { (float)i, 10.f };
+            motion.velocity = { 10.f * i, i % 3 == 0 ? 0.f : -5.f };
+            if (i == 0)
+                r->players.emplace(e);
+            else if (i % 2)
+                r->guardians.emplace(e);
+            else
+                r->enemies.emplace(e);
+        }
+    }
+
+    for (int frame = 0; frame < 3; frame++) {
+        motion_system.step(16.f);
+        soa_system.step(16.f);
+    }
+    ASSERT_EQ(registry.motions.size(), other.motions.size());
+    for (size_t i = 0; i < registry.motions.size(); i++) {
+        EXPECT_FLOAT_EQ(registry.motions.components[i].position.x, other.motions.components[i].position.x);
+        EXPECT_FLOAT_EQ(registry.motions.components[i].position.y, other.motions.components[i].position.y);
+        EXPECT_FLOAT_EQ(registry.motions.components[i].previous_position.x, other.motions.components[i].previous_position.x);
+    }
+}
+
+// Only the player and moving guardians are advanced, thrown ammo is moved by the ProjectileSystem
+TEST_F(MotionSystemTest, StepMovesOnlyMovingEntities) {
+    Entity player = registry.create(), guardian = registry.create(), ammo = registry.create(), idle_ammo = registry.create(), enemy = registry.create();
+    for (Entity e : { player, guardian, ammo, idle_ammo, enemy }) {
+        Motion& motion = registry.motions.emplace(e);
+        motion.position = { 10.f, 10.f };
+        motion.velocity = { 100.f, 0.f };
+    }
+    registry.players.emplace(player);
+    registry.guardians.emplace(guardian);
+    registry.ammo.emplace(ammo).is_fired = true;
+    registry.ammo.emplace(idle_ammo);
+    registry.enemies.emplace(enemy);
+
+    motion_system.step(10.f);
+    EXPECT_FLOAT_EQ(registry.motions.get(player).position.x, 10.f + 100.f * 10.f * TIME_UPDATE_FACTOR);
+    EXPECT_FLOAT_EQ(registry.motions.get(player).previous_position.x, 10.f);
+    EXPECT_FLOAT_EQ(registry.motions.get(guardian).position.x, 10.f + 100.f * 10.f * TIME_UPDATE_FACTOR);
+    EXPECT_FLOAT_EQ(registry.motions.get(ammo).position.x, 10.f);
+    EXPECT_FLOAT_EQ(registry.motions.get(idle_ammo).position.x, 10.f);
+    EXPECT_FLOAT_EQ(registry.motions.get(enemy).position.x, 10.f);
+}
+
+// Worlds do not share state, stepping one registry leaves another untouched
+TEST_F(MotionSystemTest, SeparateRegistries) {
+    ECSRegistry other;
+    other.screenStates.emplace(other.create());
+    MotionSystem other_motion_system(other);
+
+    Entity player = registry.create(), other_player = other.create();
+    registry.motions.emplace(player).velocity = { 100.f, 0.f };
+    registry.players.emplace(player);
+    other.motions.emplace(other_player).velocity = { 100.f, 0.f };
+    other.players.emplace(other_player);
+
+    other_motion_system.step(10.f);
+    EXPECT_EQ(player, other_player); // each registry numbers its entities on its own
+    EXPECT_FLOAT_EQ(registry.motions.get(player).position.x, 0.f);
+    EXPECT_FLOAT_EQ(other.motions.get(other_player).position.x, 100.f * 10.f * TIME_UPDATE_FACTOR);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../src/systems/occupancy_grid.hpp"
+
+static bool overlaps(const vec4& a, const vec4& b) {
+    return a.x < b.x + b.z && a.x + a.z > b.x && a.y < b.y + b.w && a.y + a.w > b.y;
+}
+
+// Only the cells a marked box touches are blocked, across the 64 bit word boundaries of a row
+TEST(OccupancyGridTest, MarksTouchedCells) {
+    OccupancyGrid grid;
+    grid.reset({ 0.f, 0.f, 1000.f, 50.f }, 5.f);
+    EXPECT_EQ(grid.column_count(), 201);
+    EXPECT_FALSE(grid.any({ 0.f, 0.f, 1000.f, 50.f }));
+
+    grid.mark({ 318.f, 12.f, 4.f, 4.f });
+    EXPECT_TRUE(grid.blocked(63, 2));
+    EXPECT_TRUE(grid.blocked(64, 3));
+    EXPECT_FALSE(grid.blocked(62, 2));
+    EXPECT_FALSE(grid.blocked(65, 3));
+
+    EXPECT_TRUE(grid.any({ 0.f, 0.f, 1000.f, 50.f }));
+    EXPECT_TRUE(grid.any({ 321.f, 16.f, 100.f, 1.f }));
+    EXPECT_FALSE(grid.any({ 0.f, 0.f, 314.f, 50.f }));
+    EXPECT_FALSE(grid.any({ 325.f, 0.f, 600.f, 50.f }));
+    EXPECT_FALSE(grid.any({ 300.f, 20.f, 50.f, 10.f }));
+    // boxes reaching past the grid only look at the part inside it
+    EXPECT_TRUE(grid.any({ 319.f, -100.f, 1.f, 200.f }));
+    EXPECT_FALSE(grid.any({ -100.f, -100.f, 50.f, 50.f }));
+
+    // a filtered mark only takes the cells the filter accepts
+    grid.mark_if({ 500.f, 0.f, 50.f, 50.f }, [](const vec4& cell) { return cell.x >= 520.f && cell.y >= 20.f; });
+    EXPECT_FALSE(grid.any({ 500.f, 0.f, 19.f, 50.f }));
+    EXPECT_FALSE(grid.any({ 500.f, 0.f, 50.f, 19.f }));
+    EXPECT_TRUE(grid.any({ 521.f, 21.f, 1.f, 1.f }));
+}
+
+// A box overlapping a marked box always finds a marked cell, so a free answer can be trusted
+TEST(OccupancyGridTest, NeverMissesAnOverlap) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(0.f, 1200.f);
+    std::uniform_real_distribution<float> size(0.f, 80.f);
+
+    std::vector<vec4> solids;
+    for (int i = 0; i < 60; i++)
+        solids.push_back({ coordinate(rng), coordinate(rng) / 2, size(rng), size(rng) });
+
+    OccupancyGrid grid;
+    grid.reset({ 0.f, 0.f, 1300.f, 700.f }, 5.f);
+    for (const vec4& solid : solids)
+        grid.mark(solid);
+
+    int free_boxes = 0;
+    for (int i = 0; i < 5000; i++) {
+        vec4 box = { coordinate(rng) - 50.f, coordinate(rng) / 2 - 50.f, size(rng), size(rng) };
+        bool overlap = false;
+        for (const vec4& solid : solids)
+            overlap = overlap || overlaps(box, solid);
+        if (overlap) {
+            EXPECT_TRUE(grid.any(box));
+        }
+        free_boxes += !grid.any(box);
+    }
+    // and most boxes in the open are answered without the exact test
+    EXPECT_GT(free_boxes, 2500);
+}
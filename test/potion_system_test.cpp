@@ -6,8 +6,9 @@
 
 class PotionSystemTest : public ::testing::Test {
 protected:
-    PotionSystem potion_system;
-    Entity cauldron;
+    ECSRegistry registry;
+    PotionSystem potion_system{ registry };
+    Entity cauldron = registry.create();
 
     void SetUp() override {
         // Reset the registry and create a new FILLED cauldron before each test
@@ -18,13 +19,13 @@ protected:
         ci.capacity = INT_MAX;
 
         // So potion tests don't segfault
-        auto ent = Entity();
+        auto ent = registry.create();
         ScreenState& ss = registry.screenStates.emplace(ent);
         ss.tutorial_state = -1;
     }
 
     Entity createIngredient(ItemType type, int amount, float grindLevel) {
-        Entity res;
+        Entity res = registry.create();
         Item& resItem = registry.items.emplace(res);
         resItem.amount = amount;
         resItem.type = type;
@@ -47,7 +48,7 @@ TEST_F(PotionSystemTest, ActionRecording) {
     EXPECT_EQ(cc.timeElapsed, 0);
 
     // Now record a heat action
-    PotionSystem::changeHeat(cauldron, 100);
+    PotionSystem::changeHeat(registry, cauldron, 100);
     EXPECT_EQ(cc.actions.size(), 1);
     EXPECT_EQ(cc.actions[0].type, ActionType::MODIFY_HEAT);
     EXPECT_EQ(cc.actions[0].value, 100);
@@ -64,12 +65,12 @@ TEST_F(PotionSystemTest, ActionRecording) {
     EXPECT_EQ(cc.actions[1].value, 2);
 
     // Then a stir action, which shouldn't do anything since the cauldron is empty
-    PotionSystem::stirCauldron(cauldron, 100);
+    PotionSystem::stirCauldron(registry, cauldron, 100);
     EXPECT_EQ(cc.actions.size(), 2);
 
     // Add an example item
     Entity coffee_bean = createIngredient(ItemType::COFFEE_BEANS, 1, 0.5f);
-    PotionSystem::addIngredient(cauldron, coffee_bean);
+    PotionSystem::addIngredient(registry, cauldron, coffee_bean);
     EXPECT_EQ(cc.actions.size(), 3);
     EXPECT_EQ(cc.actions[2].type, ActionType::ADD_INGREDIENT);
     EXPECT_EQ(cc.actions[2].value, 0);
@@ -78,7 +79,7 @@ TEST_F(PotionSystemTest, ActionRecording) {
 
     // Add a second example item of the same type
     Entity coffee_bean2 = createIngredient(ItemType::COFFEE_BEANS, 1, 0.5f);
-    PotionSystem::addIngredient(cauldron, coffee_bean2);
+    PotionSystem::addIngredient(registry, cauldron, coffee_bean2);
     EXPECT_EQ(cc.actions.size(), 3);
     EXPECT_EQ(ci.items.size(), 1);
     Item& coffeeItem = registry.items.get(coffee_bean);
@@ -89,7 +90,7 @@ TEST_F(PotionSystemTest, ActionRecording) {
 // Test bottling a cauldron with no ingredients
 TEST_F(PotionSystemTest, DefaultPotion) {
     Cauldron& cc = registry.cauldrons.get(cauldron);
-    Potion res = PotionSystem::bottlePotion(cauldron);
+    Potion res = PotionSystem::bottlePotion(registry, cauldron);
     EXPECT_EQ(res.effect, PotionEffect::WATER);
     EXPECT_FALSE(cc.filled);
 }
@@ -98,8 +99,8 @@ TEST_F(PotionSystemTest, DefaultPotion) {
 TEST_F(PotionSystemTest, FailedPotion) {
     // Only coffee matches no potion
     Entity coffee_bean = createIngredient(ItemType::COFFEE_BEANS, 1, 0.5f);
-    PotionSystem::addIngredient(cauldron, coffee_bean);
-    Potion res = PotionSystem::bottlePotion(cauldron);
+    PotionSystem::addIngredient(registry, cauldron, coffee_bean);
+    Potion res = PotionSystem::bottlePotion(registry, cauldron);
     EXPECT_EQ(res.effect, PotionEffect::FAILED);
 }
 
@@ -109,11 +110,11 @@ TEST_F(PotionSystemTest, PerfectSpeedPotion) {
     Entity fruit = createIngredient(ItemType::MAGICAL_FRUIT, 3, 0.0f);
 
     // Perfectly made potion, mwah
-    PotionSystem::changeHeat(cauldron, 100);
+    PotionSystem::changeHeat(registry, cauldron, 100);
     potion_system.updateCauldrons(DEFAULT_WAIT * 2);
-    PotionSystem::addIngredient(cauldron, coffee);
-    PotionSystem::addIngredient(cauldron, fruit);
-    PotionSystem::stirCauldron(cauldron, 3);
+    PotionSystem::addIngredient(registry, cauldron, coffee);
+    PotionSystem::addIngredient(registry, cauldron, fruit);
+    PotionSystem::stirCauldron(registry, cauldron, 3);
     potion_system.updateCauldrons(DEFAULT_WAIT * 6);
 
     // Check relevant actions
@@ -122,7 +123,7 @@ TEST_F(PotionSystemTest, PerfectSpeedPotion) {
 
     // Check final potion, which should be same as in the recipe
     Recipe speedRecipe = RECIPES[0];
-    Potion potion = PotionSystem::bottlePotion(cauldron);
+    Potion potion = PotionSystem::bottlePotion(registry, cauldron);
     EXPECT_FLOAT_EQ(potion.quality, 1.0f);
     EXPECT_EQ(potion.effect, PotionEffect::SPEED);
     EXPECT_EQ(potion.color, speedRecipe.finalPotionColor);
@@ -135,14 +136,14 @@ TEST_F(PotionSystemTest, PotionMissOneStep) {
     Entity coffee = createIngredient(ItemType::COFFEE_BEANS, 5, 1.0f);
     Entity fruit = createIngredient(ItemType::MAGICAL_FRUIT, 3, 0.0f);
 
-    PotionSystem::changeHeat(cauldron, 100);
+    PotionSystem::changeHeat(registry, cauldron, 100);
     potion_system.updateCauldrons(DEFAULT_WAIT * 2);
-    PotionSystem::addIngredient(cauldron, coffee);
-    PotionSystem::addIngredient(cauldron, fruit);
-    PotionSystem::stirCauldron(cauldron, 3);
+    PotionSystem::addIngredient(registry, cauldron, coffee);
+    PotionSystem::addIngredient(registry, cauldron, fruit);
+    PotionSystem::stirCauldron(registry, cauldron, 3);
     // potion_system.updateCauldrons(DEFAULT_WAIT * 6); <- Missed this step!
     
-    Potion potion = PotionSystem::bottlePotion(cauldron);
+    Potion potion = PotionSystem::bottlePotion(registry, cauldron);
     EXPECT_FLOAT_EQ(potion.quality, 5.0f / 6.0f);
 }
 
@@ -151,14 +152,14 @@ TEST_F(PotionSystemTest, PotionIncorrectIngredientOrder) {
     Entity fruit = createIngredient(ItemType::MAGICAL_FRUIT, 3, 0.0f);
     Entity coffee = createIngredient(ItemType::COFFEE_BEANS, 5, 1.0f);
     
-    PotionSystem::changeHeat(cauldron, 100);
+    PotionSystem::changeHeat(registry, cauldron, 100);
     potion_system.updateCauldrons(DEFAULT_WAIT * 2);
-    PotionSystem::addIngredient(cauldron, fruit);      // <- Swapped!
-    PotionSystem::addIngredient(cauldron, coffee);     // <- Swapped!
-    PotionSystem::stirCauldron(cauldron, 3);
+    PotionSystem::addIngredient(registry, cauldron, fruit);      // <- Swapped!
+    PotionSystem::addIngredient(registry, cauldron, coffee);     // <- Swapped!
+    PotionSystem::stirCauldron(registry, cauldron, 3);
     potion_system.updateCauldrons(DEFAULT_WAIT * 6);
     
-    Potion potion = PotionSystem::bottlePotion(cauldron);
+    Potion potion = PotionSystem::bottlePotion(registry, cauldron);
     EXPECT_FLOAT_EQ(potion.quality, (6.0f - 2 * INGREDIENT_TYPE_PENALTY * POTION_DIFFICULTY) / 6.0f);
 }
 
@@ -167,13 +168,13 @@ TEST_F(PotionSystemTest, PotionIncorrectStirAmount) {
     Entity fruit = createIngredient(ItemType::MAGICAL_FRUIT, 3, 0.0f);
     Entity coffee = createIngredient(ItemType::COFFEE_BEANS, 5, 1.0f);
 
-    PotionSystem::changeHeat(cauldron, 100);
+    PotionSystem::changeHeat(registry, cauldron, 100);
     potion_system.updateCauldrons(DEFAULT_WAIT * 2);
-    PotionSystem::addIngredient(cauldron, coffee);
-    PotionSystem::addIngredient(cauldron, fruit);
-    PotionSystem::stirCauldron(cauldron, 4);          // <- 1 extra stir!
+    PotionSystem::addIngredient(registry, cauldron, coffee);
+    PotionSystem::addIngredient(registry, cauldron, fruit);
+    PotionSystem::stirCauldron(registry, cauldron, 4);          // <- 1 extra stir!
     potion_system.updateCauldrons(DEFAULT_WAIT * 6);
     
-    Potion potion = PotionSystem::bottlePotion(cauldron);
+    Potion potion = PotionSystem::bottlePotion(registry, cauldron);
     EXPECT_FLOAT_EQ(potion.quality, (6.0f - STIR_PENALTY * POTION_DIFFICULTY) / 6.0f);
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "../src/common.hpp"
+#include "../src/systems/projectile_system.hpp"
+#include "../src/systems/physics_system.hpp"
+#include "../src/tinyECS/registry.hpp"
+
+class ProjectileSystemTest : public ::testing::Test {
+protected:
+    ECSRegistry registry;
+    ContactManager contacts;
+    ProjectileSystem projectiles{ registry, contacts };
+
+    void SetUp() override {
+        registry.clear_all_components();
+        registry.screenStates.emplace(registry.create());
+    }
+};
+
+// A flight moves at its speed towards its target, its Motion follows and it is retired before passing the target
+TEST_F(ProjectileSystemTest, FliesToTarget) {
+    Entity entity = projectiles.acquire();
+    projectiles.launch(entity, { 0.f, 0.f }, { 0.f, 100.f }, 2.f, 7);
+    ASSERT_TRUE(projectiles.flying(entity));
+    EXPECT_TRUE(registry.ammo.get(entity).is_fired);
+    EXPECT_EQ(projectiles.find(entity)->damage, 7);
+
+    projectiles.step(10.f);
+    const Motion& motion = registry.motions.get(entity);
+    EXPECT_FLOAT_EQ(motion.position.y, 20.f);
+    EXPECT_FLOAT_EQ(motion.previous_position.y, 0.f);
+    EXPECT_FLOAT_EQ(projectiles.find(entity)->position.y, 20.f);
+
+    // frozen while the biome is switching
+    registry.screenStates.components[0].is_switching_biome = true;
+    projectiles.step(10.f);
+    EXPECT_FLOAT_EQ(registry.motions.get(entity).position.y, 20.f);
+    registry.screenStates.components[0].is_switching_biome = false;
+
+    projectiles.step(40.f);
+    EXPECT_FLOAT_EQ(registry.motions.get(entity).position.y, 100.f);
+    projectiles.step(1.f);
+    EXPECT_FALSE(projectiles.flying(entity));
+    EXPECT_FLOAT_EQ(registry.motions.get(entity).position.y, 100.f);
+    EXPECT_FALSE(registry.ammo.get(entity).is_fired);
+    EXPECT_FALSE(registry.renderRequests.get(entity).is_visible);
+}
+
+// Retired entities are thrown again instead of new ones, entities the registry removed are not
+TEST_F(ProjectileSystemTest, RecyclesRetiredEntities) {
+    Entity first = projectiles.acquire();
+    Entity second = projectiles.acquire();
+    EXPECT_NE(first, second);
+    projectiles.launch(first, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 1);
+    projectiles.launch(second, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 2);
+
+    projectiles.retire(first);
+    projectiles.retire(first);
+    EXPECT_EQ(projectiles.flights().size(), 1u);
+    EXPECT_EQ(projectiles.find(second)->damage, 2);
+    EXPECT_EQ(projectiles.acquire(), first);
+
+    projectiles.retire_all();
+    EXPECT_TRUE(projectiles.flights().empty());
+    registry.remove_all_components_of(second);
+    Entity third = projectiles.acquire();
+    EXPECT_NE(third, second);
+    EXPECT_TRUE(registry.motions.has(third));
+    EXPECT_TRUE(registry.collisionFilters.has(third));
+
+    // a flying entity that loses its Motion ends its flight
+    projectiles.launch(third, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 3);
+    registry.motions.remove(third);
+    projectiles.step(1.f);
+    EXPECT_FALSE(projectiles.flying(third));
+
+    // the flight of a removed entity is not taken for the next entity at its index
+    Entity fourth = projectiles.acquire();
+    projectiles.launch(fourth, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 4);
+    registry.remove_all_components_of(fourth);
+    Entity fifth = projectiles.acquire();
+    ASSERT_EQ(fifth.index(), fourth.index());
+    EXPECT_FALSE(projectiles.flying(fifth));
+    EXPECT_EQ(projectiles.find(fifth), nullptr);
+    projectiles.launch(fifth, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 5);
+    EXPECT_FALSE(projectiles.flying(fourth));
+    EXPECT_EQ(projectiles.flights().size(), 1u);
+    EXPECT_EQ(projectiles.find(fifth)->damage, 5);
+}
+
+// A retired projectile's contacts are forgotten, thrown again into the same enemy it hits it anew
+TEST_F(ProjectileSystemTest, RetiringForgetsContacts) {
+    Entity enemy = registry.create();
+    Entity entity = projectiles.acquire();
+    projectiles.launch(entity, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 1);
+    contacts.begin_step();
+    contacts.add(entity, enemy);
+    contacts.end_step();
+    ASSERT_EQ(contacts.events().size(), 1u);
+    EXPECT_EQ(contacts.events()[0].state, ContactState::BEGIN);
+
+    projectiles.retire(entity);
+    EXPECT_TRUE(contacts.contacts().empty());
+    EXPECT_EQ(projectiles.acquire(), entity);
+    projectiles.launch(entity, { 0.f, 0.f }, { 100.f, 0.f }, 1.f, 1);
+    contacts.begin_step();
+    contacts.add(entity, enemy);
+    contacts.end_step();
+    ASSERT_EQ(contacts.events().size(), 1u);
+    EXPECT_EQ(contacts.events()[0].state, ContactState::BEGIN);
+}
+
+// A projectile moving further in one step than a thin crystal is wide still hits it, its whole move is swept
+TEST_F(ProjectileSystemTest, HitsThinBodyBetweenSteps) {
+    CollisionWorld collision;
+    PhysicsSystem physics(registry, collision, contacts, projectiles);
+
+    // the player is far away, but the physics step only looks for contacts when there is one
+    Entity player = registry.create();
+    registry.players.emplace(player);
+    registry.motions.emplace(player).position = { 0.f, 1000.f };
+
+    // the target area of the crystal is 6 px wide, from x 95.5 to 101.5
+    Entity crystal = registry.create();
+    Motion& crystal_motion = registry.motions.emplace(crystal);
+    crystal_motion.position = { 100.f, 0.f };
+    crystal_motion.scale = { 10.f, 40.f };
+    registry.terrains.emplace(crystal).collision_setting = 0.f;
+    registry.collisionFilters.insert(crystal, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
+    collision.build_terrain(registry);
+
+    Entity entity = projectiles.acquire();
+    registry.collisionFilters.get(entity) = { COLLISION_AMMO, COLLISION_AMMO_STOPPING | COLLISION_ENEMY };
+    projectiles.launch(entity, { 0.f, 10.f }, { 300.f, 10.f }, 1.f, 1);
+
+    projectiles.step(60.f);
+    physics.step(60.f);
+    EXPECT_TRUE(contacts.contacts().empty());
+
+    // from x 55 to 115 in one step, its top left corner jumps over the crystal
+    projectiles.step(60.f);
+    physics.step(60.f);
+    EXPECT_GT(registry.motions.get(entity).position.x - 5.f, 101.5f);
+    ASSERT_EQ(contacts.events().size(), 1u);
+    EXPECT_EQ(contacts.events()[0].state, ContactState::BEGIN);
+    EXPECT_EQ(contacts.events()[0].entity, entity);
+    EXPECT_EQ(contacts.events()[0].other, crystal);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include "../src/common.hpp"
+#include "../src/world.hpp"
+#include "../src/systems/ai_system.hpp"
+#include "../src/systems/potion_system.hpp"
+#include "../src/tinyECS/scheduler.hpp"
+
+// Conflicting systems keep their order, independent ones share a stage
+TEST(SchedulerTest, Stages) {
+    JobSystem jobs(2);
+    SystemScheduler scheduler(jobs);
+    const Signature A = 1, B = 2, C = 4;
+    int a = 0, b = 0, c = 0;
+
+    SystemAccess write_a; write_a.writes = A;
+    SystemAccess read_a_write_b; read_a_write_b.reads = A; read_a_write_b.writes = B;
+    SystemAccess write_c; write_c.writes = C;
+
+    scheduler.add("a", write_a, [&]() { a = 1; });
+    scheduler.add("b", read_a_write_b, [&]() { b = a + 1; });
+    scheduler.add("c", write_c, [&]() { c = 5; });
+    scheduler.sync("sync", [&]() { c += a + b; });
+    scheduler.add("a again", write_a, [&]() { a = 10; });
+
+    const std::vector<unsigned int>& stages = scheduler.stages();
+    EXPECT_EQ(stages, (std::vector<unsigned int>{ 0, 1, 0, 2, 3 }));
+
+    scheduler.run_frame();
+    EXPECT_EQ(a, 10);
+    EXPECT_EQ(b, 2);
+    EXPECT_EQ(c, 8); // same as running the five in order
+}
+
+// A player, enemies around a tree, cauldrons that were heated and enemies waiting to respawn
+static void populate(World& world) {
+    ECSRegistry& registry = world.registry;
+    ScreenState& screen = registry.screenStates.emplace(registry.create());
+    screen.tutorial_state = (int)TUTORIAL::WAIT;
+
+    Entity player = registry.create();
+    registry.players.emplace(player);
+    registry.motions.emplace(player).position = { 500.f, 500.f };
+
+    Entity tree = registry.create();
+    Motion& tree_motion = registry.motions.emplace(tree);
+    tree_motion.position = { 560.f, 500.f };
+    tree_motion.scale = { 60.f, 90.f };
+    registry.terrains.emplace(tree).collision_setting = 0.f;
+    registry.collisionFilters.insert(tree, { COLLISION_SOLID, 0 });
+
+    for (int i = 0; i < 200; i++) {
+        Entity enemy = registry.create();
+        Enemy& info = registry.enemies.emplace(enemy);
+        info.can_move = 1;
+        info.state = (int)(i % 2 ? ENEMY_STATE::WANDER : ENEMY_STATE::IDLE);
+        info.wander_timer = 10.f;
+        info.start_pos = { 300.f + (i % 20) * 25.f, 300.f + (i / 20) * 40.f };
+        info.name = "Ent";
+        Motion& motion = registry.motions.emplace(enemy);
+        motion.position = info.start_pos;
+        motion.scale = { 50.f, 50.f };
+        registry.collisionFilters.insert(enemy, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
+        if (i % 10 == 0) {
+            world.respawns.registerEntity(enemy, false);
+            world.respawns.setRespawning(info.persistentID, 500.f + i * 50.f);
+        }
+    }
+    world.collision.build_terrain(registry);
+
+    for (int i = 0; i < 20; i++) {
+        Entity cauldron = registry.create();
+        registry.cauldrons.emplace(cauldron).filled = true;
+        registry.inventories.emplace(cauldron).capacity = INT_MAX;
+        PotionSystem::changeHeat(registry, cauldron, 10 + i);
+    }
+}
+
+// The AI, the cauldrons and the respawn timers share a stage, and a frame run by the scheduler ends
+// the same as the same systems called one after another
+TEST(SchedulerTest, FrameMatchesSequential) {
+    const float elapsed_ms = 100.f;
+    const int frames = 60;
+
+    World sequential_world;
+    populate(sequential_world);
+    AISystem sequential_ai(sequential_world.registry, sequential_world.collision, 7);
+    PotionSystem sequential_potions(sequential_world.registry);
+    for (int frame = 0; frame < frames; frame++) {
+        sequential_world.registry.next_frame();
+        sequential_ai.step(elapsed_ms);
+        sequential_potions.updateCauldrons(elapsed_ms);
+        sequential_world.respawns.step(elapsed_ms);
+        sequential_potions.applyRecordedWaits();
+        sequential_world.respawns.spawnFinished();
+    }
+
+    // the accesses main.cpp declares for these systems
+    World world;
+    populate(world);
+    AISystem ai(world.registry, world.collision, 7);
+    PotionSystem potions(world.registry);
+    SystemAccess ai_access;
+    ai_access.reads = ECSRegistry::mask<ScreenState, Player, CollisionFilter, Terrain, Guardian, Mesh*>();
+    ai_access.writes = ECSRegistry::mask<Motion, Enemy>();
+    SystemAccess cauldron_access;
+    cauldron_access.reads = ECSRegistry::mask<ScreenState, Inventory, Item, Ingredient>();
+    cauldron_access.writes = ECSRegistry::mask<Cauldron, Potion>();
+    SystemAccess respawn_access;
+
+    JobSystem jobs(3);
+    SystemScheduler scheduler(jobs);
+    scheduler.add("ai", ai_access, [&]() { ai.step(elapsed_ms); });
+    scheduler.add("cauldrons", cauldron_access, [&]() { potions.updateCauldrons(elapsed_ms); });
+    scheduler.add("respawn timers", respawn_access, [&]() { world.respawns.step(elapsed_ms); });
+    scheduler.sync("recorded", [&]() {
+        potions.applyRecordedWaits();
+        world.respawns.spawnFinished();
+    });
+    EXPECT_EQ(scheduler.stages(), (std::vector<unsigned int>{ 0, 0, 0, 1 }));
+    for (int frame = 0; frame < frames; frame++) {
+        world.registry.next_frame();
+        scheduler.run_frame();
+    }
+
+    ECSRegistry& expected = sequential_world.registry;
+    ECSRegistry& registry = world.registry;
+    ASSERT_EQ(registry.enemies.entities, expected.enemies.entities);
+    for (Entity enemy : registry.enemies.entities) {
+        EXPECT_EQ(registry.motions.get(enemy).position, expected.motions.get(enemy).position);
+        EXPECT_EQ(registry.enemies.get(enemy).state, expected.enemies.get(enemy).state);
+        EXPECT_EQ(registry.enemies.get(enemy).wander_timer, expected.enemies.get(enemy).wander_timer);
+    }
+
+    ASSERT_EQ(registry.cauldrons.entities, expected.cauldrons.entities);
+    for (Entity cauldron : registry.cauldrons.entities) {
+        const Cauldron& cc = registry.cauldrons.get(cauldron);
+        const Cauldron& expected_cc = expected.cauldrons.get(cauldron);
+        ASSERT_EQ(cc.actions.size(), 2u); // the heat and a wait
+        ASSERT_EQ(cc.actions.size(), expected_cc.actions.size());
+        for (size_t i = 0; i < cc.actions.size(); i++) {
+            EXPECT_EQ(cc.actions[i].type, expected_cc.actions[i].type);
+            EXPECT_EQ(cc.actions[i].value, expected_cc.actions[i].value);
+        }
+        EXPECT_EQ(cc.color, expected_cc.color);
+        EXPECT_EQ(registry.potions.get(cauldron).color, expected.potions.get(cauldron).color);
+    }
+    EXPECT_EQ(registry.screenStates.components[0].tutorial_state, (int)TUTORIAL::WAIT + 1);
+    EXPECT_EQ(registry.screenStates.components[0].tutorial_state, expected.screenStates.components[0].tutorial_state);
+
+    size_t respawned = 0;
+    for (auto& [id, state] : world.respawns.getRespawnStates()) {
+        const RespawnState& expected_state = sequential_world.respawns.getRespawnStates().at(id);
+        EXPECT_EQ(state.isSpawned, expected_state.isSpawned);
+        EXPECT_EQ(state.respawnCooldownRemaining, expected_state.respawnCooldownRemaining);
+        respawned += state.isSpawned;
+    }
+    EXPECT_GT(respawned, 0u);
+    EXPECT_LT(respawned, world.respawns.getRespawnStates().size());
+}
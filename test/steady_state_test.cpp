@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "../src/common.hpp"
+#include "../src/tinyECS/frame_arena.hpp"
+#include "../src/tinyECS/registry.hpp"
+#include "../src/systems/ai_system.hpp"
+#include "../src/systems/collision_world.hpp"
+#include "../src/systems/physics_system.hpp"
+#include "../src/systems/potion_system.hpp"
+
+// Code that runs every frame does not touch the heap once the frame arena has grown to fit a frame
+class SteadyStateTest : public ::testing::Test {
+protected:
+    ECSRegistry registry;
+
+    void SetUp() override {
+        registry.clear_all_components();
+        registry.screenStates.emplace(registry.create());
+    }
+
+    // Heap allocations made by frame, run for a few frames first so the arena and containers have grown
+    template <typename Func>
+    size_t steady_allocations(Func frame) {
+        for (int i = 0; i < 3; i++) {
+            frame_arena().reset();
+            frame();
+        }
+        frame_arena().reset();
+        size_t before = heap_allocations();
+        frame();
+        return heap_allocations() - before;
+    }
+};
+
+TEST_F(SteadyStateTest, BaseColor) {
+    Inventory inventory;
+    for (int i = 0; i < 4; i++) {
+        Entity potion = registry.create();
+        registry.potions.emplace(potion).color = { 60.f * i, 100.f, 200.f };
+        inventory.items.push_back(potion);
+    }
+    inventory.items.push_back(registry.create()); // not a potion, skipped
+
+    vec3 color;
+    EXPECT_EQ(steady_allocations([&]() { color = PotionSystem::getBaseColor(registry, inventory); }), 0u);
+    EXPECT_EQ(color, vec3(90.f, 100.f, 200.f));
+}
+
+TEST_F(SteadyStateTest, TransformedVertices) {
+    Mesh mesh;
+    for (int i = 0; i < 64; i++)
+        mesh.vertices.push_back({ { (float)i, (float)(i % 8), 0.f }, {} });
+    Motion motion;
+    motion.position = { 100.f, 50.f };
+    motion.angle = 30.f;
+    motion.scale = { 2.f, 2.f };
+
+    size_t count = 0;
+    EXPECT_EQ(steady_allocations([&]() { count = PhysicsSystem::get_transformed_vertices(mesh, motion).size(); }), 0u);
+    EXPECT_EQ(count, mesh.vertices.size());
+}
+
+// An enemy chasing the player and one wandering around, both walking along a wall
+TEST_F(SteadyStateTest, EnemyAI) {
+    Entity player = registry.create();
+    registry.players.emplace(player);
+    registry.motions.emplace(player).position = { 500.f, 500.f };
+
+    Entity wall = registry.create();
+    Motion& wall_motion = registry.motions.emplace(wall);
+    wall_motion.position = { 500.f, 600.f };
+    wall_motion.scale = { 1000.f, 20.f };
+    registry.terrains.emplace(wall).collision_setting = 1.f;
+    registry.collisionFilters.insert(wall, { COLLISION_SOLID, 0 });
+
+    for (vec2 position : { vec2(450.f, 560.f), vec2(900.f, 560.f) }) {
+        Entity enemy = registry.create();
+        Enemy& info = registry.enemies.emplace(enemy);
+        info.can_move = 1;
+        info.start_pos = position - vec2(200.f, 0.f);
+        info.state = (int)ENEMY_STATE::WANDER;
+        info.wander_timer = 1000.f;
+        Motion& motion = registry.motions.emplace(enemy);
+        motion.position = position;
+        motion.scale = { 40.f, 40.f };
+        registry.collisionFilters.insert(enemy, { COLLISION_ENEMY, COLLISION_SOLID });
+    }
+
+    CollisionWorld collision;
+    collision.build_terrain(registry);
+    AISystem ai(registry, collision);
+    EXPECT_EQ(steady_allocations([&]() { ai.step(16.f); }), 0u);
+    EXPECT_EQ(registry.enemies.components[0].state, (int)ENEMY_STATE::ATTACK);
+    EXPECT_EQ(registry.enemies.components[1].state, (int)ENEMY_STATE::WANDER);
+}
+
+// The headless part of a frame: the physics step finding contacts, flights moving and landing and the recorded
+// commands being applied, with an entity destroyed and a component removed and added back every frame
+TEST_F(SteadyStateTest, HeadlessFrame) {
+    Entity player = registry.create();
+    registry.players.emplace(player);
+    registry.motions.emplace(player).position = { 500.f, 500.f };
+    registry.collisionFilters.insert(player, { COLLISION_PLAYER, COLLISION_SOLID | COLLISION_ENEMY_REACH });
+
+    Entity tree = registry.create();
+    Motion& tree_motion = registry.motions.emplace(tree);
+    tree_motion.position = { 510.f, 500.f };
+    tree_motion.scale = { 60.f, 90.f };
+    registry.terrains.emplace(tree).collision_setting = 0.f;
+    registry.collisionFilters.insert(tree, { COLLISION_SOLID | COLLISION_AMMO_STOPPING, 0 });
+
+    std::vector<Entity> enemies;
+    for (int i = 0; i < 8; i++) {
+        Entity enemy = registry.create();
+        Motion& motion = registry.motions.emplace(enemy);
+        motion.position = { 480.f + 10.f * i, 510.f };
+        motion.scale = { 50.f, 50.f };
+        registry.enemies.emplace(enemy);
+        registry.collisionFilters.insert(enemy, { COLLISION_ENEMY | COLLISION_ENEMY_REACH, COLLISION_SOLID });
+        enemies.push_back(enemy);
+    }
+
+    CollisionWorld collision;
+    ContactManager contacts;
+    ProjectileSystem projectiles(registry, contacts);
+    PhysicsSystem physics(registry, collision, contacts, projectiles);
+    for (int i = 0; i < 8; i++) {
+        Entity ammo = projectiles.acquire();
+        registry.motions.get(ammo).scale = { 20.f, 20.f };
+        registry.collisionFilters.get(ammo) = { COLLISION_AMMO, COLLISION_AMMO_STOPPING | COLLISION_ENEMY };
+        vec2 start = { 450.f + 10.f * i, 505.f };
+        projectiles.launch(ammo, start, start + vec2(0.f, 1e6f), 0.01f, 0);
+    }
+    collision.build_terrain(registry);
+
+    auto frame = [&]() {
+        physics.step(16.f);
+        projectiles.step(16.f);
+        // one projectile lands and is thrown again
+        Entity landed = projectiles.flights().front().entity;
+        projectiles.retire(landed);
+        vec2 start = registry.motions.get(landed).position;
+        projectiles.launch(projectiles.acquire(), start, start + vec2(0.f, 1e6f), 0.01f, 0);
+        Entity temporary = registry.create();
+        registry.motions.emplace(temporary);
+        registry.commands.destroy(temporary);
+        registry.commands.emplace(registry.damageFlashes, enemies[0], DamageFlash{ 0.f, false });
+        registry.flush_commands();
+    };
+    EXPECT_EQ(steady_allocations(frame), 0u);
+    EXPECT_GT(contacts.contacts().size(), 0u);
+    EXPECT_EQ(projectiles.flights().size(), 8u);
+    EXPECT_TRUE(registry.damageFlashes.has(enemies[0]));
+    EXPECT_TRUE(registry.commands.empty());
+}
@@ -0,0 +1,551 @@
+#include <gtest/gtest.h>
+#include "../src/tinyECS/tiny_ecs.hpp"
+#include "../src/tinyECS/command_buffer.hpp"
+#include "../src/tinyECS/registry.hpp"
+
+struct TestComponent {
+    int value = 0;
+};
+
+// Kept in small chunks so the tests cross chunk boundaries
+struct PagedComponent {
+    std::string name;
+};
+template <> struct ComponentStorage<PagedComponent> { using type = PagedStorage<PagedComponent, 4>; };
+
+// n new entities from pool, or from the registry
+template <typename Pool>
+static std::vector<Entity> create(Pool& pool, size_t n) {
+    std::vector<Entity> entities;
+    for (size_t i = 0; i < n; i++)
+        entities.push_back(pool.create());
+    return entities;
+}
+
+class ComponentContainerTest : public ::testing::Test {
+protected:
+    EntityPool pool;
+    ComponentContainer<TestComponent> container;
+};
+
+// Test that insert/get/has agree with each other
+TEST_F(ComponentContainerTest, InsertAndGet) {
+    Entity a = pool.create(), b = pool.create();
+    container.emplace(a).value = 1;
+    container.emplace(b).value = 2;
+
+    ASSERT_TRUE(container.has(a));
+    ASSERT_TRUE(container.has(b));
+    EXPECT_EQ(container.get(a).value, 1);
+    EXPECT_EQ(container.get(b).value, 2);
+    EXPECT_EQ(container.size(), 2);
+
+    Entity c = pool.create();
+    EXPECT_FALSE(container.has(c));
+}
+
+// Removing swaps the last component into the hole and keeps lookups valid
+TEST_F(ComponentContainerTest, SwapRemove) {
+    Entity a = pool.create(), b = pool.create(), c = pool.create();
+    container.emplace(a).value = 1;
+    container.emplace(b).value = 2;
+    container.emplace(c).value = 3;
+
+    container.remove(a);
+    EXPECT_FALSE(container.has(a));
+    ASSERT_EQ(container.size(), 2);
+    EXPECT_EQ(container.entities[0], c);
+    EXPECT_EQ(container.components[0].value, 3);
+    EXPECT_EQ(container.get(b).value, 2);
+    EXPECT_EQ(container.get(c).value, 3);
+
+    // removing the last element and removing something absent are both fine
+    container.remove(b);
+    container.remove(b);
+    EXPECT_EQ(container.size(), 1);
+    EXPECT_EQ(container.get(c).value, 3);
+}
+
+// Ids far apart land in different sparse pages
+TEST_F(ComponentContainerTest, SparsePages) {
+    std::vector<Entity> entities = create(pool, 3 * SparseIndex::PAGE_SIZE);
+    for (size_t i = 0; i < entities.size(); i += SparseIndex::PAGE_SIZE / 2)
+        container.emplace(entities[i]).value = (int)i;
+
+    for (size_t i = 0; i < entities.size(); i++) {
+        bool inserted = i % (SparseIndex::PAGE_SIZE / 2) == 0;
+        ASSERT_EQ(container.has(entities[i]), inserted);
+        if (inserted) {
+            EXPECT_EQ(container.get(entities[i]).value, (int)i);
+        }
+    }
+
+    container.clear();
+    EXPECT_EQ(container.size(), 0);
+    EXPECT_FALSE(container.has(entities[0]));
+}
+
+// Sorting re-packs components and keeps the sparse index in sync
+TEST_F(ComponentContainerTest, Sort) {
+    Entity a = pool.create(), b = pool.create(), c = pool.create();
+    container.emplace(a).value = 3;
+    container.emplace(b).value = 1;
+    container.emplace(c).value = 2;
+
+    container.sort([&](Entity x, Entity y) { return container.get(x).value < container.get(y).value; });
+    EXPECT_EQ(container.entities[0], b);
+    EXPECT_EQ(container.entities[1], c);
+    EXPECT_EQ(container.entities[2], a);
+    for (size_t i = 0; i < container.size(); i++)
+        EXPECT_EQ(container.components[i].value, (int)i + 1);
+    EXPECT_EQ(container.get(a).value, 3);
+}
+
+// Paged components never move: inserting, removing and sorting others leaves references valid
+TEST(PagedStorageTest, StableAddresses) {
+    EntityPool pool;
+    ComponentContainer<PagedComponent> paged;
+    std::vector<Entity> entities = create(pool, 10);
+    for (size_t i = 0; i < entities.size(); i++)
+        paged.emplace(entities[i]).name = std::to_string(i);
+
+    PagedComponent* seven = &paged.get(entities[7]);
+    paged.remove(entities[0]);
+    paged.remove_batch({ entities[1], entities[2], entities[9] });
+    for (int i = 0; i < 20; i++)
+        paged.emplace(pool.create()).name = "new";
+    paged.sort([&](Entity a, Entity b) { return paged.get(a).name < paged.get(b).name; });
+
+    EXPECT_EQ(&paged.get(entities[7]), seven);
+    EXPECT_EQ(seven->name, "7");
+    ASSERT_EQ(paged.size(), 26);
+    for (size_t i = 0; i < paged.size(); i++)
+        EXPECT_EQ(&paged.components[i], &paged.get(paged.entities[i]));
+    EXPECT_EQ(paged.components[0].name, "3"); // sorted, the removed ones are gone
+    EXPECT_FALSE(paged.has(entities[9]));
+
+    // freed slots are re-used
+    paged.clear();
+    paged.emplace(entities[3]).name = "again";
+    EXPECT_EQ(paged.get(entities[3]).name, "again");
+    EXPECT_EQ(paged.size(), 1);
+}
+
+// Empty types get the bitset tag container, including in the registry
+TEST(TagContainerTest, HasAndRemove) {
+    struct Tag {};
+    static_assert(std::is_base_of<TagContainer<Tag>, ComponentContainer<Tag>>::value, "");
+    static_assert(std::is_base_of<TagContainer<Chest>, std::remove_reference_t<decltype(std::declval<ECSRegistry>().chests)>>::value, "");
+
+    EntityPool pool;
+    ComponentContainer<Tag> tags;
+    Entity a = pool.create(), b = pool.create(), c = pool.create();
+    tags.emplace(a);
+    tags.emplace(b);
+    tags.emplace(c);
+    EXPECT_TRUE(tags.has(b));
+    EXPECT_NE(tags.find(c), nullptr);
+
+    tags.remove(a);
+    EXPECT_FALSE(tags.has(a));
+    EXPECT_EQ(tags.find(a), nullptr);
+    ASSERT_EQ(tags.size(), 2);
+    EXPECT_EQ(tags.entities[0], c);
+    tags.remove_batch({ b, c });
+    EXPECT_EQ(tags.size(), 0);
+
+    // a recycled index is not tagged through an old handle
+    tags.emplace(a);
+    pool.release(a);
+    Entity recycled = pool.create();
+    ASSERT_EQ(recycled.index(), a.index());
+    EXPECT_FALSE(tags.has(recycled));
+    tags.clear();
+    EXPECT_FALSE(tags.has(a));
+}
+
+// The null handle is a compile-time constant, what a handle starts out as, and never matches a live entity
+TEST(EntityTest, Null) {
+    EntityPool pool;
+    constexpr Entity none = Entity::null();
+    static_assert(none.id() == 0, "null must not take an index");
+    static_assert(Entity() == none, "handles start out null");
+    Entity a = pool.create();
+    EXPECT_NE(a, none);
+    EXPECT_FALSE(pool.is_alive(none));
+    EXPECT_TRUE(pool.is_alive(a));
+    pool.release(none); // releasing null is a no-op
+    pool.release(a);
+}
+
+// Released indices are handed out again with a new generation
+TEST(EntityTest, Recycling) {
+    EntityPool pool;
+    Entity a = pool.create();
+    unsigned int index = a.index();
+    pool.release(a);
+    pool.release(a); // double release must not put the index on the free list twice
+    EXPECT_FALSE(pool.is_alive(a));
+
+    Entity b = pool.create(), c = pool.create();
+    EXPECT_EQ(b.index(), index);
+    EXPECT_EQ(b.generation(), (a.generation() + 1) & Entity::GENERATION_MASK);
+    EXPECT_NE(a, b);
+    EXPECT_NE(c.index(), index);
+    pool.release(b);
+    pool.release(c);
+}
+
+// A stale handle does not see the components of the entity that re-used its index
+TEST_F(ComponentContainerTest, StaleHandle) {
+    Entity a = pool.create();
+    container.emplace(a).value = 1;
+    container.remove(a);
+    pool.release(a);
+
+    Entity b = pool.create();
+    ASSERT_EQ(b.index(), a.index());
+    container.emplace(b).value = 2;
+    EXPECT_TRUE(container.has(b));
+    EXPECT_FALSE(container.has(a));
+    EXPECT_EQ(container.find(a), nullptr);
+    container.remove(a); // removing through the stale handle leaves b alone
+    EXPECT_EQ(container.get(b).value, 2);
+}
+
+// Batch removal compacts once and keeps the order of the survivors
+TEST_F(ComponentContainerTest, RemoveBatch) {
+    std::vector<Entity> entities = create(pool, 6);
+    for (size_t i = 0; i < entities.size(); i++)
+        container.emplace(entities[i]).value = (int)i;
+
+    Entity absent = pool.create();
+    container.remove_batch({ entities[0], entities[3], absent, entities[3] });
+    ASSERT_EQ(container.size(), 4);
+    int expected[] = { 1, 2, 4, 5 };
+    for (size_t i = 0; i < container.size(); i++) {
+        EXPECT_EQ(container.components[i].value, expected[i]);
+        EXPECT_EQ(container.get(container.entities[i]).value, expected[i]);
+    }
+    EXPECT_FALSE(container.has(entities[0]));
+    EXPECT_FALSE(container.has(entities[3]));
+}
+
+// Sorting by precomputed keys is stable and handles long permutation cycles
+TEST_F(ComponentContainerTest, SortByKey) {
+    std::vector<Entity> entities = create(pool, 100);
+    std::vector<int> keys;
+    for (size_t i = 0; i < entities.size(); i++) {
+        container.emplace(entities[i]).value = (int)i;
+        keys.push_back((int)((i * 37) % 50)); // every key appears twice
+    }
+
+    container.sort_by_key(keys);
+    for (size_t i = 0; i < container.size(); i++) {
+        int value = container.components[i].value;
+        EXPECT_EQ(container.entities[i], entities[value]);
+        EXPECT_EQ(container.get(entities[value]).value, value);
+        if (i > 0) {
+            int previous = container.components[i - 1].value;
+            int previous_key = (previous * 37) % 50, key = (value * 37) % 50;
+            EXPECT_TRUE(previous_key < key || (previous_key == key && previous < value));
+        }
+    }
+}
+
+struct OtherComponent {
+    float value = 0.f;
+};
+
+struct TagComponent {
+};
+
+// Views only visit entities with all included and none of the excluded components
+TEST(ViewTest, IncludeAndExclude) {
+    EntityPool pool;
+    ComponentContainer<TestComponent> tests;
+    ComponentContainer<OtherComponent> others;
+    ComponentContainer<TagComponent> tags;
+
+    Entity a = pool.create(), b = pool.create(), c = pool.create(), d = pool.create();
+    tests.emplace(a).value = 1;
+    tests.emplace(b).value = 2;
+    tests.emplace(c).value = 3;
+    others.emplace(c).value = 3.f;
+    others.emplace(b).value = 2.f;
+    tests.emplace(d).value = 4;
+    tags.emplace(c);
+
+    View<TypeList<TestComponent, OtherComponent>, TypeList<>> both(tests, others);
+    std::vector<Entity> visited;
+    for (auto [entity, test, other] : both) {
+        EXPECT_EQ((float)test.value, other.value);
+        other.value += 10.f; // references point into the containers
+        visited.push_back(entity);
+    }
+    // others is the smallest container, so its dense order drives the iteration
+    ASSERT_EQ(visited.size(), 2);
+    EXPECT_EQ(visited[0], c);
+    EXPECT_EQ(visited[1], b);
+    EXPECT_FLOAT_EQ(others.get(b).value, 12.f);
+
+    View<TypeList<TestComponent>, TypeList<TagComponent>> untagged(tests, tags);
+    int sum = 0;
+    untagged.each([&](Entity entity, TestComponent& test) {
+        EXPECT_FALSE(tags.has(entity));
+        sum += test.value;
+    });
+    EXPECT_EQ(sum, 7);
+}
+
+// Empty containers produce empty views
+TEST(ViewTest, Empty) {
+    EntityPool pool;
+    ComponentContainer<TestComponent> tests;
+    ComponentContainer<OtherComponent> others;
+    Entity a = pool.create();
+    tests.emplace(a);
+
+    View<TypeList<TestComponent, OtherComponent>, TypeList<>> view(tests, others);
+    EXPECT_EQ(view.size_hint(), 0);
+    EXPECT_TRUE(view.begin() == view.end());
+}
+
+// Recorded commands only take effect on flush, destroyed entities drop their pending components
+TEST(CommandBufferTest, Flush) {
+    EntityPool pool;
+    ComponentContainer<TestComponent> tests;
+    ComponentContainer<OtherComponent> others;
+    std::vector<ContainerInterface*> all = { &tests, &others };
+    CommandBuffer commands(pool);
+
+    Entity a = pool.create(), b = pool.create();
+    Entity c = commands.create();
+    tests.emplace(a).value = 1;
+    tests.emplace(b).value = 2;
+    others.emplace(a).value = 1.f;
+
+    for (Entity e : tests.entities) {
+        if (tests.get(e).value == 1) commands.destroy(e);
+        else commands.remove(tests, e);
+    }
+    commands.emplace(others, b, OtherComponent{ 2.f });
+    commands.emplace(tests, c, TestComponent{ 3 });
+    commands.emplace(others, a, OtherComponent{ 5.f }); // dropped, a is destroyed in the same flush
+    EXPECT_TRUE(commands.is_destroyed(a));
+    EXPECT_FALSE(commands.is_destroyed(b));
+    EXPECT_FALSE(commands.is_destroyed(Entity::null()));
+    EXPECT_EQ(tests.size(), 2); // nothing happens until the flush
+    EXPECT_FALSE(commands.empty());
+
+    commands.flush(all);
+    EXPECT_TRUE(commands.empty());
+    EXPECT_FALSE(pool.is_alive(a));
+    EXPECT_FALSE(tests.has(a));
+    EXPECT_FALSE(others.has(a));
+    EXPECT_FALSE(tests.has(b));
+    EXPECT_FLOAT_EQ(others.get(b).value, 2.f);
+    EXPECT_EQ(tests.get(c).value, 3);
+    EXPECT_EQ(tests.size(), 1);
+    EXPECT_EQ(others.size(), 1);
+
+    // the mark goes with the flush, the next entity in a's slot is not destroyed
+    Entity d = pool.create();
+    EXPECT_EQ(d.index(), a.index());
+    EXPECT_FALSE(commands.is_destroyed(a));
+    EXPECT_FALSE(commands.is_destroyed(d));
+}
+
+// Commands on the same component take effect in the order they were recorded
+TEST(CommandBufferTest, RecordingOrder) {
+    EntityPool pool;
+    ComponentContainer<TestComponent> tests;
+    std::vector<ContainerInterface*> all = { &tests };
+    CommandBuffer commands(pool);
+
+    Entity a = pool.create(), b = pool.create(), c = pool.create(), d = pool.create();
+    tests.emplace(c).value = 1;
+    tests.emplace(d).value = 1;
+
+    commands.emplace(tests, a, TestComponent{ 2 });
+    commands.remove(tests, a);                      // cancels the emplace
+    commands.emplace(tests, b, TestComponent{ 2 });
+    commands.emplace(tests, b, TestComponent{ 3 }); // the later one wins
+    commands.emplace(tests, c, TestComponent{ 4 }); // replaces the component c has
+    commands.remove(tests, d);
+    commands.emplace(tests, d, TestComponent{ 5 }); // added back after the removal
+    commands.flush(all);
+
+    EXPECT_FALSE(tests.has(a));
+    EXPECT_EQ(tests.get(b).value, 3);
+    EXPECT_EQ(tests.get(c).value, 4);
+    EXPECT_EQ(tests.get(d).value, 5);
+    EXPECT_EQ(tests.size(), 3);
+    EXPECT_TRUE(commands.empty());
+}
+
+// Signatures follow the containers and destroying only visits the containers in the signature
+TEST(RegistrySignatureTest, DestroyUsesSignature) {
+    ECSRegistry ecs;
+    Entity e = ecs.create();
+    ecs.motions.emplace(e);
+    ecs.delayedMovements.emplace(e);
+    ecs.enemies.emplace(e);
+    ecs.enemies.remove(e);
+
+    Signature expected = (Signature(1) << ECSRegistry::component_bit<Motion>()) | (Signature(1) << ECSRegistry::component_bit<DelayedMovement>());
+    EXPECT_EQ(ecs.signature_of(e), expected);
+
+    ecs.remove_all_components_of(e);
+    EXPECT_FALSE(ecs.motions.has(e));
+    EXPECT_FALSE(ecs.delayedMovements.has(e));
+    EXPECT_EQ(ecs.signature_of(e), 0u);
+
+    // the recycled index starts out empty
+    Entity f = ecs.create();
+    ASSERT_EQ(f.index(), e.index());
+    EXPECT_EQ(ecs.signature_of(f), 0u);
+    ecs.motions.emplace(f);
+    ecs.remove_all_components_of(e); // stale, must leave f alone
+    EXPECT_TRUE(ecs.motions.has(f));
+
+    ecs.commands.destroy(f);
+    ecs.flush_commands();
+    EXPECT_EQ(ecs.motions.size(), 0);
+}
+
+struct TrackedComponent {
+    int value = 0;
+};
+template <> struct TrackChanges<TrackedComponent> : std::true_type {};
+
+// Tracked containers answer what was added, modified and removed since a frame
+TEST(ChangeTrackingTest, ChangedSince) {
+    EntityPool pool;
+    uint32_t frame = 1;
+    ComponentContainer<TrackedComponent> tracked;
+    tracked.track_frame(&frame);
+
+    Entity a = pool.create(), b = pool.create(), c = pool.create();
+    tracked.insert(a, { 1 });
+    tracked.insert(b, { 2 });
+    frame++;
+    tracked.insert(c, { 3 });
+    EXPECT_EQ(tracked.added_since(1), (FrameVector<Entity>{ a, b, c }));
+    EXPECT_EQ(tracked.added_since(2), (FrameVector<Entity>{ c }));
+
+    frame++;
+    tracked.modify(a).value = 10;
+    EXPECT_EQ(tracked.get(a).value, 10);
+    EXPECT_EQ(tracked.changed_since(3), (FrameVector<Entity>{ a }));
+    EXPECT_TRUE(tracked.added_since(3).empty());
+
+    frame++;
+    tracked.remove(b);
+    tracked.mark_modified(b); // no longer there, ignored
+    EXPECT_TRUE(tracked.changed_since(4).empty());
+    EXPECT_EQ(tracked.removed_since(4), (FrameVector<Entity>{ b }));
+    EXPECT_TRUE(tracked.removed_since(5).empty());
+    // oldest change first
+    EXPECT_EQ(tracked.changed_since(0), (FrameVector<Entity>{ c, a }));
+
+    // removals older than the history are forgotten
+    frame += CHANGE_HISTORY_FRAMES + 1;
+    tracked.remove(c);
+    EXPECT_EQ(tracked.removed_since(0), (FrameVector<Entity>{ c }));
+    EXPECT_FALSE(tracked.remembers_removals_since(0));
+    EXPECT_TRUE(tracked.remembers_removals_since(frame - CHANGE_HISTORY_FRAMES));
+}
+
+// An entity changed several times is listed once, where it last changed, and queries reaching past the
+// logged frames still find every change
+TEST(ChangeTrackingTest, ListsLatestChangeOnce) {
+    EntityPool pool;
+    uint32_t frame = 1;
+    ComponentContainer<TrackedComponent> tracked;
+    tracked.track_frame(&frame);
+
+    Entity a = pool.create(), b = pool.create();
+    tracked.insert(a, { 1 });
+    frame++;
+    tracked.insert(b, { 2 });
+    tracked.modify(a).value = 10;
+    tracked.modify(b).value = 20;
+    tracked.modify(a).value = 11;
+    EXPECT_EQ(tracked.changed_since(1), (FrameVector<Entity>{ b, a }));
+
+    frame++;
+    tracked.modify(b).value = 21;
+    EXPECT_EQ(tracked.changed_since(2), (FrameVector<Entity>{ a, b }));
+    EXPECT_EQ(tracked.changed_since(3), (FrameVector<Entity>{ b }));
+    EXPECT_EQ(tracked.added_since(1), (FrameVector<Entity>{ a, b }));
+
+    // the log is trimmed once it is that old, in dense order then
+    frame += 2 * CHANGE_HISTORY_FRAMES;
+    Entity c = pool.create();
+    tracked.insert(c, { 3 });
+    EXPECT_EQ(tracked.changed_since(2), (FrameVector<Entity>{ a, b, c }));
+    EXPECT_EQ(tracked.changed_since(3), (FrameVector<Entity>{ b, c }));
+    EXPECT_EQ(tracked.changed_since(frame), (FrameVector<Entity>{ c }));
+}
+
+// Group members are packed at the front of the owned containers in the same order
+TEST(GroupTest, OwnedComponentsInLockstep) {
+    ECSRegistry ecs;
+    Entity a = ecs.create(), b = ecs.create(), c = ecs.create(), d = ecs.create();
+    ecs.renderRequests.emplace(a);
+    ecs.motions.emplace(b).position = { 2.f, 0.f };
+    ecs.motions.emplace(a).position = { 1.f, 0.f };
+    ecs.motions.emplace(c).position = { 3.f, 0.f };
+    ecs.renderRequests.emplace(d);
+    ecs.renderRequests.emplace(c);
+
+    auto drawable = ecs.group<Motion, RenderRequest>();
+    ASSERT_EQ(drawable.size(), 2);
+    std::vector<Entity> members;
+    for (auto [entity, motion, render_request] : drawable) {
+        EXPECT_EQ(&motion, &ecs.motions.get(entity));
+        EXPECT_EQ(&render_request, &ecs.renderRequests.get(entity));
+        members.push_back(entity);
+    }
+    EXPECT_EQ(members, (std::vector<Entity>{ a, c }));
+    for (size_t i = 0; i < drawable.size(); i++) {
+        EXPECT_EQ(ecs.motions.entities[i], drawable.entity(i));
+        EXPECT_EQ(ecs.renderRequests.entities[i], drawable.entity(i));
+    }
+
+    // leaving through either container, through batches and through destroying
+    ecs.motions.remove(a);
+    EXPECT_EQ(drawable.size(), 1);
+    EXPECT_EQ(drawable.entity(0), c);
+    ecs.motions.emplace(d);
+    ecs.renderRequests.remove_batch({ c, b });
+    ASSERT_EQ(drawable.size(), 1);
+    EXPECT_EQ(drawable.entity(0), d);
+    EXPECT_EQ(ecs.motions.get(c).position.x, 3.f);
+    ecs.remove_all_components_of(d);
+    EXPECT_EQ(drawable.size(), 0);
+    ecs.renderRequests.emplace(c);
+    EXPECT_EQ(drawable.size(), 1);
+    ecs.motions.clear();
+    EXPECT_EQ(drawable.size(), 0);
+}
+
+// Partially owning groups pack only their owned types and look the others up
+TEST(GroupTest, ObservedComponents) {
+    ECSRegistry ecs;
+    Entity a = ecs.create(), b = ecs.create(), c = ecs.create();
+    ecs.terrains.emplace(a);
+    ecs.terrains.emplace(b);
+    ecs.motions.emplace(b).position = { 2.f, 0.f };
+    ecs.motions.emplace(c);
+
+    int visited = 0;
+    ecs.group<Terrain>(observe<Motion>).each([&](Entity entity, Terrain& terrain, Motion& motion) {
+        EXPECT_EQ(entity, b);
+        EXPECT_EQ(&terrain, &ecs.terrains.components[0]);
+        EXPECT_EQ(motion.position.x, 2.f);
+        visited++;
+    });
+    EXPECT_EQ(visited, 1);
+}
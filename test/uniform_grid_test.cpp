@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "../src/systems/uniform_grid.hpp"
+
+static std::vector<unsigned int> query(const UniformGrid& grid, vec4 box) {
+    std::vector<unsigned int> found;
+    grid.query(box, [&](unsigned int id) { found.push_back(id); });
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+// Boxes spanning many cells are reported once, and only boxes overlapping the query are reported
+TEST(UniformGridTest, QueryReportsEachOverlapOnce) {
+    UniformGrid grid(10.f);
+    grid.add(0, { 0.f, 0.f, 5.f, 5.f });
+    grid.add(1, { 0.f, 0.f, 100.f, 100.f });
+    grid.add(2, { 50.f, 50.f, 5.f, 5.f });
+    grid.add(3, { 95.f, 0.f, 5.f, 5.f });
+    grid.build();
+
+    EXPECT_EQ(query(grid, { 2.f, 2.f, 60.f, 60.f }), (std::vector<unsigned int>{ 0, 1, 2 }));
+    EXPECT_EQ(query(grid, { 52.f, 52.f, 0.f, 0.f }), (std::vector<unsigned int>{ 1, 2 }));
+    // queries reaching past the grid are clamped to its edge cells
+    EXPECT_EQ(query(grid, { 90.f, -50.f, 100.f, 52.f }), (std::vector<unsigned int>{ 1, 3 }));
+    EXPECT_TRUE(query(grid, { 200.f, 200.f, 10.f, 10.f }).empty());
+
+    grid.clear();
+    grid.build();
+    EXPECT_TRUE(query(grid, { 0.f, 0.f, 100.f, 100.f }).empty());
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../src/common.hpp"
+#include "../src/world.hpp"
+#include "../src/systems/ai_system.hpp"
+#include "../src/systems/motion_system.hpp"
+
+// Fills world with a player and wandering enemies, destroys half of the enemies and replaces them, then
+// steps it. Returns the enemies it ends up with.
+static std::vector<Entity> simulate(World& world) {
+    ECSRegistry& registry = world.registry;
+    registry.screenStates.emplace(registry.create());
+    Entity player = registry.create();
+    registry.players.emplace(player);
+    registry.motions.emplace(player).velocity = { 100.f, 0.f };
+
+    auto add_enemy = [&](int i) {
+        Entity enemy = registry.create();
+        Enemy& info = registry.enemies.emplace(enemy);
+        info.can_move = 1;
+        info.state = (int)ENEMY_STATE::WANDER;
+        info.start_pos = { -1000.f, -1000.f };
+        registry.motions.emplace(enemy).position = { 1000.f + (i % 40) * 30.f, 1000.f + (i / 40) * 30.f };
+        return enemy;
+    };
+    for (int i = 0; i < 1000; i++)
+        add_enemy(i);
+    for (size_t i = 0; i < registry.enemies.size(); i += 2)
+        registry.commands.destroy(registry.enemies.entities[i]);
+    registry.flush_commands();
+    for (int i = 0; i < 500; i++)
+        add_enemy(i);
+
+    AISystem ai(registry, world.collision);
+    MotionSystem motion(registry);
+    for (int frame = 0; frame < 100; frame++) {
+        registry.next_frame();
+        ai.step(16.f);
+        motion.step(16.f);
+    }
+    EXPECT_FLOAT_EQ(registry.motions.get(player).position.x, 100.f * 16.f * TIME_UPDATE_FACTOR * 100);
+    return registry.enemies.entities;
+}
+
+// Worlds share nothing, so two can be built and stepped on two threads at once, and each numbers its
+// entities on its own
+TEST(WorldTest, WorldsOnSeparateThreads) {
+    std::vector<Entity> first, second;
+    std::thread one([&]() { World world; first = simulate(world); });
+    std::thread two([&]() { World world; second = simulate(world); });
+    one.join();
+    two.join();
+
+    ASSERT_EQ(first.size(), 1000u);
+    EXPECT_EQ(first, second);
+    // the replacements took the destroyed enemies' indices
+    size_t recycled = std::count_if(first.begin(), first.end(), [](Entity e) { return e.generation() == 1; });
+    EXPECT_EQ(recycled, 500u);
+}